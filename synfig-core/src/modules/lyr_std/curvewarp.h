@@ -81,6 +81,7 @@ public:
 	virtual Point transform(const Point &point_, Real *dist=nullptr, Real *along=nullptr, int quality=10)const;
 	virtual Color get_color(Context context, const Point &pos)const;
 	virtual bool accelerated_render(Context context,Surface *surface,int quality, const RendDesc &renddesc, ProgressCallback *cb)const;
+	virtual bool is_render_thread_safe()const { return true; }
 	Layer::Handle hit_check(Context context, const Point &point)const;
 
 	virtual Vocab get_param_vocab()const;
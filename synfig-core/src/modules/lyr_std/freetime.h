@@ -62,6 +62,8 @@ public:
 	virtual bool set_param(const String & param, const ValueBase &value);
 	virtual ValueBase get_param(const String & param)const;
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_time_invariant()const { return false; }
+	virtual bool changes_context_time()const { return true; }
 	virtual void set_time_vfunc(IndependentContext context, Time time)const;
 };
 
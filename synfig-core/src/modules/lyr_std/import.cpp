@@ -211,6 +211,12 @@ Import::get_param_vocab()const
 	return ret;
 }
 
+bool
+Import::is_time_invariant()const
+{
+	return !(importer && importer->is_animated()) && Layer_Bitmap::is_time_invariant();
+}
+
 void
 Import::set_time_vfunc(IndependentContext context, Time time)const
 {
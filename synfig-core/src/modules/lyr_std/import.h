@@ -74,6 +74,8 @@ public:
 
 	virtual Vocab get_param_vocab()const;
 
+	virtual bool is_time_invariant()const;
+
 	virtual void on_canvas_set();
 
 	virtual void set_time_vfunc(IndependentContext context, Time time)const;
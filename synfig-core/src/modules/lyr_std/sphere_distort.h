@@ -83,6 +83,7 @@ public:
 	virtual Color get_color(Context context, const Point &pos)const;
 
 	virtual bool accelerated_render(Context context,Surface *surface,int quality, const RendDesc &renddesc, ProgressCallback *cb)const;
+	virtual bool is_render_thread_safe()const { return true; }
 	Layer::Handle hit_check(Context context, const Point &point)const;
 
 	virtual Rect get_bounding_rect()const;
@@ -81,6 +81,8 @@ public:
 	virtual ValueBase get_param(const String & param)const;
 
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_time_invariant()const { return false; }
+	virtual bool changes_context_time()const { return true; }
 	virtual bool set_version(const String &ver);
 	virtual void reset_version();
 
@@ -65,6 +65,7 @@ public:
 	virtual bool accelerated_render(Context context,Surface *surface,int quality, const RendDesc &renddesc, ProgressCallback *cb)const;
 	virtual Vocab get_param_vocab()const;
 	virtual bool reads_context()const { return true; }
+	virtual bool is_render_thread_safe()const { return true; }
 
 protected:
 	virtual rendering::Task::Handle build_rendering_task_vfunc(Context context) const;
@@ -43,6 +43,8 @@
 #include <synfig/value.h>
 #include <synfig/angle.h>
 
+#include <synfig/rendering/common/task/taskpixelgenerator.h>
+
 #include "conicalgradient.h"
 
 #endif
@@ -61,6 +63,52 @@ SYNFIG_LAYER_SET_VERSION(ConicalGradient,"0.1");
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+inline Real
+conical_dist(const Point &centered, const Angle &angle)
+{
+	Angle::rot a = Angle::tan(-centered[1],centered[0]).mod();
+	a += angle;
+	return a.mod().get();
+}
+
+inline Real
+conical_supersample(const Point &centered, Real pw, Real ph)
+{
+	if(std::fabs(centered[0])<std::fabs(pw*0.5) && std::fabs(centered[1])<std::fabs(ph*0.5))
+		return 0.5;
+	return (pw/centered.mag())/(PI*2);
+}
+
+class ConicalGradientGenerator: public rendering::PixelGenerator
+{
+public:
+	Point center;
+	Angle angle;
+	CompiledGradient gradient;
+
+	virtual void generate(Color *dst, int pitch, int count, int rows, const Vector &p, const Vector &dx, const Vector &dy) const {
+		Real pw = get_pw(dx);
+		Real ph = dy.mag();
+
+		std::vector<Real> x0(count), x1(count);
+		Point row = p - center;
+		for(int j = 0; j < rows; ++j, dst += pitch, row += dy) {
+			Point pos = row;
+			for(int i = 0; i < count; ++i, pos += dx) {
+				Real dist = conical_dist(pos, angle);
+				Real supersample = 0.5*conical_supersample(pos, pw, ph);
+				x0[i] = dist - supersample;
+				x1[i] = dist + supersample;
+			}
+			gradient.average(dst, &x0.front(), &x1.front(), count);
+		}
+	}
+};
+
+} // namespace
+
 /* === M E T H O D S ======================================================= */
 
 /* === E N T R Y P O I N T ================================================= */
@@ -145,10 +193,7 @@ ConicalGradient::color_func(const Point &pos, Real supersample)const
 	Point center = param_center.get(Point());
 	Angle angle = param_angle.get(Angle());
 	
-	const Point centered(pos-center);
-	Angle::rot a = Angle::tan(-centered[1],centered[0]).mod();
-	a += angle;
-	Real dist(a.mod().get());
+	Real dist(conical_dist(pos-center, angle));
 
 	supersample *= 0.5;
 	return compiled_gradient.average(dist - supersample, dist + supersample);
@@ -158,11 +203,7 @@ Real
 ConicalGradient::calc_supersample(const synfig::Point &x, Real pw, Real ph)const
 {
 	Point center=param_center.get(Point());
-
-	Point adj(x-center);
-	if(std::fabs(adj[0])<std::fabs(pw*0.5) && std::fabs(adj[1])<std::fabs(ph*0.5))
-		return 0.5;
-	return (pw/Point(x-center).mag())/(PI*2);
+	return conical_supersample(x-center, pw, ph);
 }
 
 synfig::Layer::Handle
@@ -258,3 +299,16 @@ ConicalGradient::accelerated_render(Context context,Surface *surface,int quality
 
 	return true;
 }
+
+rendering::Task::Handle
+ConicalGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	etl::handle<ConicalGradientGenerator> generator(new ConicalGradientGenerator());
+	generator->center = param_center.get(Point());
+	generator->angle = param_angle.get(Angle());
+	generator->gradient = compiled_gradient;
+
+	rendering::TaskPixelGenerator::Handle task(new rendering::TaskPixelGenerator());
+	task->generator = generator;
+	return task;
+}
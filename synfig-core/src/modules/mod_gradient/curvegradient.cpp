@@ -49,6 +49,8 @@
 #include <synfig/value.h>
 #include <synfig/valuenode.h>
 
+#include <synfig/rendering/common/task/taskpixelgenerator.h>
+
 #endif
 
 /* === M A C R O S ========================================================= */
@@ -194,6 +196,30 @@ find_closest(bool fast, const std::vector<synfig::BLinePoint>& bline,const Point
 	return ret;
 }
 
+class CurveGradient::Generator: public rendering::PixelGenerator
+{
+public:
+	Params params;
+	int quality;
+
+	Generator(): quality(4) { }
+
+	// each pixel searches the closest point of the curve
+	virtual Real get_pixel_cost() const
+		{ return 16.0; }
+
+	virtual void generate(Color *dst, int pitch, int count, int rows, const Vector &p, const Vector &dx, const Vector &dy) const {
+		// see CurveGradient::calc_supersample()
+		Real supersample = get_pw(dx);
+		Point row = p;
+		for(int j = 0; j < rows; ++j, dst += pitch, row += dy) {
+			Point pos = row;
+			for(int i = 0; i < count; ++i, pos += dx)
+				dst[i] = color_func(params, pos, quality, supersample);
+		}
+	}
+};
+
 /* === M E T H O D S ======================================================= */
 
 inline void
@@ -246,15 +272,29 @@ CurveGradient::CurveGradient():
 	SET_STATIC_DEFAULTS();
 }
 
+void
+CurveGradient::fill_params(Params &params)const
+{
+	params.origin=param_origin.get(Point());
+	params.width=param_width.get(Real());
+	params.bline=param_bline.get_list_of(BLinePoint());
+	params.loop=param_loop.get(bool());
+	params.perpendicular=param_perpendicular.get(bool());
+	params.fast=param_fast.get(bool());
+	params.curve_length=curve_length_;
+	params.bline_loop=bline_loop;
+	params.gradient=compiled_gradient;
+}
+
 inline Color
-CurveGradient::color_func(const Point &point_, int quality, Real supersample)const
+CurveGradient::color_func(const Params &params, const Point &point_, int quality, Real supersample)
 {
-	Point origin=param_origin.get(Point());
-	Real width=param_width.get(Real());
-	std::vector<synfig::BLinePoint> bline(param_bline.get_list_of(BLinePoint()));
-	bool loop=param_loop.get(bool());
-	bool perpendicular=param_perpendicular.get(bool());
-	bool fast=param_fast.get(bool());
+	const Point &origin=params.origin;
+	const Real &width=params.width;
+	const std::vector<synfig::BLinePoint> &bline(params.bline);
+	const bool &loop=params.loop;
+	const bool &perpendicular=params.perpendicular;
+	const bool &fast=params.fast;
 
 	Vector tangent;
 	Vector diff;
@@ -284,12 +324,12 @@ CurveGradient::color_func(const Point &point_, int quality, Real supersample)con
 		// Taking into account looping.
 		if(perpendicular)
 		{
-			next=find_closest(fast,bline,point,t,bline_loop,&perp_dist);
-			perp_dist/=curve_length_;
+			next=find_closest(fast,bline,point,t,params.bline_loop,&perp_dist);
+			perp_dist/=params.curve_length;
 		}
 		else					// not perpendicular
 		{
-			next=find_closest(fast,bline,point,t,bline_loop);
+			next=find_closest(fast,bline,point,t,params.bline_loop);
 		}
 
 		iter=next++;
@@ -398,7 +438,7 @@ CurveGradient::color_func(const Point &point_, int quality, Real supersample)con
 
 		if(perpendicular)
 		{
-			tangent*=curve_length_;
+			tangent*=params.curve_length;
 			p1-=tangent*perp_dist;
 			tangent=-tangent.perp();
 		}
@@ -447,7 +487,7 @@ CurveGradient::color_func(const Point &point_, int quality, Real supersample)con
 	}
 
 	supersample *= 0.5;
-	return compiled_gradient.average(dist - supersample, dist + supersample);
+	return params.gradient.average(dist - supersample, dist + supersample);
 }
 
 Real
@@ -467,7 +507,11 @@ CurveGradient::hit_check(synfig::Context context, const synfig::Point &point)con
 
 	if(get_blend_method()==Color::BLEND_STRAIGHT && get_amount()>=0.5)
 		return const_cast<CurveGradient*>(this);
-	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE|| get_blend_method()==Color::BLEND_ONTO) && color_func(point).get_a()>0.5)
+
+	Params params;
+	fill_params(params);
+
+	if((get_blend_method()==Color::BLEND_STRAIGHT || get_blend_method()==Color::BLEND_COMPOSITE|| get_blend_method()==Color::BLEND_ONTO) && color_func(params, point).get_a()>0.5)
 		return const_cast<CurveGradient*>(this);
 	return context.hit_check(point);
 }
@@ -563,7 +607,10 @@ CurveGradient::get_param_vocab()const
 Color
 CurveGradient::get_color(Context context, const Point &point)const
 {
-	const Color color(color_func(point,0));
+	Params params;
+	fill_params(params);
+
+	const Color color(color_func(params,point,0));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 		return color;
@@ -591,6 +638,9 @@ CurveGradient::accelerated_render(Context context,Surface *surface,int quality,
 	}
 
 
+	Params params;
+	fill_params(params);
+
 	int x,y;
 
 	Surface::pen pen(surface->begin());
@@ -604,13 +654,13 @@ CurveGradient::accelerated_render(Context context,Surface *surface,int quality,
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(color_func(pos,quality,calc_supersample(pos,pw,ph)));
+				pen.put_value(color_func(params,pos,quality,calc_supersample(pos,pw,ph)));
 	}
 	else
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(Color::blend(color_func(pos,quality,calc_supersample(pos,pw,ph)),pen.get_value(),get_amount(),get_blend_method()));
+				pen.put_value(Color::blend(color_func(params,pos,quality,calc_supersample(pos,pw,ph)),pen.get_value(),get_amount(),get_blend_method()));
 	}
 
 	// Mark our progress as finished
@@ -620,3 +670,13 @@ CurveGradient::accelerated_render(Context context,Surface *surface,int quality,
 	return true;
 }
 
+rendering::Task::Handle
+CurveGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	etl::handle<Generator> generator(new Generator());
+	fill_params(generator->params);
+
+	rendering::TaskPixelGenerator::Handle task(new rendering::TaskPixelGenerator());
+	task->generator = generator;
+	return task;
+}
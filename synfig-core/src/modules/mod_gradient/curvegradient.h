@@ -71,9 +71,25 @@ private:
 
 	CompiledGradient compiled_gradient;
 
+	struct Params {
+		Point origin;
+		Real width;
+		std::vector<BLinePoint> bline;
+		bool loop;
+		bool perpendicular;
+		bool fast;
+		Real curve_length;
+		bool bline_loop;
+		CompiledGradient gradient;
+		inline Params(): width(), loop(false), perpendicular(false), fast(false), curve_length(), bline_loop(false) { }
+	};
+
+	class Generator;
+
 	void compile();
 	void sync();
-	Color color_func(const Point &x, int quality=10, Real supersample=0)const;
+	void fill_params(Params &params)const;
+	static Color color_func(const Params &params, const Point &x, int quality=10, Real supersample=0);
 	Real calc_supersample(const Point &x, Real pw, Real ph)const;
 
 public:
@@ -86,6 +102,9 @@ public:
 	Layer::Handle hit_check(synfig::Context context, const synfig::Point &point)const;
 
 	virtual Vocab get_param_vocab()const;
+
+protected:
+	virtual rendering::Task::Handle build_composite_task_vfunc(ContextParams context_params)const;
 };
 
 /* === E N D =============================================================== */
@@ -44,6 +44,8 @@
 #include <synfig/surface.h>
 #include <synfig/value.h>
 
+#include <synfig/rendering/common/task/taskpixelgenerator.h>
+
 #endif
 
 /* === M A C R O S ========================================================= */
@@ -58,6 +60,39 @@ SYNFIG_LAYER_SET_VERSION(LinearGradient,"0.0");
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+class LinearGradientGenerator: public rendering::PixelGenerator
+{
+public:
+	Point p1;
+	Vector diff;
+	Real length;
+	CompiledGradient gradient;
+
+	LinearGradientGenerator(): length() { }
+
+	virtual void generate(Color *dst, int pitch, int count, int rows, const Vector &p, const Vector &dx, const Vector &dy) const {
+		// distance along the gradient changes linearly within the row
+		Real dist = p*diff - p1*diff;
+		Real step = dx*diff;
+		Real row_step = dy*diff;
+		Real supersample = 0.5*get_pw(dx)/length;
+
+		std::vector<Real> x0(count), x1(count);
+		for(int j = 0; j < rows; ++j, dst += pitch, dist += row_step) {
+			for(int i = 0; i < count; ++i) {
+				Real d = dist + step*i;
+				x0[i] = d - supersample;
+				x1[i] = d + supersample;
+			}
+			gradient.average(dst, &x0.front(), &x1.front(), count);
+		}
+	}
+};
+
+} // namespace
+
 /* === M E T H O D S ======================================================= */
 
 inline void
@@ -272,3 +307,19 @@ LinearGradient::accelerated_render(Context context,Surface *surface,int quality,
 	return true;
 }
 
+rendering::Task::Handle
+LinearGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	Params params;
+	fill_params(params);
+
+	etl::handle<LinearGradientGenerator> generator(new LinearGradientGenerator());
+	generator->p1 = params.p1;
+	generator->diff = params.diff;
+	generator->length = (params.p2 - params.p1).mag();
+	generator->gradient = params.gradient;
+
+	rendering::TaskPixelGenerator::Handle task(new rendering::TaskPixelGenerator());
+	task->generator = generator;
+	return task;
+}
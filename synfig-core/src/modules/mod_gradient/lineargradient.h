@@ -83,6 +83,9 @@ public:
 	synfig::Layer::Handle hit_check(synfig::Context context, const synfig::Point &point)const;
 
 	virtual Vocab get_param_vocab()const;
+
+protected:
+	virtual rendering::Task::Handle build_composite_task_vfunc(ContextParams context_params)const;
 };
 
 /* === E N D =============================================================== */
@@ -43,6 +43,8 @@
 #include <synfig/surface.h>
 #include <synfig/value.h>
 
+#include <synfig/rendering/common/task/taskpixelgenerator.h>
+
 #include "radialgradient.h"
 
 #endif
@@ -61,6 +63,37 @@ SYNFIG_LAYER_SET_VERSION(RadialGradient,"0.1");
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+class RadialGradientGenerator: public rendering::PixelGenerator
+{
+public:
+	Point center;
+	Real radius;
+	CompiledGradient gradient;
+
+	RadialGradientGenerator(): radius() { }
+
+	virtual void generate(Color *dst, int pitch, int count, int rows, const Vector &p, const Vector &dx, const Vector &dy) const {
+		// see RadialGradient::calc_supersample()
+		Real supersample = 0.5*1.2*get_pw(dx)/radius;
+
+		std::vector<Real> x0(count), x1(count);
+		Point row = p - center;
+		for(int j = 0; j < rows; ++j, dst += pitch, row += dy) {
+			Point pos = row;
+			for(int i = 0; i < count; ++i, pos += dx) {
+				Real dist = pos.mag()/radius;
+				x0[i] = dist - supersample;
+				x1[i] = dist + supersample;
+			}
+			gradient.average(dst, &x0.front(), &x1.front(), count);
+		}
+	}
+};
+
+} // namespace
+
 /* === M E T H O D S ======================================================= */
 
 /* === E N T R Y P O I N T ================================================= */
@@ -246,4 +279,15 @@ RadialGradient::accelerated_render(Context context,Surface *surface,int quality,
 	return true;
 }
 
-
+rendering::Task::Handle
+RadialGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	etl::handle<RadialGradientGenerator> generator(new RadialGradientGenerator());
+	generator->center = param_center.get(Point());
+	generator->radius = param_radius.get(Real());
+	generator->gradient = compiled_gradient;
+
+	rendering::TaskPixelGenerator::Handle task(new rendering::TaskPixelGenerator());
+	task->generator = generator;
+	return task;
+}
@@ -43,6 +43,8 @@
 #include <synfig/surface.h>
 #include <synfig/value.h>
 
+#include <synfig/rendering/common/task/taskpixelgenerator.h>
+
 #include "spiralgradient.h"
 
 #endif
@@ -61,6 +63,61 @@ SYNFIG_LAYER_SET_VERSION(SpiralGradient,"0.1");
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+inline Real
+spiral_dist(const Point &centered, Real radius, const Angle &angle, bool clockwise)
+{
+	Angle a(angle);
+	a += Angle::tan(-centered[1],centered[0]).mod();
+
+	Real dist(centered.mag()/radius);
+	if(clockwise)
+		dist+=Angle::rot(a.mod()).get();
+	else
+		dist-=Angle::rot(a.mod()).get();
+	return dist;
+}
+
+inline Real
+spiral_supersample(const Point &centered, Real radius, Real pw)
+{
+	return (1.41421*pw/radius+(1.41421*pw/centered.mag())/(PI*2))*0.5;
+}
+
+class SpiralGradientGenerator: public rendering::PixelGenerator
+{
+public:
+	Point center;
+	Real radius;
+	Angle angle;
+	bool clockwise;
+	CompiledGradient gradient;
+
+	SpiralGradientGenerator(): radius(), clockwise() { }
+
+	virtual void generate(Color *dst, int pitch, int count, int rows, const Vector &p, const Vector &dx, const Vector &dy) const {
+		Real pw = get_pw(dx);
+
+		std::vector<Real> x0(count), x1(count);
+		Point row = p - center;
+		for(int j = 0; j < rows; ++j, dst += pitch, row += dy) {
+			Point pos = row;
+			for(int i = 0; i < count; ++i, pos += dx) {
+				Real dist = spiral_dist(pos, radius, angle, clockwise);
+				Real supersample = spiral_supersample(pos, radius, pw);
+				if(supersample<0.00001)supersample=0.00001;
+				supersample *= 0.5;
+				x0[i] = dist - supersample;
+				x1[i] = dist + supersample;
+			}
+			gradient.average(dst, &x0.front(), &x1.front(), count);
+		}
+	}
+};
+
+} // namespace
+
 /* === M E T H O D S ======================================================= */
 
 /* === E N T R Y P O I N T ================================================= */
@@ -152,18 +209,10 @@ SpiralGradient::color_func(const Point &pos, Real supersample)const
 	Real radius=param_radius.get(Real());
 	Angle angle=param_angle.get(Angle());
 	bool clockwise=param_clockwise.get(bool());
-	
-	const Point centered(pos-center);
-	Angle a(angle);
-	a += Angle::tan(-centered[1],centered[0]).mod();
 
 	if(supersample<0.00001)supersample=0.00001;
 
-	Real dist((pos-center).mag()/radius);
-	if(clockwise)
-		dist+=Angle::rot(a.mod()).get();
-	else
-		dist-=Angle::rot(a.mod()).get();
+	Real dist(spiral_dist(pos-center, radius, angle, clockwise));
 
 	supersample *= 0.5;
 	return compiled_gradient.average(dist - supersample, dist + supersample);
@@ -175,7 +224,7 @@ SpiralGradient::calc_supersample(const synfig::Point &x, Real pw, Real /*ph*/)co
 	Point center=param_center.get(Point());
 	Real radius=param_radius.get(Real());
 
-	return (1.41421*pw/radius+(1.41421*pw/Point(x-center).mag())/(PI*2))*0.5;
+	return spiral_supersample(x-center, radius, pw);
 }
 
 synfig::Layer::Handle
@@ -254,6 +303,17 @@ SpiralGradient::accelerated_render(Context context,Surface *surface,int quality,
 	return true;
 }
 
-
-
-
+rendering::Task::Handle
+SpiralGradient::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	etl::handle<SpiralGradientGenerator> generator(new SpiralGradientGenerator());
+	generator->center = param_center.get(Point());
+	generator->radius = param_radius.get(Real());
+	generator->angle = param_angle.get(Angle());
+	generator->clockwise = param_clockwise.get(bool());
+	generator->gradient = compiled_gradient;
+
+	rendering::TaskPixelGenerator::Handle task(new rendering::TaskPixelGenerator());
+	task->generator = generator;
+	return task;
+}
@@ -184,6 +184,12 @@ NoiseDistort::get_param(const String & param)const
 	return Layer_Composite::get_param(param);
 }
 
+bool
+NoiseDistort::is_time_invariant()const
+{
+	return param_speed.get(Real()) == 0.0 && Layer_CompositeFork::is_time_invariant();
+}
+
 Layer::Vocab
 NoiseDistort::get_param_vocab()const
 {
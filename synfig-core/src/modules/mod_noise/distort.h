@@ -79,7 +79,9 @@ public:
 	using Layer::get_bounding_rect;
 	virtual synfig::Rect get_bounding_rect(synfig::Context context)const;
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_time_invariant()const;
 	virtual bool reads_context()const { return true; }
+	virtual bool is_render_thread_safe()const { return true; }
 
 protected:
 	virtual synfig::RendDesc get_sub_renddesc_vfunc(const synfig::RendDesc &renddesc) const;
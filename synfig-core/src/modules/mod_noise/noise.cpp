@@ -47,6 +47,8 @@
 #include <synfig/value.h>
 #include <ctime>
 
+#include <synfig/rendering/common/task/taskpixelgenerator.h>
+
 #endif
 
 /* === M A C R O S ========================================================= */
@@ -63,6 +65,26 @@ SYNFIG_LAYER_SET_VERSION(Noise,"0.0");
 
 /* === P R O C E D U R E S ================================================= */
 
+class Noise::Generator: public synfig::rendering::PixelGenerator
+{
+public:
+	Params params;
+
+	virtual Real get_pixel_cost() const
+		{ return 16.0; }
+
+	virtual void generate(Color *dst, int pitch, int count, int rows, const Vector &p, const Vector &dx, const Vector &dy) const {
+		// see Noise::accelerated_render()
+		float supersampleradius((dx.mag()+dy.mag())*0.5f);
+		Point row = p;
+		for(int j = 0; j < rows; ++j, dst += pitch, row += dy) {
+			Point pos = row;
+			for(int i = 0; i < count; ++i, pos += dx)
+				dst[i] = color_func(params, pos, supersampleradius);
+		}
+	}
+};
+
 /* === M E T H O D S ======================================================= */
 
 Noise::Noise():
@@ -89,18 +111,33 @@ void
 Noise::compile()
 	{ compiled_gradient.set(param_gradient.get(Gradient()) ); }
 
+void
+Noise::fill_params(Params &params)const
+{
+	params.size=param_size.get(Vector());
+	params.seed=param_random.get(int());
+	params.smooth=param_smooth.get(int());
+	params.detail=param_detail.get(int());
+	params.speed=param_speed.get(Real());
+	params.turbulent=param_turbulent.get(bool());
+	params.do_alpha=param_do_alpha.get(bool());
+	params.super_sample=param_super_sample.get(bool());
+	params.time_mark=get_time_mark();
+	params.gradient=compiled_gradient;
+}
+
 inline Color
-Noise::color_func(const Point &point, float pixel_size,Context /*context*/)const
+Noise::color_func(const Params &params, const Point &point, float pixel_size)
 {
-	Vector size=param_size.get(Vector());
+	const Vector &size=params.size;
 	RandomNoise random;
-	random.set_seed(param_random.get(int()));
-	int smooth_=param_smooth.get(int());
-	int detail=param_detail.get(int());
-	Real speed=param_speed.get(Real());
-	bool turbulent=param_turbulent.get(bool());
-	bool do_alpha=param_do_alpha.get(bool());
-	bool super_sample=param_super_sample.get(bool());
+	random.set_seed(params.seed);
+	int smooth_=params.smooth;
+	int detail=params.detail;
+	Real speed=params.speed;
+	bool turbulent=params.turbulent;
+	bool do_alpha=params.do_alpha;
+	bool super_sample=params.super_sample;
 	
 
 	Color ret(0,0,0,0);
@@ -117,7 +154,7 @@ Noise::color_func(const Point &point, float pixel_size,Context /*context*/)const
 
 	int i;
 	Time time;
-	time=speed*get_time_mark();
+	time=speed*params.time_mark;
 	int smooth((!speed && smooth_ == (int)RandomNoise::SMOOTH_SPLINE) ? (int)RandomNoise::SMOOTH_FAST_SPLINE : smooth_);
 
 	float ftime(time);
@@ -185,9 +222,9 @@ Noise::color_func(const Point &point, float pixel_size,Context /*context*/)const
 
 		if(super_sample && pixel_size) {
 			Real da = std::max(amount3, std::max(amount,amount2)) - std::min(amount3, std::min(amount,amount2));
-			ret = compiled_gradient.average(amount - da, amount + da);
+			ret = params.gradient.average(amount - da, amount + da);
 		} else {
-			ret = compiled_gradient.color(amount);
+			ret = params.gradient.color(amount);
 		}
 
 		if(do_alpha)
@@ -213,7 +250,11 @@ Noise::hit_check(synfig::Context context, const synfig::Point &point)const
 
 	if(get_blend_method()==Color::BLEND_STRAIGHT && get_amount()>=0.5)
 		return const_cast<Noise*>(this);
-	if(color_func(point,0,context).get_a()>0.5)
+
+	Params params;
+	fill_params(params);
+
+	if(color_func(params,point,0).get_a()>0.5)
 		return const_cast<Noise*>(this);
 	return synfig::Layer::Handle();
 }
@@ -259,6 +300,12 @@ Noise::get_param(const String & param)const
 	return Layer_Composite::get_param(param);
 }
 
+bool
+Noise::is_time_invariant()const
+{
+	return param_speed.get(Real()) == 0.0 && Layer_Composite::is_time_invariant();
+}
+
 Layer::Vocab
 Noise::get_param_vocab()const
 {
@@ -315,7 +362,10 @@ Noise::get_param_vocab()const
 Color
 Noise::get_color(Context context, const Point &point)const
 {
-	const Color color(color_func(point,0,context));
+	Params params;
+	fill_params(params);
+
+	const Color color(color_func(params,point,0));
 
 	if(get_amount()==1.0 && get_blend_method()==Color::BLEND_STRAIGHT)
 		return color;
@@ -344,6 +394,9 @@ Noise::accelerated_render(Context context,Surface *surface,int quality, const Re
 	}
 
 
+	Params params;
+	fill_params(params);
+
 	int x,y;
 
 	Surface::pen pen(surface->begin());
@@ -360,13 +413,13 @@ Noise::accelerated_render(Context context,Surface *surface,int quality, const Re
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(color_func(pos,supersampleradius,context));
+				pen.put_value(color_func(params,pos,supersampleradius));
 	}
 	else
 	{
 		for(y=0,pos[1]=tl[1];y<h;y++,pen.inc_y(),pen.dec_x(x),pos[1]+=ph)
 			for(x=0,pos[0]=tl[0];x<w;x++,pen.inc_x(),pos[0]+=pw)
-				pen.put_value(Color::blend(color_func(pos,supersampleradius,context),pen.get_value(),get_amount(),get_blend_method()));
+				pen.put_value(Color::blend(color_func(params,pos,supersampleradius),pen.get_value(),get_amount(),get_blend_method()));
 	}
 
 	// Mark our progress as finished
@@ -375,3 +428,14 @@ Noise::accelerated_render(Context context,Surface *surface,int quality, const Re
 
 	return true;
 }
+
+rendering::Task::Handle
+Noise::build_composite_task_vfunc(ContextParams /*context_params*/)const
+{
+	etl::handle<Generator> generator(new Generator());
+	fill_params(generator->params);
+
+	rendering::TaskPixelGenerator::Handle task(new rendering::TaskPixelGenerator());
+	task->generator = generator;
+	return task;
+}
@@ -72,8 +72,25 @@ private:
 
 	synfig::CompiledGradient compiled_gradient;
 
+	struct Params {
+		synfig::Vector size;
+		int seed;
+		int smooth;
+		int detail;
+		synfig::Real speed;
+		bool turbulent;
+		bool do_alpha;
+		bool super_sample;
+		synfig::Time time_mark;
+		synfig::CompiledGradient gradient;
+		inline Params(): seed(), smooth(), detail(), speed(), turbulent(false), do_alpha(false), super_sample(false) { }
+	};
+
+	class Generator;
+
 	void compile();
-	synfig::Color color_func(const synfig::Point &x, float supersample,synfig::Context context)const;
+	void fill_params(Params &params)const;
+	static synfig::Color color_func(const Params &params, const synfig::Point &x, float supersample);
 	float calc_supersample(const synfig::Point &x, float pw,float ph)const;
 
 public:
@@ -85,6 +102,10 @@ public:
 	virtual bool accelerated_render(synfig::Context context,synfig::Surface *surface,int quality, const synfig::RendDesc &renddesc, synfig::ProgressCallback *cb)const;
 	synfig::Layer::Handle hit_check(synfig::Context context, const synfig::Point &point)const;
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_time_invariant()const;
+
+protected:
+	virtual synfig::rendering::Task::Handle build_composite_task_vfunc(synfig::ContextParams context_params)const;
 };
 
 /* === E N D =============================================================== */
@@ -40,6 +40,7 @@
 
 #include "mptr_png.h"
 
+#include <synfig/color/pixelformat.h>
 #include <synfig/filecontainerzip.h>
 #include <synfig/general.h>
 
@@ -69,6 +70,11 @@ namespace {
 		int max = (1 << bit_depth) - 1;
 		return x/ColorReal(max);
 	}
+
+	inline void convert_rows(Surface &surface, png_bytep *rows, PixelFormat pf, const Gamma &gamma) {
+		for(int y = 0; y < surface.get_h(); ++y)
+			pixelformat_to_color(surface[y], rows[y], pf, &gamma, surface.get_w());
+	}
 }
 
 void
@@ -236,6 +242,8 @@ png_mptr::get_frame(synfig::Surface &surface, const synfig::RendDesc &/*renddesc
 	switch(color_type)
 	{
 	case PNG_COLOR_TYPE_RGB:
+		if (bit_depth == 8)
+			{ convert_rows(surface, row_pointers, PF_RGB, gamma); break; }
 		for(int y = 0; y < surface.get_h(); ++y)
 			for(int x = 0; x < surface.get_w(); ++x)
 				surface[y][x]=gamma.apply(Color(
@@ -244,6 +252,8 @@ png_mptr::get_frame(synfig::Surface &surface, const synfig::RendDesc &/*renddesc
 					get_channel(row_pointers, bit_depth, y, x*3+2) ));
 		break;
 	case PNG_COLOR_TYPE_RGB_ALPHA:
+		if (bit_depth == 8)
+			{ convert_rows(surface, row_pointers, PF_RGB|PF_A, gamma); break; }
 		for(int y = 0; y < surface.get_h(); ++y)
 			for(int x = 0; x < surface.get_w(); ++x)
 				surface[y][x]=gamma.apply(Color(
@@ -253,6 +263,8 @@ png_mptr::get_frame(synfig::Surface &surface, const synfig::RendDesc &/*renddesc
 					get_channel(row_pointers, bit_depth, y, x*4+3) ));
 		break;
 	case PNG_COLOR_TYPE_GRAY:
+		if (bit_depth == 8)
+			{ convert_rows(surface, row_pointers, PF_GRAY, gamma); break; }
 		for(int y = 0; y < surface.get_h(); ++y)
 			for(int x = 0; x < surface.get_w(); ++x)
 			{
@@ -261,6 +273,8 @@ png_mptr::get_frame(synfig::Surface &surface, const synfig::RendDesc &/*renddesc
 			}
 		break;
 	case PNG_COLOR_TYPE_GRAY_ALPHA:
+		if (bit_depth == 8)
+			{ convert_rows(surface, row_pointers, PF_GRAY|PF_A, gamma); break; }
 		for(int y = 0; y < surface.get_h(); ++y)
 			for(int x = 0; x < surface.get_w(); ++x)
 			{
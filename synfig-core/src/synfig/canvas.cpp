@@ -42,6 +42,7 @@
 #include <synfig/localization.h>
 
 #include "canvas.h"
+#include "canvastaskcache.h"
 #include "context.h"
 #include "exception.h"
 #include "filesystemnative.h"
@@ -49,6 +50,7 @@
 #include "loadcanvas.h"
 
 #include "layers/layer_pastecanvas.h"
+#include "valuenodes/valuenode_const.h"
 #include "rendering/common/task/taskpixelprocessor.h"
 
 #endif
@@ -87,6 +89,8 @@ Canvas::Canvas(const String &id):
 	cur_time_	(0),
 	is_inline_	(false),
 	is_dirty_	(true),
+	task_cache_	(new CanvasTaskCache(this)),
+	task_cache_revision_(-1),
 	outline_grow(0.0)
 {
 	identifier_.file_system = FileSystemNative::instance();
@@ -101,6 +105,8 @@ Canvas::on_changed()
 		"%s:%d Canvas::on_changed()\n", __FILE__, __LINE__);
 
 	is_dirty_=true;
+	if (task_cache_ && task_cache_->is_owner(this))
+		task_cache_->invalidate();
 	Node::on_changed();
 }
 
@@ -356,7 +362,7 @@ Canvas::build_rendering_task(const ContextParams &context_params) const
 {
 	CanvasBase sub_list;
 	Context context = get_context_sorted(context_params, sub_list);
-	rendering::Task::Handle task = context.build_rendering_task();
+	rendering::Task::Handle task = build_rendering_task_cached(context);
 	
 	rendering::TaskPixelGamma::Handle task_gamma(new rendering::TaskPixelGamma());
 	task_gamma->gamma = get_root()->rend_desc().get_gamma().get_inverted();
@@ -367,6 +373,63 @@ Canvas::build_rendering_task(const ContextParams &context_params) const
 	return task;
 }
 
+bool
+Canvas::is_time_invariant() const
+{
+	long long revision = task_cache_revision_ < 0 ? task_cache_->get_revision() : task_cache_revision_;
+	int cached = task_cache_->get_time_invariant(revision);
+	if (cached >= 0)
+		return cached != 0;
+
+	bool invariant = true;
+	for(const_iterator i = begin(); invariant && i != end(); ++i)
+		if ((*i)->active() && !(*i)->is_time_invariant())
+			invariant = false;
+
+	task_cache_->set_time_invariant(invariant, revision);
+	return invariant;
+}
+
+rendering::Task::Handle
+Canvas::build_rendering_task_cached(Context context, String *out_fingerprint) const
+{
+	if (out_fingerprint)
+		out_fingerprint->clear();
+
+	long long revision = task_cache_revision_ < 0 ? task_cache_->get_revision() : task_cache_revision_;
+	if (!is_time_invariant())
+		return context.build_rendering_task();
+
+	// key is made of layer indices instead of pointers,
+	// because copies made by clone_for_time() have their own layers
+	std::map<const Layer*, int> indices;
+	int index = 0;
+	for(const_iterator i = begin(); i != end(); ++i, ++index)
+		indices[i->get()] = index;
+
+	CanvasTaskCache::Key key;
+	key.params = context.get_params();
+	for(Context c = context; *c; ++c)
+	{
+		std::map<const Layer*, int>::const_iterator found = indices.find(c->get());
+		if (found == indices.end())
+			return context.build_rendering_task();
+		if (key.layers.empty())
+			key.outline_grow = (*c)->get_outline_grow_mark();
+		key.layers.push_back(found->second);
+	}
+
+	rendering::Task::Handle task;
+	if (!task_cache_->get(key, revision, task))
+	{
+		task = context.build_rendering_task();
+		task_cache_->put(key, revision, task);
+	}
+	if (out_fingerprint)
+		*out_fingerprint = task_cache_->get_fingerprint(key, revision);
+	return task;
+}
+
 
 const ValueNodeList &
 Canvas::value_node_list()const
@@ -1025,6 +1088,90 @@ Canvas::clone(const GUID& deriv_guid, bool for_export)const
 	return canvas;
 }
 
+Canvas::Handle
+Canvas::clone_for_time(Time time, bool *time_dependent)const
+{
+	std::map<const Canvas*, Handle> copies;
+	bool dependent = false;
+	Handle canvas = clone_for_time(time, copies, dependent);
+	if (time_dependent) *time_dependent = dependent;
+	return canvas;
+}
+
+Canvas::Handle
+Canvas::clone_for_time(Time time, std::map<const Canvas*, Handle> &copies, bool &time_dependent)const
+{
+	std::map<const Canvas*, Handle>::const_iterator found = copies.find(this);
+	if (found != copies.end())
+		return found->second;
+
+	Handle canvas(new Canvas(get_id()));
+	copies[this] = canvas;
+
+	canvas->is_inline_ = is_inline_;
+	canvas->rend_desc() = rend_desc();
+	canvas->set_parent(parent());
+	if (canvas->parent().empty()) {
+		canvas->set_identifier(get_identifier());
+		canvas->set_file_name(get_file_name());
+	}
+
+	for(const_iterator iter = begin(); iter != end(); ++iter)
+	{
+		const Layer &orig = **iter;
+		Layer::Handle layer = Layer::create(orig.get_name()).get();
+		if (!layer)
+		{
+			// the copy shares cached tasks with the document by index of layer
+			// (see build_rendering_task_cached()), so it cannot skip the layer
+			synfig::error("Canvas::clone_for_time(): Unable to clone layer %s", orig.get_name().c_str());
+			return Handle();
+		}
+
+		// layer should know its canvas before parameters are set (see Import::set_param())
+		layer->set_canvas(canvas);
+		layer->set_description(orig.get_description());
+		layer->set_active(orig.active());
+		layer->set_optimized(orig.optimized());
+		layer->set_exclude_from_rendering(orig.get_exclude_from_rendering());
+
+		// replace canvases by copies, including animated ones,
+		// because Layer::set_time() would restore original canvases from value nodes
+		Layer::ParamList param_list(orig.get_param_list());
+		for(Layer::DynamicParamList::const_iterator i = orig.dynamic_param_list().begin(); i != orig.dynamic_param_list().end(); ++i)
+			if (i->second->get_type() == type_canvas)
+			{
+				param_list[i->first] = (*i->second)(time);
+				if (!ValueNode_Const::Handle::cast_dynamic(i->second))
+					time_dependent = true;
+			}
+		for(Layer::ParamList::iterator i = param_list.begin(); i != param_list.end(); ++i)
+			if (i->second.get_type() == type_canvas)
+				if (Canvas::Handle sub_canvas = i->second.get(Canvas::Handle()))
+				{
+					Canvas::Handle copy = sub_canvas->clone_for_time(time, copies, time_dependent);
+					if (!copy) return Handle();
+					i->second = ValueBase(copy);
+				}
+		layer->set_param_list(param_list);
+
+		for(Layer::DynamicParamList::const_iterator i = orig.dynamic_param_list().begin(); i != orig.dynamic_param_list().end(); ++i)
+			if (i->second->get_type() != type_canvas)
+				layer->connect_dynamic_param(i->first, i->second);
+
+		canvas->push_back(layer);
+	}
+
+	canvas->signal_group_pair_removed().clear();
+	canvas->signal_group_pair_added().clear();
+
+	// share the tasks with the document, see build_rendering_task_cached()
+	canvas->task_cache_ = task_cache_;
+	canvas->task_cache_revision_ = task_cache_->get_revision();
+
+	return canvas;
+}
+
 void
 Canvas::set_inline(LooseHandle parent)
 {
@@ -1282,6 +1429,15 @@ Canvas::get_times_vfunc(Node::time_set &set) const
 	}
 }
 
+void
+Canvas::get_child_changed_time(const Node *x, Time &time_begin, Time &time_end)const
+{
+	Node::get_child_changed_time(x, time_begin, time_end);
+	for(const_iterator i = begin(); i != end() && i->get() != x; ++i)
+		if (*i && (*i)->active() && (*i)->changes_context_time())
+			{ time_begin = Time::begin(); time_end = Time::end(); break; }
+}
+
 std::set<Layer::Handle>
 Canvas::get_layers_in_group(const String&group)
 {
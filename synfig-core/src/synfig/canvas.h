@@ -145,6 +145,7 @@ namespace synfig {
 class IndependentContext;
 class ContextParams;
 class Context;
+class CanvasTaskCache;
 class GUID;
 class Canvas;
 class SoundProcessor;
@@ -250,6 +251,11 @@ private:
 	//! True if the Canvas properties has changed
 	mutable bool is_dirty_;
 
+	//! Rendering task reused while the canvas is time-invariant, shared with copies for rendering
+	etl::handle<CanvasTaskCache> task_cache_;
+	//! Revision of task_cache_ this copy was made for, -1 when canvas owns the cache
+	long long task_cache_revision_;
+
 	//! Layer Group database
 	std::map<String,std::set<etl::handle<Layer> > > group_db_;
 
@@ -601,6 +607,17 @@ public:
 	//! Creates sorted context and builds task for rendering based on it with applied gamma
 	rendering::Task::Handle build_rendering_task(const ContextParams &context_params) const;
 
+	//! Returns \c true when no active layer of the canvas depends on time
+	//! \see Layer::is_time_invariant()
+	bool is_time_invariant() const;
+
+	//! Builds task for the \a context made of layers of this canvas.
+	//! When the canvas is time-invariant the task built for the previous frame is reused.
+	//! Then \a out_fingerprint receives the string identifying the contents of the task,
+	//! otherwise it's cleared.
+	//! \see CanvasTaskCache
+	rendering::Task::Handle build_rendering_task_cached(Context context, String *out_fingerprint = nullptr) const;
+
 	int indexof(const const_iterator &iter) const;
 	iterator byindex(int index);
 	const_iterator byindex(int index) const;
@@ -677,6 +694,20 @@ public:
 	//! Clones (copies) the Canvas
 	Handle clone(const GUID& deriv_guid=GUID(), bool for_export=false)const;
 
+	//! Copies the Canvas and all the canvases used by its layers to render the frame at \a time.
+	/*! Copied layers share the value nodes with the originals, but all the canvas parameters
+	**  are replaced by copies, so set_time() of the copy never touches the layers of the document.
+	**  Animated canvas parameters are fixed to their values at \a time, in this case
+	**  \a time_dependent (when given) is set to \c true and the copy is valid only at \a time.
+	**  Returns null handle when some layer cannot be copied.
+	**	\see EvaluatedFrame */
+	Handle clone_for_time(Time time, bool *time_dependent = nullptr)const;
+
+private:
+	Handle clone_for_time(Time time, std::map<const Canvas*, Handle> &copies, bool &time_dependent)const;
+
+public:
+
 	//! Stores the external canvas by its file name and the Canvas handle
 	void register_external_canvas(String file, Handle canvas);
 
@@ -716,6 +747,9 @@ protected:
 	virtual void on_parent_set();
 	//! Sets the Canvas to dirty and calls Node::on_changed()
 	virtual void on_changed();
+	//! Widens the interval to the whole time line when the changed layer
+	//! is under a layer which changes time of its context
+	virtual void get_child_changed_time(const Node *x, Time &begin, Time &end)const;
 	//! Collects the times (TimePoints) of the Layers of the Canvas and
 	//! stores it in the passed Time Set \set
 	//! \see Node::get_times()
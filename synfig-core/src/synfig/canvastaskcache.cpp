@@ -0,0 +1,183 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file canvastaskcache.cpp
+**	\brief CanvasTaskCache File
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "canvastaskcache.h"
+
+#include "layer.h"
+#include "string_helper.h"
+#include "rendering/common/task/tasklayer.h"
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+namespace {
+	void
+	clone_legacy_layers(const rendering::Task::Handle &task)
+	{
+		if (!task)
+			return;
+		// most of legacy layers are not thread-safe, so each copy of the task needs its own flat copy of the layer
+		if (rendering::TaskLayer::Handle task_layer = rendering::TaskLayer::Handle::cast_dynamic(task))
+			if (task_layer->layer && !task_layer->layer->is_render_thread_safe())
+				if (Layer::Handle copy = task_layer->layer->clone_for_rendering())
+					task_layer->layer = copy;
+		for(rendering::Task::List::const_iterator i = task->sub_tasks.begin(); i != task->sub_tasks.end(); ++i)
+			clone_legacy_layers(*i);
+	}
+}
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+bool
+CanvasTaskCache::Key::operator==(const Key &other) const
+{
+	return params.render_excluded_contexts == other.params.render_excluded_contexts
+		&& params.z_range == other.params.z_range
+		&& params.z_range_position == other.params.z_range_position
+		&& params.z_range_depth == other.params.z_range_depth
+		&& params.z_range_blur == other.params.z_range_blur
+		&& params.force_set_time == other.params.force_set_time
+		&& outline_grow == other.outline_grow
+		&& layers == other.layers;
+}
+
+String
+CanvasTaskCache::Key::get_string() const
+{
+	String s = strprintf( "%d %d %a %a %a %d %a",
+		(int)params.render_excluded_contexts,
+		(int)params.z_range,
+		params.z_range_position,
+		params.z_range_depth,
+		params.z_range_blur,
+		(int)params.force_set_time,
+		outline_grow );
+	for(std::vector<int>::const_iterator i = layers.begin(); i != layers.end(); ++i)
+		s += strprintf(" %d", *i);
+	return s;
+}
+
+std::atomic<long long> CanvasTaskCache::last_id(0);
+
+CanvasTaskCache::CanvasTaskCache(const Canvas *owner):
+	id(++last_id),
+	owner(owner),
+	revision(0),
+	time_invariant(-1),
+	valid(false)
+{ }
+
+void
+CanvasTaskCache::invalidate()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	++revision;
+	time_invariant = -1;
+	valid = false;
+	task.reset();
+}
+
+long long
+CanvasTaskCache::get_revision() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return revision;
+}
+
+String
+CanvasTaskCache::get_fingerprint(const Key &key, long long revision) const
+	{ return strprintf("canvas %lld %lld|", id, revision) + key.get_string(); }
+
+int
+CanvasTaskCache::get_time_invariant(long long revision) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return this->revision == revision ? time_invariant : -1;
+}
+
+void
+CanvasTaskCache::set_time_invariant(bool invariant, long long revision)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (this->revision == revision)
+		time_invariant = invariant ? 1 : 0;
+}
+
+bool
+CanvasTaskCache::get(const Key &key, long long revision, rendering::Task::Handle &out_task) const
+{
+	rendering::Task::Handle stored;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!valid || this->revision != revision || this->key != key)
+			return false;
+		stored = task;
+	}
+	// stored task is never changed, so it's safe to copy it without lock
+	out_task = copy_task(stored);
+	return true;
+}
+
+void
+CanvasTaskCache::put(const Key &key, long long revision, const rendering::Task::Handle &task)
+{
+	rendering::Task::Handle copy = copy_task(task);
+	std::lock_guard<std::mutex> lock(mutex);
+	if (this->revision != revision || time_invariant != 1)
+		return;
+	this->key = key;
+	this->task = copy;
+	valid = true;
+}
+
+rendering::Task::Handle
+CanvasTaskCache::copy_task(const rendering::Task::Handle &task)
+{
+	if (!task)
+		return rendering::Task::Handle();
+	rendering::Task::Handle copy = task->clone_recursive();
+	clone_legacy_layers(copy);
+	return copy;
+}
+
+/* === E N T R Y P O I N T ================================================= */
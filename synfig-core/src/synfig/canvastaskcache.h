@@ -0,0 +1,131 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file canvastaskcache.h
+**	\brief CanvasTaskCache Header
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_CANVASTASKCACHE_H
+#define __SYNFIG_CANVASTASKCACHE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <ETL/handle>
+
+#include "context.h"
+#include "rendering/task.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig {
+
+class Canvas;
+
+/*!	\class CanvasTaskCache
+**	\brief Rendering task built for the layers of time-invariant canvas.
+**
+**	When no layer of the canvas depends on time (see Canvas::is_time_invariant())
+**	the task built for one frame is valid for all other frames,
+**	so Canvas::build_rendering_task_cached() takes a copy of the stored task
+**	instead of building it again.
+**
+**	The cache is created by the canvas and shared with its copies
+**	made by Canvas::clone_for_time(), only the owner canvas invalidates it
+**	when it is changed. Every change increments the revision and the data
+**	is accessed only for the certain revision, so copies made before the change
+**	never get or put the outdated task. All the methods are thread-safe.
+*/
+class CanvasTaskCache: public etl::shared_object
+{
+public:
+	typedef etl::handle<CanvasTaskCache> Handle;
+
+	//! Everything except the canvas itself the built task depends on
+	struct Key
+	{
+		ContextParams params;
+		Real outline_grow;
+		//! Indices of the context layers in the canvas
+		std::vector<int> layers;
+
+		Key(): outline_grow() { }
+		bool operator==(const Key &other) const;
+		bool operator!=(const Key &other) const { return !(*this == other); }
+
+		String get_string() const;
+	};
+
+private:
+	static std::atomic<long long> last_id;
+
+	//! Unique for each cache, unlike the pointer it's never reused
+	const long long id;
+	const Canvas *owner;
+
+	mutable std::mutex mutex;
+	long long revision;
+	int time_invariant;
+	bool valid;
+	Key key;
+	rendering::Task::Handle task;
+
+public:
+	explicit CanvasTaskCache(const Canvas *owner);
+
+	bool is_owner(const Canvas *canvas) const { return owner == canvas; }
+
+	//! Forgets the stored task and the result of the time-invariance check
+	void invalidate();
+
+	long long get_revision() const;
+
+	//! Identifies the task built for the key at the revision among all the caches,
+	//! it's used to make keys of the rendered surfaces (see rendering::SurfaceCache)
+	String get_fingerprint(const Key &key, long long revision) const;
+
+	//! Returns 1 or 0 for the stored result of the time-invariance check, and -1 if it's unknown
+	int get_time_invariant(long long revision) const;
+	void set_time_invariant(bool invariant, long long revision);
+
+	//! Gets copy of the stored task, returns \c false when nothing was stored for this key
+	bool get(const Key &key, long long revision, rendering::Task::Handle &out_task) const;
+	//! Stores copy of the task built for the key, when the canvas is known as time-invariant
+	void put(const Key &key, long long revision, const rendering::Task::Handle &task);
+
+	//! Makes copy of the task tree, suitable to optimize and run it independently from the original
+	static rendering::Task::Handle copy_task(const rendering::Task::Handle &task);
+}; // END of class CanvasTaskCache
+
+}; // END of namespace synfig
+
+/* === E N D =============================================================== */
+
+#endif
@@ -46,10 +46,154 @@
 
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace synfig;
 
 #define COLOR_EPSILON	(0.000001f)
 
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+
+typedef void (*blendspanfunc)(Color*, const Color*, int, const Color*, int, int, float);
+
+template<blendfunc func>
+void
+blend_span_generic(Color *dest, const Color *a, int a_step, const Color *b, int b_step, int count, float amount)
+{
+	for(; count > 0; --count, ++dest, a += a_step, b += b_step) {
+		Color ca(*a), cb(*b);
+		*dest = func(ca, cb, amount);
+	}
+}
+
+#ifdef __SSE2__
+
+// pixel is a vector of four floats (r, g, b, a)
+// each kernel repeats the arithmetic of the corresponding blendfunc_*() template
+
+static_assert(sizeof(Color) == 4*sizeof(float), "Color should be a plain array of four floats");
+
+inline __m128 load(const Color *c)
+	{ return _mm_loadu_ps(reinterpret_cast<const float*>(c)); }
+inline void store(Color *c, __m128 x)
+	{ _mm_storeu_ps(reinterpret_cast<float*>(c), x); }
+inline __m128 splat_alpha(__m128 x)
+	{ return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+inline __m128 select(__m128 mask, __m128 x, __m128 y)
+	{ return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y)); }
+inline __m128 rgb_mask()
+	{ return _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)); }
+//! takes rgb from \a x and alpha from the last component of \a alpha
+inline __m128 set_alpha(__m128 x, __m128 alpha)
+	{ return select(rgb_mask(), x, alpha); }
+inline __m128 abs(__m128 x)
+	{ return _mm_andnot_ps(_mm_set1_ps(-0.f), x); }
+
+//! divides \a x by \a alpha and sets the alpha, returns Color::alpha() when \a alpha is zero
+inline __m128 unpremult(__m128 x, __m128 alpha)
+{
+	static const Color transparent = Color::alpha();
+	__m128 valid = _mm_cmpgt_ps(abs(alpha), _mm_set1_ps(COLOR_EPSILON));
+	x = _mm_mul_ps(x, _mm_div_ps(_mm_set1_ps(1.f), alpha));
+	return select(valid, set_alpha(x, alpha), load(&transparent));
+}
+
+inline __m128 blend_composite(__m128 a, __m128 b, __m128 amount)
+{
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 a_src = _mm_mul_ps(splat_alpha(a), amount);
+	__m128 a_dest = splat_alpha(b);
+	__m128 k = _mm_sub_ps(one, a_src);
+	__m128 x = _mm_add_ps(_mm_mul_ps(a, a_src), _mm_mul_ps(_mm_mul_ps(b, a_dest), k));
+	return unpremult(x, _mm_add_ps(a_src, _mm_mul_ps(a_dest, k)));
+}
+
+inline __m128 blend_straight(__m128 a, __m128 b, __m128 amount)
+{
+	__m128 a_src = splat_alpha(a);
+	__m128 a_bg = splat_alpha(b);
+	__m128 a_out = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(a_src, a_bg), amount), a_bg);
+	__m128 bg = _mm_mul_ps(b, a_bg);
+	__m128 x = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(a, a_src), bg), amount), bg);
+	return unpremult(x, a_out);
+}
+
+inline __m128 blend_onto(__m128 a, __m128 b, __m128 amount)
+	{ return set_alpha(blend_composite(a, set_alpha(b, _mm_set1_ps(1.f)), amount), b); }
+
+inline __m128 blend_straight_onto(__m128 a, __m128 b, __m128 amount)
+	{ return blend_straight(set_alpha(a, _mm_mul_ps(a, splat_alpha(b))), b, amount); }
+
+inline __m128 blend_behind(__m128 a, __m128 b, __m128 amount)
+{
+	__m128 a_src = splat_alpha(a);
+	__m128 zero = _mm_cmpeq_ps(a_src, _mm_setzero_ps());
+	a_src = select(zero, _mm_set1_ps(COLOR_EPSILON), a_src);
+	return blend_composite(b, set_alpha(a, _mm_mul_ps(a_src, amount)), _mm_set1_ps(1.f));
+}
+
+inline __m128 blend_add(__m128 a, __m128 b, __m128 amount)
+{
+	__m128 x = _mm_add_ps(_mm_mul_ps(b, splat_alpha(b)), _mm_mul_ps(a, _mm_mul_ps(splat_alpha(a), amount)));
+	return set_alpha(x, b);
+}
+
+inline __m128 blend_subtract(__m128 a, __m128 b, __m128 amount)
+{
+	__m128 x = _mm_sub_ps(_mm_mul_ps(b, splat_alpha(b)), _mm_mul_ps(a, _mm_mul_ps(splat_alpha(a), amount)));
+	return set_alpha(x, b);
+}
+
+inline __m128 blend_difference(__m128 a, __m128 b, __m128 amount)
+	{ return set_alpha(abs(blend_subtract(a, b, amount)), b); }
+
+inline __m128 blend_brighten(__m128 a, __m128 b, __m128 amount)
+{
+	__m128 x = _mm_mul_ps(a, _mm_mul_ps(splat_alpha(a), amount));
+	return set_alpha(select(_mm_cmplt_ps(b, x), x, b), b);
+}
+
+inline __m128 blend_darken(__m128 a, __m128 b, __m128 amount)
+{
+	__m128 one = _mm_set1_ps(1.f);
+	__m128 x = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(a, one), _mm_mul_ps(splat_alpha(a), amount)), one);
+	return set_alpha(select(_mm_cmpgt_ps(b, x), x, b), b);
+}
+
+//! negative amount is processed by blend_span_generic()
+inline __m128 blend_multiply(__m128 a, __m128 b, __m128 amount)
+{
+	amount = _mm_mul_ps(amount, splat_alpha(a));
+	__m128 x = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(b, a), b), amount), b);
+	return set_alpha(x, b);
+}
+
+inline __m128 blend_alpha(__m128 a, __m128 b, __m128 amount)
+	{ return blend_straight(set_alpha(b, _mm_mul_ps(splat_alpha(a), b)), b, amount); }
+
+inline __m128 blend_alpha_over(__m128 a, __m128 b, __m128 amount)
+{
+	__m128 k = _mm_sub_ps(_mm_set1_ps(1.f), splat_alpha(a));
+	return blend_straight(set_alpha(b, _mm_mul_ps(k, b)), b, amount);
+}
+
+template<__m128 (*func)(__m128, __m128, __m128)>
+void
+blend_span_sse2(Color *dest, const Color *a, int a_step, const Color *b, int b_step, int count, float amount)
+{
+	__m128 amount_v = _mm_set1_ps(amount);
+	for(; count > 0; --count, ++dest, a += a_step, b += b_step)
+		store(dest, func(load(a), load(b), amount_v));
+}
+
+#endif // __SSE2__
+
+} // end of anonymous namespace
+
 /* === M E T H O D S ======================================================= */
 
 ColorReal
@@ -241,3 +385,84 @@ Color::blend(Color a, Color b, float amount, Color::BlendMethod type)
 	return vtable[type](a,b,amount);
 }
 
+void
+Color::blend_span(
+	Color *dest,
+	const Color *a, int a_step,
+	const Color *b, int b_step,
+	int count, float amount, BlendMethod type )
+{
+	if (count <= 0) return;
+
+	// the same as in blend()
+	if (fabsf(amount) <= COLOR_EPSILON) {
+		if (dest != b || b_step != 1)
+			for(; count > 0; --count, ++dest, b += b_step)
+				*dest = *b;
+		return;
+	}
+
+	assert(type < BLEND_END);
+
+	const static blendspanfunc vtable[BLEND_END]=
+	{
+#ifdef __SSE2__
+		blend_span_sse2<blend_composite>,	// 0
+		blend_span_sse2<blend_straight>,
+		blend_span_sse2<blend_brighten>,
+		blend_span_sse2<blend_darken>,
+		blend_span_sse2<blend_add>,
+		blend_span_sse2<blend_subtract>,	// 5
+		blend_span_sse2<blend_multiply>,
+#else
+		blend_span_generic<blendfunc_COMPOSITE<Color> >,	// 0
+		blend_span_generic<blendfunc_STRAIGHT<Color> >,
+		blend_span_generic<blendfunc_BRIGHTEN<Color> >,
+		blend_span_generic<blendfunc_DARKEN<Color> >,
+		blend_span_generic<blendfunc_ADD<Color> >,
+		blend_span_generic<blendfunc_SUBTRACT<Color> >,		// 5
+		blend_span_generic<blendfunc_MULTIPLY<Color> >,
+#endif
+		blend_span_generic<blendfunc_DIVIDE<Color> >,
+		blend_span_generic<blendfunc_COLOR<Color> >,
+		blend_span_generic<blendfunc_HUE<Color> >,
+		blend_span_generic<blendfunc_SATURATION<Color> >,	// 10
+		blend_span_generic<blendfunc_LUMINANCE<Color> >,
+#ifdef __SSE2__
+		blend_span_sse2<blend_behind>,
+		blend_span_sse2<blend_onto>,
+#else
+		blend_span_generic<blendfunc_BEHIND<Color> >,
+		blend_span_generic<blendfunc_ONTO<Color> >,
+#endif
+		blend_span_generic<blendfunc_ALPHA_BRIGHTEN<Color> >,
+		blend_span_generic<blendfunc_ALPHA_DARKEN<Color> >,	// 15
+		blend_span_generic<blendfunc_SCREEN<Color> >,
+		blend_span_generic<blendfunc_HARD_LIGHT<Color> >,
+#ifdef __SSE2__
+		blend_span_sse2<blend_difference>,
+		blend_span_sse2<blend_alpha_over>,
+#else
+		blend_span_generic<blendfunc_DIFFERENCE<Color> >,
+		blend_span_generic<blendfunc_ALPHA_OVER<Color> >,
+#endif
+		blend_span_generic<blendfunc_OVERLAY<Color> >,		// 20
+#ifdef __SSE2__
+		blend_span_sse2<blend_straight_onto>,
+		blend_span_generic<blendfunc_ADD_COMPOSITE<Color> >,
+		blend_span_sse2<blend_alpha>,
+#else
+		blend_span_generic<blendfunc_STRAIGHT_ONTO<Color> >,
+		blend_span_generic<blendfunc_ADD_COMPOSITE<Color> >,
+		blend_span_generic<blendfunc_ALPHA<Color> >,
+#endif
+	};
+
+	#ifdef __SSE2__
+	if (type == BLEND_MULTIPLY && amount < 0)
+		{ blend_span_generic<blendfunc_MULTIPLY<Color> >(dest, a, a_step, b, b_step, count, amount); return; }
+	#endif
+
+	vtable[type](dest, a, a_step, b, b_step, count, amount);
+}
+
@@ -324,6 +324,16 @@ public:
 	/* Other */
 	static Color blend(Color a, Color b, float amount, BlendMethod type=BLEND_COMPOSITE);
 
+	//! Blends \a count colors from \a a onto the colors from \a b and writes the results to \a dest,
+	//! the same as Color::blend() for each pixel, but much faster.
+	//! \a a_step and \a b_step are 1 to walk through the arrays or 0 to use the same color for all pixels.
+	//! \a dest may be the same array as \a a or \a b
+	static void blend_span(
+		Color *dest,
+		const Color *a, int a_step,
+		const Color *b, int b_step,
+		int count, float amount, BlendMethod type=BLEND_COMPOSITE );
+
 	static bool is_onto(BlendMethod x)
 		{ return BLEND_METHODS_ONTO & (1 << x); }
 
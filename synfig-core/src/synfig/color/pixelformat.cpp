@@ -27,17 +27,116 @@
 */
 /* ========================================================================= */
 
+
 #include "pixelformat.h"
 #include <cassert>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 using namespace synfig;
 
+namespace {
+	//! Gamma correction of output values without calls of pow().
+	//! Input is the clamped channel value, output is multiplied by 65535.99,
+	//! values between the nodes of table are linearly interpolated.
+	//! For gamma < 1 the curve is too steep between the first two nodes,
+	//! so values below the first node are calculated directly.
+	class GammaOutputTable {
+	public:
+		enum {
+			bits = 12,
+			shift = 16 - bits,
+			size = (1 << bits) + 1
+		};
+
+	private:
+		Gamma gamma;
+		bool valid;
+		int table[3][size];
+
+		void set(const Gamma &x) {
+			gamma = x;
+			valid = true;
+			for(int channel = 0; channel < 3; ++channel)
+				for(int i = 0; i < size; ++i) {
+					ColorReal c = gamma.apply(channel, ColorReal(i)/ColorReal(size - 1));
+					table[channel][i] = (int)(std::max(ColorReal(0), std::min(ColorReal(1), c))*ColorReal(65535.99));
+				}
+		}
+
+	public:
+		GammaOutputTable(): valid() { }
+
+		int apply(int channel, ColorReal c) const {
+			int x = (int)(c*ColorReal(65535.99));
+			if (x < (1 << shift))
+				return (int)(std::max(ColorReal(0), std::min(ColorReal(1), gamma.apply(channel, c)))*ColorReal(65535.99));
+			const int *t = table[channel] + (x >> shift);
+			return t[0] + (((t[1] - t[0])*(x & ((1 << shift) - 1))) >> shift);
+		}
+
+		//! returns the table for the \a gamma, the last used table is cached for each thread
+		static const GammaOutputTable& get(const Gamma &gamma) {
+			static thread_local GammaOutputTable cache;
+			if (!cache.valid || cache.gamma != gamma)
+				cache.set(gamma);
+			return cache;
+		}
+	};
+
+	//! Gamma correction of 8-bit input values without calls of pow()
+	class GammaInputTable {
+	private:
+		Gamma gamma;
+		bool valid;
+		ColorReal table[3][256];
+
+		void set(const Gamma &x) {
+			gamma = x;
+			valid = true;
+			const ColorReal k(1.0/255.0);
+			for(int channel = 0; channel < 3; ++channel)
+				for(int i = 0; i < 256; ++i)
+					table[channel][i] = gamma.apply(channel, k*ColorReal(i));
+		}
+
+	public:
+		GammaInputTable(): valid() { }
+
+		const Gamma& get_gamma() const { return gamma; }
+		ColorReal apply(int channel, unsigned char x) const { return table[channel][x]; }
+
+		//! returns the table for the \a gamma, the last used table is cached for each thread
+		static const GammaInputTable& get(const Gamma &gamma) {
+			static thread_local GammaInputTable cache;
+			if (!cache.valid || cache.gamma != gamma)
+				cache.set(gamma);
+			return cache;
+		}
+	};
+
+#ifdef __SSE2__
+	inline __m128 select(__m128 mask, __m128 x, __m128 y)
+		{ return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y)); }
+	inline __m128i select(__m128i mask, __m128i x, __m128i y)
+		{ return _mm_or_si128(_mm_and_si128(mask, x), _mm_andnot_si128(mask, y)); }
+	inline __m128 splat_alpha(__m128 x)
+		{ return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+	inline __m128 load(const Color *c)
+		{ return _mm_loadu_ps(reinterpret_cast<const float*>(c)); }
+	inline void store(Color *c, __m128 x)
+		{ _mm_storeu_ps(reinterpret_cast<float*>(c), x); }
+#endif
+}
+
 namespace {
 	struct Color2PFParams {
 		unsigned char *dst;
 		const Color *src;
 		PixelFormat pf;
-		const Gamma *gamma;
+		const GammaOutputTable *gamma;
 		int width;
 		int height;
 		int dst_stride_extra;
@@ -47,7 +146,7 @@ namespace {
 			unsigned char* dst = nullptr,
 			const Color* src = nullptr,
 			PixelFormat pf = 0,
-			const Gamma* gamma = nullptr,
+			const GammaOutputTable* gamma = nullptr,
 			int width = 0,
 			int height = 0,
 			int dst_stride_extra = 0,
@@ -68,7 +167,7 @@ namespace {
 	color2pf_raw(
 		unsigned char *dst,
 		const Color &src,
-		const Gamma* )
+		const GammaOutputTable* )
 	{
 		// just copy raw color data
 		*reinterpret_cast<Color*>(dst) = src;
@@ -84,7 +183,7 @@ namespace {
 	color2pf_simple(
 		unsigned char *dst,
 		const Color &src,
-		const Gamma* )
+		const GammaOutputTable* )
 	{
 		const Color color = src.clamped();
 
@@ -126,17 +225,22 @@ namespace {
 	color2pf(
 		unsigned char *dst,
 		const Color &src,
-		const Gamma *gamma )
+		const GammaOutputTable *gamma )
 	{
-		const Color src_gm = with_gamma ? gamma->apply(src) : src;
-
 		// get color values
 		int ri, gi, bi, ac;
-		ri = (int)(clamp(src_gm.get_r())*ColorReal(65535.99));
-		gi = (int)(clamp(src_gm.get_g())*ColorReal(65535.99));
-		bi = (int)(clamp(src_gm.get_b())*ColorReal(65535.99));
+		if (with_gamma) {
+			// gamma maps [0, 1] to [0, 1], so it may be applied after the clamping
+			ri = gamma->apply(0, clamp(src.get_r()));
+			gi = gamma->apply(1, clamp(src.get_g()));
+			bi = gamma->apply(2, clamp(src.get_b()));
+		} else {
+			ri = (int)(clamp(src.get_r())*ColorReal(65535.99));
+			gi = (int)(clamp(src.get_g())*ColorReal(65535.99));
+			bi = (int)(clamp(src.get_b())*ColorReal(65535.99));
+		}
 		if (alpha)
-			ac = (int)(clamp(src_gm.get_a())*ColorReal(255.99));
+			ac = (int)(clamp(src.get_a())*ColorReal(255.99));
 
 		// put alpha before color channels if need
 		if (alpha && alpha_start)
@@ -190,7 +294,7 @@ namespace {
 	}
 
 
-	template<unsigned char* func(unsigned char*, const Color&, const Gamma*)>
+	template<unsigned char* func(unsigned char*, const Color&, const GammaOutputTable*)>
 	static unsigned char*
 	color2pf_image(Color2PFParams params) {
 		while(params.height-- > 0) {
@@ -203,6 +307,118 @@ namespace {
 	}
 
 
+#ifdef __SSE2__
+	//! Converts one pixel to the integer channels in order of output,
+	//! gives the same results as color2pf_simple() and color2pf() without gamma
+	template<
+		bool bgr,
+		bool alpha_start,
+		bool alpha_premult >
+	static inline __m128i
+	color2pf_sse2_pixel(__m128 x)
+	{
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.f);
+		__m128i c;
+
+		if (alpha_premult) {
+			// NaN becomes zero, as in clamp()
+			x = _mm_min_ps(_mm_max_ps(x, zero), one);
+			__m128i ci = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set_ps(255.99f, 65535.99f, 65535.99f, 65535.99f)));
+
+			// products are less than 2^24, so the float math is exact
+			__m128 cf = _mm_cvtepi32_ps(ci);
+			__m128 af = _mm_add_ps(splat_alpha(cf), one);
+			c = _mm_cvttps_epi32(_mm_mul_ps(_mm_mul_ps(cf, af), _mm_set1_ps(1.f/65536.f)));
+			c = select(_mm_set_epi32(0, -1, -1, -1), c, ci);
+		} else {
+			// the same as Color::clamped()
+			x = select(_mm_cmpunord_ps(x, x), _mm_set_ps(1.f, .5f, .5f, .5f), x);
+			x = _mm_min_ps(_mm_max_ps(x, zero), one);
+			c = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(255.9f)));
+		}
+
+		const int order = bgr
+		                ? (alpha_start ? _MM_SHUFFLE(0, 1, 2, 3) : _MM_SHUFFLE(3, 0, 1, 2))
+		                : (alpha_start ? _MM_SHUFFLE(2, 1, 0, 3) : _MM_SHUFFLE(3, 2, 1, 0));
+		return _mm_shuffle_epi32(c, order);
+	}
+
+	template<
+		bool bgr,
+		bool alpha,
+		bool alpha_start,
+		bool alpha_premult >
+	static inline unsigned char*
+	color2pf_sse2_x4(unsigned char *dst, const Color *src)
+	{
+		__m128i c0 = color2pf_sse2_pixel<bgr, alpha_start, alpha_premult>(load(src + 0));
+		__m128i c1 = color2pf_sse2_pixel<bgr, alpha_start, alpha_premult>(load(src + 1));
+		__m128i c2 = color2pf_sse2_pixel<bgr, alpha_start, alpha_premult>(load(src + 2));
+		__m128i c3 = color2pf_sse2_pixel<bgr, alpha_start, alpha_premult>(load(src + 3));
+		__m128i bytes = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+
+		if (alpha) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), bytes);
+			return dst + 16;
+		}
+
+		// skip the unused fourth channel
+		unsigned char buffer[16];
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), bytes);
+		for(int i = 0; i < 4; ++i, dst += 3) {
+			dst[0] = buffer[4*i + 0];
+			dst[1] = buffer[4*i + 1];
+			dst[2] = buffer[4*i + 2];
+		}
+		return dst;
+	}
+
+	template<
+		bool bgr,
+		bool alpha,
+		bool alpha_start,
+		bool alpha_premult,
+		unsigned char* func(unsigned char*, const Color&, const GammaOutputTable*) >
+	static unsigned char*
+	color2pf_image_sse2(Color2PFParams params) {
+		while(params.height-- > 0) {
+			int i = 0;
+			for(; i + 4 <= params.width; i += 4, params.src += 4)
+				params.dst = color2pf_sse2_x4<bgr, alpha, alpha_start, alpha_premult>(params.dst, params.src);
+			for(; i < params.width; ++i, ++params.src)
+				params.dst = func(params.dst, *params.src, params.gamma);
+			params.dst += params.dst_stride_extra;
+			params.src += params.src_stride_extra;
+		}
+		return params.dst;
+	}
+
+	template<bool bgr, bool alpha, bool alpha_start>
+	static inline unsigned char*
+	color2pf_image_simple(const Color2PFParams &params)
+		{ return color2pf_image_sse2< bgr, alpha, alpha_start, false, color2pf_simple<bgr, alpha, alpha_start> >(params); }
+
+	template<bool with_gamma, bool gray, bool bgr, bool alpha_start>
+	static inline unsigned char*
+	color2pf_image_premult(const Color2PFParams &params) {
+		if (with_gamma || gray)
+			return color2pf_image< color2pf<with_gamma, gray, bgr, true, alpha_start, true> >(params);
+		return color2pf_image_sse2< bgr, true, alpha_start, true, color2pf<false, false, bgr, true, alpha_start, true> >(params);
+	}
+#else
+	template<bool bgr, bool alpha, bool alpha_start>
+	static inline unsigned char*
+	color2pf_image_simple(const Color2PFParams &params)
+		{ return color2pf_image< color2pf_simple<bgr, alpha, alpha_start> >(params); }
+
+	template<bool with_gamma, bool gray, bool bgr, bool alpha_start>
+	static inline unsigned char*
+	color2pf_image_premult(const Color2PFParams &params)
+		{ return color2pf_image< color2pf<with_gamma, gray, bgr, true, alpha_start, true> >(params); }
+#endif
+
+
 	template<bool with_gamma, bool gray, bool bgr>
 	static inline unsigned char*
 	color2pf_image_partauto(const Color2PFParams &params) {
@@ -210,8 +426,8 @@ namespace {
 			return     color2pf_image< color2pf<with_gamma, gray, bgr, false, false, false> >(params);
 		if (FLAGS(params.pf, PF_A_PREMULT)) {
 			if (FLAGS(params.pf, PF_A_START))
-				return color2pf_image< color2pf<with_gamma, gray, bgr, true,  true,  true>  >(params);
-			return     color2pf_image< color2pf<with_gamma, gray, bgr, true,  false, true>  >(params);
+				return color2pf_image_premult<with_gamma, gray, bgr, true>(params);
+			return     color2pf_image_premult<with_gamma, gray, bgr, false>(params);
 		}
 		if (FLAGS(params.pf, PF_A_START))
 			return     color2pf_image< color2pf<with_gamma, gray, bgr, true,  true,  false> >(params);
@@ -234,13 +450,13 @@ namespace {
 			// simple
 			bool alpha_start = alpha && FLAGS(params.pf, PF_A_START);
 			if (bgr) {
-				if (alpha_start) return color2pf_image< color2pf_simple<true,  true,  true>  >(params);
-				if (alpha)       return color2pf_image< color2pf_simple<true,  true,  false> >(params);
-				return                  color2pf_image< color2pf_simple<true,  false, false> >(params);
+				if (alpha_start) return color2pf_image_simple<true,  true,  true>  (params);
+				if (alpha)       return color2pf_image_simple<true,  true,  false> (params);
+				return                  color2pf_image_simple<true,  false, false> (params);
 			}
-			if (alpha_start) return     color2pf_image< color2pf_simple<false, true,  true>  >(params);
-			if (alpha)       return     color2pf_image< color2pf_simple<false, true,  false> >(params);
-			return                      color2pf_image< color2pf_simple<false, false, false> >(params);
+			if (alpha_start) return     color2pf_image_simple<false, true,  true>  (params);
+			if (alpha)       return     color2pf_image_simple<false, true,  false> (params);
+			return                      color2pf_image_simple<false, false, false> (params);
 		}
 
 		if (with_gamma) {
@@ -259,6 +475,7 @@ namespace {
 		Color *dst;
 		const unsigned char *src;
 		PixelFormat pf;
+		const GammaInputTable *gamma;
 		int width;
 		int height;
 		int dst_stride_extra;
@@ -268,6 +485,7 @@ namespace {
 			Color* dst = nullptr,
 			const unsigned char* src = nullptr,
 			PixelFormat pf = 0,
+			const GammaInputTable *gamma = nullptr,
 			int width = 0,
 			int height = 0,
 			int dst_stride_extra = 0,
@@ -276,6 +494,7 @@ namespace {
 			dst(dst),
 			src(src),
 			pf(pf),
+			gamma(gamma),
 			width(width),
 			height(height),
 			dst_stride_extra(dst_stride_extra),
@@ -286,7 +505,8 @@ namespace {
 	static inline const unsigned char*
 	pf2color_raw(
 		Color &dst,
-		const unsigned char *src )
+		const unsigned char *src,
+		const GammaInputTable* )
 	{
 		// just copy raw color data
 		dst = *reinterpret_cast<const Color*>(src);
@@ -295,6 +515,7 @@ namespace {
 
 
 	template<
+		bool with_gamma,
 		bool gray,
 		bool bgr,
 		bool alpha,
@@ -303,10 +524,14 @@ namespace {
 	inline const unsigned char*
 	pf2color(
 		Color &dst,
-		const unsigned char *src )
+		const unsigned char *src,
+		const GammaInputTable *gamma )
 	{
 		const ColorReal k(1.0/255.0);
 
+		// gamma of premulted colors is applied after demult
+		const bool gamma_table = with_gamma && !(alpha && alpha_premult);
+
 		if (!alpha) dst.set_a(1.0);
 
 		// read alpha at begin if need
@@ -314,34 +539,40 @@ namespace {
 
 		// read color channels
 		if (gray) {
-			dst.set_yuv(k*ColorReal(*src), 0, 0), ++src;
+			if (gamma_table)
+				dst.set_r(gamma->apply(0, *src)).set_g(gamma->apply(1, *src)).set_b(gamma->apply(2, *src)), ++src;
+			else
+				dst.set_yuv(k*ColorReal(*src), 0, 0), ++src;
 		} else
 		if (bgr) {
-			dst.set_b(k*ColorReal(*src)), ++src;
-			dst.set_g(k*ColorReal(*src)), ++src;
-			dst.set_r(k*ColorReal(*src)), ++src;
+			dst.set_b(gamma_table ? gamma->apply(2, *src) : k*ColorReal(*src)), ++src;
+			dst.set_g(gamma_table ? gamma->apply(1, *src) : k*ColorReal(*src)), ++src;
+			dst.set_r(gamma_table ? gamma->apply(0, *src) : k*ColorReal(*src)), ++src;
 		} else {
-			dst.set_r(k*ColorReal(*src)), ++src;
-			dst.set_g(k*ColorReal(*src)), ++src;
-			dst.set_b(k*ColorReal(*src)), ++src;
+			dst.set_r(gamma_table ? gamma->apply(0, *src) : k*ColorReal(*src)), ++src;
+			dst.set_g(gamma_table ? gamma->apply(1, *src) : k*ColorReal(*src)), ++src;
+			dst.set_b(gamma_table ? gamma->apply(2, *src) : k*ColorReal(*src)), ++src;
 		}
 
 		// read alpha at end if need
 		if (alpha && !alpha_start) dst.set_a(k*ColorReal(*src)), ++src;
 
 		// demult alpha
-		if (alpha && alpha_premult) dst = dst.demult_alpha();
+		if (alpha && alpha_premult) {
+			dst = dst.demult_alpha();
+			if (with_gamma) dst = gamma->get_gamma().apply(dst);
+		}
 
 		return src;
 	}
 
 
-	template<const unsigned char* func(Color&, const unsigned char*)>
+	template<const unsigned char* func(Color&, const unsigned char*, const GammaInputTable*)>
 	static const unsigned char*
 	pf2color_image(PF2ColorParams params) {
 		while(params.height-- > 0) {
 			for(int width = params.width; width > 0; --width)
-				params.src = func(*params.dst, params.src), ++params.dst;
+				params.src = func(*params.dst, params.src, params.gamma), ++params.dst;
 			params.dst += params.dst_stride_extra;
 			params.src += params.src_stride_extra;
 		}
@@ -349,30 +580,116 @@ namespace {
 	}
 
 
-	template<bool gray, bool bgr>
+#ifdef __SSE2__
+	//! Converts the four channels of pixel from integers in order of input,
+	//! gives the same results as pf2color() without gamma
+	template<
+		bool bgr,
+		bool alpha_start,
+		bool alpha_premult >
+	static inline __m128
+	pf2color_sse2_pixel(__m128i c)
+	{
+		__m128 x = _mm_mul_ps(_mm_cvtepi32_ps(c), _mm_set1_ps(ColorReal(1.0/255.0)));
+
+		const int order = bgr
+		                ? (alpha_start ? _MM_SHUFFLE(0, 1, 2, 3) : _MM_SHUFFLE(3, 0, 1, 2))
+		                : (alpha_start ? _MM_SHUFFLE(0, 3, 2, 1) : _MM_SHUFFLE(3, 2, 1, 0));
+		x = _mm_shuffle_ps(x, x, order);
+
+		if (alpha_premult) {
+			// the same as Color::demult_alpha()
+			static const Color transparent = Color::alpha();
+			__m128 a = splat_alpha(x);
+			__m128 demulted = _mm_mul_ps(x, _mm_div_ps(_mm_set1_ps(1.f), a));
+			demulted = select(_mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)), demulted, a);
+			x = select(_mm_cmpneq_ps(a, _mm_setzero_ps()), demulted, load(&transparent));
+		}
+		return x;
+	}
+
+	template<
+		bool bgr,
+		bool alpha_start,
+		bool alpha_premult >
+	static inline const unsigned char*
+	pf2color_sse2_x4(Color *dst, const unsigned char *src)
+	{
+		const __m128i zero = _mm_setzero_si128();
+		__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+		__m128i lo = _mm_unpacklo_epi8(bytes, zero);
+		__m128i hi = _mm_unpackhi_epi8(bytes, zero);
+		store(dst + 0, pf2color_sse2_pixel<bgr, alpha_start, alpha_premult>(_mm_unpacklo_epi16(lo, zero)));
+		store(dst + 1, pf2color_sse2_pixel<bgr, alpha_start, alpha_premult>(_mm_unpackhi_epi16(lo, zero)));
+		store(dst + 2, pf2color_sse2_pixel<bgr, alpha_start, alpha_premult>(_mm_unpacklo_epi16(hi, zero)));
+		store(dst + 3, pf2color_sse2_pixel<bgr, alpha_start, alpha_premult>(_mm_unpackhi_epi16(hi, zero)));
+		return src + 16;
+	}
+
+	template<
+		bool bgr,
+		bool alpha_start,
+		bool alpha_premult >
+	static const unsigned char*
+	pf2color_image_sse2(PF2ColorParams params) {
+		while(params.height-- > 0) {
+			int i = 0;
+			for(; i + 4 <= params.width; i += 4, params.dst += 4)
+				params.src = pf2color_sse2_x4<bgr, alpha_start, alpha_premult>(params.dst, params.src);
+			for(; i < params.width; ++i, ++params.dst)
+				params.src = pf2color<false, false, bgr, true, alpha_start, alpha_premult>(*params.dst, params.src, params.gamma);
+			params.dst += params.dst_stride_extra;
+			params.src += params.src_stride_extra;
+		}
+		return params.src;
+	}
+
+	template<bool with_gamma, bool gray, bool bgr, bool alpha_start, bool alpha_premult>
+	static inline const unsigned char*
+	pf2color_image_alpha(const PF2ColorParams &params) {
+		if (with_gamma || gray)
+			return pf2color_image< pf2color<with_gamma, gray, bgr, true, alpha_start, alpha_premult> >(params);
+		return pf2color_image_sse2<bgr, alpha_start, alpha_premult>(params);
+	}
+#else
+	template<bool with_gamma, bool gray, bool bgr, bool alpha_start, bool alpha_premult>
+	static inline const unsigned char*
+	pf2color_image_alpha(const PF2ColorParams &params)
+		{ return pf2color_image< pf2color<with_gamma, gray, bgr, true, alpha_start, alpha_premult> >(params); }
+#endif
+
+
+	template<bool with_gamma, bool gray, bool bgr>
 	static inline const unsigned char*
 	pf2color_image_partauto(const PF2ColorParams &params) {
 		if (!FLAGS(params.pf, PF_A))
-			return     pf2color_image< pf2color<gray, bgr, false, false, false> >(params);
+			return     pf2color_image< pf2color<with_gamma, gray, bgr, false, false, false> >(params);
 		if (FLAGS(params.pf, PF_A_PREMULT)) {
 			if (FLAGS(params.pf, PF_A_START))
-				return pf2color_image< pf2color<gray, bgr, true,  true,  true>  >(params);
-			return     pf2color_image< pf2color<gray, bgr, true,  false, true>  >(params);
+				return pf2color_image_alpha<with_gamma, gray, bgr, true,  true>  (params);
+			return     pf2color_image_alpha<with_gamma, gray, bgr, false, true>  (params);
 		}
 		if (FLAGS(params.pf, PF_A_START))
-			return     pf2color_image< pf2color<gray, bgr, true,  true,  false> >(params);
-		return         pf2color_image< pf2color<gray, bgr, true,  false, false> >(params);
+			return     pf2color_image_alpha<with_gamma, gray, bgr, true,  false> (params);
+		return         pf2color_image_alpha<with_gamma, gray, bgr, false, false> (params);
 	}
 
 	static inline const unsigned char*
 	pf2color_image_auto(const PF2ColorParams &params) {
 		if (FLAGS(params.pf, PF_RAW_COLOR))
 			return pf2color_image<pf2color_raw>(params);
+		if (params.gamma) {
+			if (FLAGS(params.pf, PF_GRAY))
+				return pf2color_image_partauto<true,  true,  false>(params);
+			if (FLAGS(params.pf, PF_BGR))
+				return pf2color_image_partauto<true,  false, true >(params);
+			return     pf2color_image_partauto<true,  false, false>(params);
+		}
 		if (FLAGS(params.pf, PF_GRAY))
-			return pf2color_image_partauto<true,  false>(params);
+			return pf2color_image_partauto<false, true,  false>(params);
 		if (FLAGS(params.pf, PF_BGR))
-			return pf2color_image_partauto<false, true >(params);
-		return     pf2color_image_partauto<false, false>(params);
+			return pf2color_image_partauto<false, false, true >(params);
+		return     pf2color_image_partauto<false, false, false>(params);
 	}
 };
 
@@ -402,7 +719,7 @@ synfig::color_to_pixelformat(
 {
 	assert(src_stride % sizeof(Color) == 0);
 	return color2pf_image_auto(Color2PFParams(
-		dst, src, pf, gamma, width, height,
+		dst, src, pf, gamma ? &GammaOutputTable::get(*gamma) : nullptr, width, height,
 		dst_stride ? dst_stride - width*pixel_size(pf) : 0,
 		src_stride ? src_stride/sizeof(Color) - width  : 0 ));
 }
@@ -413,6 +730,7 @@ synfig::pixelformat_to_color(
 	Color *dst,
 	const unsigned char *src,
 	PixelFormat pf,
+	const Gamma *gamma,
 	int width,
 	int height,
 	int dst_stride,
@@ -420,8 +738,7 @@ synfig::pixelformat_to_color(
 {
 	assert(dst_stride % sizeof(Color) == 0);
 	return pf2color_image_auto(PF2ColorParams(
-		dst, src, pf, width, height,
+		dst, src, pf, gamma ? &GammaInputTable::get(*gamma) : nullptr, width, height,
 		dst_stride ? dst_stride/sizeof(Color) - width  : 0,
 		src_stride ? src_stride - width*pixel_size(pf) : 0 ));
-	assert(src_stride % sizeof(Color) == 0);
 }
@@ -84,11 +84,13 @@ color_to_pixelformat(
 //! dst_stride and src_stride - offset to next row in bytes (may be negative)
 //! if stride is zero, then stride assumed to be equal width*sizeof(the_pixel_type)
 //! dst_stride must be evenly divisible by the sizeof(synfig::Color)
+//! if gamma is set, then it applies to the decoded color channels
 const unsigned char*
 pixelformat_to_color(
 	Color *dst,
 	const unsigned char *src,
 	PixelFormat pf,
+	const Gamma* gamma = nullptr,
 	int width = 1,
 	int height = 1,
 	int dst_stride = 0,
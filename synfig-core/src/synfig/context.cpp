@@ -96,6 +96,9 @@ _print_profile_report()
 void
 IndependentContext::set_time(Time time, bool force)const
 {
+	// shared value nodes are evaluated once for all layers
+	ValueNodeEvaluationPass evaluation_pass;
+
 	IndependentContext context(*this);
 	while(*context)
 	{
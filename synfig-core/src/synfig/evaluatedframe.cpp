@@ -0,0 +1,310 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file evaluatedframe.cpp
+**	\brief EvaluatedFrame File
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include <sigc++/bind.h>
+
+#include "evaluatedframe.h"
+
+#include "general.h"
+#include "localization.h"
+#include "progresscallback.h"
+#include "threadpool.h"
+#include "rendering/renderer.h"
+#include "rendering/surface.h"
+#include "rendering/common/task/tasktransformation.h"
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+namespace {
+	// value nodes and importers are shared between all copies of the document
+	std::mutex evaluation_mutex;
+}
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+EvaluatedFrame::EvaluatedFrame(const Canvas &canvas, Time time, Real outline_grow):
+	time(time),
+	outline_grow(outline_grow),
+	evaluated(false),
+	time_dependent(false)
+{
+	// copying evaluates animated canvas parameters
+	std::lock_guard<std::mutex> lock(evaluation_mutex);
+	this->canvas = canvas.clone_for_time(time, &time_dependent);
+}
+
+EvaluatedFrame::~EvaluatedFrame()
+{
+	// layers of the copy disconnect from the shared value nodes
+	std::lock_guard<std::mutex> lock(evaluation_mutex);
+	canvas.reset();
+}
+
+bool
+EvaluatedFrame::set_time(Time time)
+{
+	if (this->time == time) return true;
+	if (time_dependent) return false;
+	this->time = time;
+	evaluated = false;
+	return true;
+}
+
+void
+EvaluatedFrame::evaluate()
+{
+	if (evaluated) return;
+	std::lock_guard<std::mutex> lock(evaluation_mutex);
+	canvas->set_time(time);
+	canvas->load_resources(time);
+	canvas->set_outline_grow(outline_grow);
+	evaluated = true;
+}
+
+Task::Handle
+EvaluatedFrame::build_rendering_task(const ContextParams &context_params)
+{
+	evaluate();
+	std::lock_guard<std::mutex> lock(evaluation_mutex);
+	return canvas->build_rendering_task(context_params);
+}
+
+Task::Handle
+EvaluatedFrame::build_rendering_task(
+	Canvas &canvas,
+	const ContextParams &context_params,
+	const RendDesc &renddesc,
+	const SurfaceResource::Handle &surface )
+{
+	surface->create(renddesc.get_w(), renddesc.get_h());
+	Task::Handle task = canvas.build_rendering_task(context_params);
+
+	if (task)
+	{
+		Vector p0 = renddesc.get_tl();
+		Vector p1 = renddesc.get_br();
+		if (p0[0] > p1[0] || p0[1] > p1[1]) {
+			Matrix m;
+			if (p0[0] > p1[0]) { m.m00 = -1.0; m.m20 = p0[0] + p1[0]; std::swap(p0[0], p1[0]); }
+			if (p0[1] > p1[1]) { m.m11 = -1.0; m.m21 = p0[1] + p1[1]; std::swap(p0[1], p1[1]); }
+			TaskTransformationAffine::Handle t = new TaskTransformationAffine();
+			t->transformation->matrix = m;
+			t->sub_task() = task;
+			task = t;
+		}
+
+		task->target_surface = surface;
+		task->target_rect = RectInt( VectorInt(), surface->get_size() );
+		task->source_rect = Rect(p0, p1);
+	}
+	return task;
+}
+
+void
+EvaluatedFrame::prepare(
+	EvaluatedFrame *frame,
+	const ContextParams &context_params,
+	const RendDesc &renddesc,
+	const SurfaceResource::Handle &surface,
+	const Renderer::Handle &renderer,
+	const TaskEvent::Handle &event,
+	const TaskEvent::Handle &prepared )
+{
+	if (!event->is_finished()) {
+		try {
+			frame->evaluate();
+			Task::List list;
+			{
+				std::lock_guard<std::mutex> lock(evaluation_mutex);
+				if (Task::Handle task = build_rendering_task(*frame->get_canvas(), context_params, renddesc, surface))
+					list.push_back(task);
+			}
+			renderer->enqueue(list, event);
+		} catch(...) {
+			synfig::error("EvaluatedFrame: cannot prepare frame at time %s", frame->get_time().get_string().c_str());
+			event->finish(false);
+		}
+	}
+	prepared->finish(true);
+}
+
+bool
+EvaluatedFrame::render_frames(
+	Canvas &canvas,
+	const ContextParams &context_params,
+	const RendDesc &renddesc,
+	const Renderer::Handle &renderer,
+	int parallel_frames,
+	int total_frames,
+	const NextFrameSlot &next_frame,
+	const PutFrameSlot &put_frame,
+	ProgressCallback *cb )
+{
+	// Every frame gets its own copy of the layer tree,
+	// so the frame is evaluated and rendered in background
+	// while the calling thread goes to the next frame.
+	// Evaluation of the copies is serialized by evaluation_mutex,
+	// only the rendering tasks of several frames run at once.
+	struct PendingFrame {
+		Handle state;
+		SurfaceResource::Handle surface;
+		TaskEvent::Handle event;
+		TaskEvent::Handle prepared;
+		int frame;
+	};
+
+	std::deque<PendingFrame> pending;
+	std::vector<Handle> free_states;
+	int frames = 0;
+	Time t = 0;
+	bool success = true;
+	bool sequential = false;
+
+	// puts the first pending frame onto the target
+	auto put_pending = [&]() -> bool {
+		PendingFrame &front = pending.front();
+		front.event->wait();
+		if (!front.event->is_done()) {
+			if (cb) cb->error(_("Accelerated Renderer Failure"));
+			return false;
+		}
+
+		if (!put_frame(front.surface, front.frame))
+			return false;
+
+		front.prepared->wait();
+		free_states.push_back(front.state);
+		pending.pop_front();
+		return true;
+	};
+
+	// the exception is rethrown when all the frames in flight are finished,
+	// they refer to the frame states owned by this function
+	std::exception_ptr error;
+	try {
+		do {
+			// Grab the time
+			int frame_index = 0;
+			frames = next_frame(t, frame_index);
+
+			// If we have a callback, and it returns
+			// false, go ahead and bail. (it may be a user cancel)
+			if (cb && !cb->amount_complete(total_frames-frames, total_frames))
+				{ success = false; break; }
+
+			// Copy the layer tree or reuse the copy of already finished frame,
+			// the copy is owned by the calling thread, worker gets only the pointer
+			// (see prepare())
+			PendingFrame frame;
+			if (!sequential) {
+				if (!free_states.empty()) {
+					frame.state = free_states.back();
+					free_states.pop_back();
+				}
+				if (!frame.state || !frame.state->set_time(t))
+					frame.state = new EvaluatedFrame(canvas, t, renddesc.get_outline_grow());
+				if (!frame.state->get_canvas()) {
+					synfig::warning("EvaluatedFrame: cannot copy the layers at time %s, frames will be rendered one by one",
+						t.get_string().c_str());
+					sequential = true;
+				}
+			}
+
+			if (sequential) {
+				// frames in flight share value nodes with the document,
+				// so they are finished before the document is evaluated
+				while (success && !pending.empty())
+					success = put_pending();
+				if (!success) break;
+				free_states.clear();
+
+				SurfaceResource::Handle surface = new SurfaceResource();
+				canvas.set_time(t);
+				canvas.load_resources(t);
+				canvas.set_outline_grow(renddesc.get_outline_grow());
+				if (Task::Handle task = build_rendering_task(canvas, context_params, renddesc, surface)) {
+					Task::List list;
+					list.push_back(task);
+					renderer->run(list);
+				}
+				success = put_frame(surface, frame_index);
+				continue;
+			}
+
+			frame.surface = new SurfaceResource();
+			frame.event = new TaskEvent();
+			frame.prepared = new TaskEvent();
+			frame.frame = frame_index;
+
+			ThreadPool::instance().enqueue( sigc::bind(
+				sigc::ptr_fun(&EvaluatedFrame::prepare),
+				frame.state.get(), context_params, renddesc, frame.surface, renderer, frame.event, frame.prepared ));
+			pending.push_back(frame);
+
+			// Put finished frames onto the target in order,
+			// wait only when all allowed frames are in flight
+			while (success && !pending.empty() && (frames == 0 || (int)pending.size() >= parallel_frames || pending.front().event->is_finished()))
+				success = put_pending();
+		} while(success && frames);
+	} catch(...) {
+		error = std::current_exception();
+		success = false;
+	}
+
+	// cancel and wait frames which will not be added
+	for(std::deque<PendingFrame>::iterator i = pending.begin(); i != pending.end(); ++i)
+		{ i->prepared->wait(); Renderer::cancel(i->event); i->event->wait(); }
+
+	if (error)
+		std::rethrow_exception(error);
+	return success;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,156 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file evaluatedframe.h
+**	\brief EvaluatedFrame Header
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_EVALUATEDFRAME_H
+#define __SYNFIG_EVALUATEDFRAME_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <ETL/handle>
+
+#include <sigc++/signal.h>
+
+#include "canvas.h"
+#include "context.h"
+#include "time.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig {
+
+class ProgressCallback;
+
+namespace rendering { class Renderer; class SurfaceResource; class TaskEvent; }
+
+/*!	\class EvaluatedFrame
+**	\brief State of the document at the single time, separated from the layers of the document.
+**
+**	It's used for parallel rendering of pre-evaluated frames: the frames are evaluated
+**	one at a time, and only rendering of their tasks overlaps.
+**
+**	Constructor makes a private copy of the layer tree (see Canvas::clone_for_time()),
+**	it must be called from the thread which owns the document.
+**	evaluate() sets the copy to the time of the frame, then the layers of the frame
+**	are not changed until the next evaluation, so the rendering tasks of several
+**	frames of the same canvas may be rendered simultaneously.
+**
+**	The copy is not independent: copied layers share value nodes with the document
+**	and copied canvases refer to the parent canvases of the document.
+**	Value nodes keep mutable state and are not thread-safe, so all the code which
+**	evaluates them (evaluate() and building of the rendering task, which calls
+**	Context::set_time() for some layers, like Layer_Duplicate) is serialized by
+**	the single global lock. Only rendering of the tasks runs in parallel.
+**
+**	Copying the layer tree is expensive, so the frame may be moved to another time
+**	by set_time() and reused, unless the copy depends on the time.
+**	When the layer tree cannot be copied, get_canvas() returns null handle
+**	and the frame must not be evaluated.
+*/
+class EvaluatedFrame: public etl::shared_object
+{
+public:
+	typedef etl::handle<EvaluatedFrame> Handle;
+
+	//! Gets the time and the index of the next frame,
+	//! returns the number of frames left including this one, zero when there are no more frames
+	typedef sigc::slot<int, Time&, int&> NextFrameSlot;
+	//! Puts the rendered frame with the given index onto the target
+	typedef sigc::slot<bool, const etl::handle<rendering::SurfaceResource>&, int> PutFrameSlot;
+
+private:
+	Canvas::Handle canvas;
+	Time time;
+	Real outline_grow;
+	bool evaluated;
+	bool time_dependent;
+
+public:
+	EvaluatedFrame(const Canvas &canvas, Time time, Real outline_grow = 0.0);
+	~EvaluatedFrame();
+
+	const Canvas::Handle& get_canvas() const { return canvas; }
+	Time get_time() const { return time; }
+	bool is_evaluated() const { return evaluated; }
+
+	//! Moves the frame to another time, it will be evaluated again.
+	//! Must not be called while the frame is evaluated or rendered.
+	//! \return \c false when the copy is valid only at its current time
+	//! (it has animated canvas parameters), then a new frame should be made
+	bool set_time(Time time);
+
+	//! Sets the private copy of the canvas to the time of the frame and loads resources
+	void evaluate();
+
+	//! Builds rendering task for the frame, evaluates it when it's not evaluated yet
+	rendering::Task::Handle build_rendering_task(const ContextParams &context_params);
+
+	//! Builds the task which renders \a canvas with area and size of \a renddesc into \a surface.
+	//! The \a surface is created with the size of \a renddesc.
+	static rendering::Task::Handle build_rendering_task(
+		Canvas &canvas,
+		const ContextParams &context_params,
+		const RendDesc &renddesc,
+		const etl::handle<rendering::SurfaceResource> &surface );
+
+	//! Evaluates the frame and enqueues its rendering into \a renderer, called from ThreadPool.
+	//! Event \a prepared is finished when the function does not touch the frame anymore.
+	static void prepare(
+		EvaluatedFrame *frame,
+		const ContextParams &context_params,
+		const RendDesc &renddesc,
+		const etl::handle<rendering::SurfaceResource> &surface,
+		const etl::handle<rendering::Renderer> &renderer,
+		const etl::handle<rendering::TaskEvent> &event,
+		const etl::handle<rendering::TaskEvent> &prepared );
+
+	//! Renders the frames given by \a next_frame, up to \a parallel_frames frames at once.
+	//! Evaluation and building of the rendering tasks are serialized (see the class description),
+	//! so only rendering of the tasks runs in parallel.
+	//! Frames are passed to \a put_frame in order, on the calling thread.
+	//! When the layer tree cannot be copied, the rest of frames is rendered
+	//! one by one from the \a canvas itself, like the targets do without parallel frames.
+	static bool render_frames(
+		Canvas &canvas,
+		const ContextParams &context_params,
+		const RendDesc &renddesc,
+		const etl::handle<rendering::Renderer> &renderer,
+		int parallel_frames,
+		int total_frames,
+		const NextFrameSlot &next_frame,
+		const PutFrameSlot &put_frame,
+		ProgressCallback *cb );
+}; // END of class EvaluatedFrame
+
+}; // END of namespace synfig
+
+/* === E N D =============================================================== */
+
+#endif
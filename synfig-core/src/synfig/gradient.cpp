@@ -37,8 +37,13 @@
 #include "gradient.h"
 
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #include "general.h"
 #include <synfig/localization.h>
 #include <synfig/real.h>
@@ -57,6 +62,58 @@ using namespace synfig;
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+typedef CompiledGradient::Accumulator Accumulator;
+typedef CompiledGradient::Entry Entry;
+
+#ifdef __SSE2__
+// Accumulator in two SSE2 registers: (r, g) and (b, a),
+// operations are the same as in Accumulator, so results are equal
+class SpanAccumulator {
+public:
+	__m128d rg, ba;
+
+	SpanAccumulator() { }
+	SpanAccumulator(__m128d rg, __m128d ba): rg(rg), ba(ba) { }
+	explicit SpanAccumulator(const Accumulator &x):
+		rg(_mm_loadu_pd(&x.values[0])), ba(_mm_loadu_pd(&x.values[2])) { }
+
+	SpanAccumulator operator+ (const SpanAccumulator &x) const
+		{ return SpanAccumulator(_mm_add_pd(rg, x.rg), _mm_add_pd(ba, x.ba)); }
+	SpanAccumulator operator- (const SpanAccumulator &x) const
+		{ return SpanAccumulator(_mm_sub_pd(rg, x.rg), _mm_sub_pd(ba, x.ba)); }
+	SpanAccumulator operator* (Real x) const {
+		__m128d k = _mm_set1_pd(x);
+		return SpanAccumulator(_mm_mul_pd(rg, k), _mm_mul_pd(ba, k));
+	}
+
+	Color color() const
+	{
+		// demult alpha
+		Real a = _mm_cvtsd_f64(_mm_unpackhi_pd(ba, ba));
+		if (approximate_equal_lp(a, Real(0))) return Color();
+		__m128d k = _mm_set1_pd(1.0/a);
+		float c[4];
+		_mm_storeu_ps(c, _mm_movelh_ps(_mm_cvtpd_ps(_mm_mul_pd(rg, k)), _mm_cvtpd_ps(_mm_mul_pd(ba, k))));
+		return Color(c[0], c[1], c[2], (ColorReal)a);
+	}
+};
+#else
+typedef Accumulator SpanAccumulator;
+#endif
+
+inline SpanAccumulator
+entry_summary(const Entry &e, Real x)
+{
+	if (x >= e.next_pos) return SpanAccumulator(e.next_sum) + SpanAccumulator(e.next_color)*(x - e.next_pos);
+	if (x <= e.prev_pos) return SpanAccumulator(e.prev_sum) + SpanAccumulator(e.prev_color)*(x - e.prev_pos);
+	x -= e.prev_pos;
+	return SpanAccumulator(e.prev_sum) + SpanAccumulator(e.prev_color)*x + SpanAccumulator(e.prev_k2)*(x*x);
+}
+
+} // end of anonymous namespace
+
 /* === M E T H O D S ======================================================= */
 
 Gradient::Gradient(const Color &c1, const Color &c2)
@@ -348,3 +405,33 @@ CompiledGradient::set(const Gradient &gradient, bool repeat, bool zigzag) {
 	
 	summary_color = find(1.0)->summary(1.0);
 }
+
+void
+CompiledGradient::average(Color *dst, const Real *x0, const Real *x1, int count) const
+{
+	const SpanAccumulator summary_span(summary_color);
+	List::const_iterator hint0 = list.begin(), hint1 = list.begin();
+	for(Color *end = dst + count; dst != end; ++dst, ++x0, ++x1) {
+		Real w = *x1 - *x0;
+		if (std::isnan(w) || std::isinf(w) || fabs(w) < real_precision<Real>())
+			{ *dst = average(*x0, *x1); continue; }
+
+		Real a = *x0, b = *x1;
+		SpanAccumulator sa, sb;
+		if (repeat) {
+			Real count_a = floor(a), count_b = floor(b);
+			a -= count_a;
+			b -= count_b;
+			hint0 = find(a, hint0);
+			hint1 = find(b, hint1);
+			sa = summary_span*count_a + entry_summary(*hint0, a);
+			sb = summary_span*count_b + entry_summary(*hint1, b);
+		} else {
+			hint0 = find(a, hint0);
+			hint1 = find(b, hint1);
+			sa = entry_summary(*hint0, a);
+			sb = entry_summary(*hint1, b);
+		}
+		*dst = ((sb - sa)*(1.0/w)).color();
+	}
+}
@@ -261,6 +261,15 @@ public:
 	inline List::const_iterator find(Real x) const
 		{ return std::lower_bound(list.begin(), list.end()-1, x); }
 
+	//! Same as find(x), but checks the \a hint first,
+	//! it's fast when the neighbour positions are searched one after another
+	inline List::const_iterator find(Real x, List::const_iterator hint) const {
+		if ( (hint + 1 == list.end() || !(*hint < x))
+		  && (hint == list.begin() || *(hint - 1) < x) )
+			return hint;
+		return find(x);
+	}
+
 	inline Color color(Real x) const {
 		if (repeat) x -= floor(x);
 		return find(x)->color(x);
@@ -288,6 +297,10 @@ public:
 		if (fabs(w) < real_precision<Real>()) return color(x0);
 		return ((summary(x1) - summary(x0))/w).color();
 	}
+
+	//! Calculates average(x0[i], x1[i]) for \a count ranges and writes colors into \a dst.
+	//! Faster than separate calls when the neighbour ranges are close
+	void average(Color *dst, const Real *x0, const Real *x1, int count) const;
 };
 
 }; // END of namespace synfig
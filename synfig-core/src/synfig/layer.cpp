@@ -49,6 +49,7 @@
 #include "surface.h"
 #include "paramdesc.h"
 #include "transform.h"
+#include "valuenode_program.h"
 
 #include "layers/layer_composite.h"
 #include "layers/layer_duplicate.h"
@@ -323,6 +324,7 @@ Layer::connect_dynamic_param(const String& param, ValueNode::LooseHandle value_n
 		return true;
 
 	dynamic_param_list_[param]=ValueNode::Handle(value_node);
+	dynamic_param_programs_.erase(param);
 
 	if (previous)
 	{
@@ -356,6 +358,7 @@ Layer::disconnect_dynamic_param(const String& param)
 
 	ValueNode::Handle previous(i->second);
 	dynamic_param_list_.erase(i);
+	dynamic_param_programs_.erase(param);
 
 	if(previous)
 	{
@@ -414,6 +417,15 @@ Layer::get_transform()const
 	return 0;
 }
 
+bool
+Layer::is_time_invariant()const
+{
+	for(DynamicParamList::const_iterator i = dynamic_param_list().begin(); i != dynamic_param_list().end(); ++i)
+		if (!i->second || !i->second->is_time_invariant())
+			return false;
+	return true;
+}
+
 float
 Layer::get_z_depth(const synfig::Time& t)const
 {
@@ -453,6 +465,21 @@ Layer::simple_clone()const
 	return ret;
 }
 
+Layer::Handle
+Layer::clone_for_rendering()const
+{
+	if(!book().count(get_name())) return 0;
+	Handle ret = create(get_name()).get();
+	// set_canvas() would connect to the signals of the shared canvas
+	ret->canvas_=canvas_;
+	ret->set_active(active());
+	ret->set_exclude_from_rendering(get_exclude_from_rendering());
+	ret->set_param_list(get_param_list());
+	ret->set_time_mark(get_time_mark());
+	ret->set_outline_grow_mark(get_outline_grow_mark());
+	return ret;
+}
+
 Layer::Handle
 Layer::clone(Canvas::LooseHandle canvas, const GUID& deriv_guid) const
 {
@@ -611,7 +638,7 @@ Layer::set_time(IndependentContext context, Time time)
 	Layer::DynamicParamList::const_iterator iter;
 	// For each parameter of the layer sets the value by the operator()(time)
 	for (iter = dynamic_param_list().begin(); iter != dynamic_param_list().end(); ++iter)
-		params[iter->first]=(*iter->second)(time);
+		params[iter->first]=evaluate_dynamic_param(iter->first, iter->second, time);
 	// Sets the modified parameter list to the current context layer
 	const_cast<Layer*>(this)->set_param_list(params);
 
@@ -620,6 +647,27 @@ Layer::set_time(IndependentContext context, Time time)
 	set_time_vfunc(context, time);
 }
 
+ValueBase
+Layer::evaluate_dynamic_param(const String &param, const ValueNode::Handle &value_node, Time time)
+{
+	// arithmetic graphs of rigs are evaluated as a flat list of instructions
+	std::map<String, std::shared_ptr<ValueNodeProgram> >::iterator i = dynamic_param_programs_.find(param);
+	if (i == dynamic_param_programs_.end())
+	{
+		std::shared_ptr<ValueNodeProgram> program;
+		if (ValueNodeProgram::get_kind(value_node->get_type()) != ValueNodeProgram::KIND_NONE)
+		{
+			program.reset(new ValueNodeProgram(value_node));
+			program->compile();
+			// program of the single node would only call the node
+			if (program->get_load_count() == (int)program->get_instructions().size())
+				program.reset();
+		}
+		i = dynamic_param_programs_.insert(std::make_pair(param, program)).first;
+	}
+	return i->second ? (*i->second)(time) : (*value_node)(time);
+}
+
 void
 Layer::load_resources(IndependentContext context, Time time)const
 {
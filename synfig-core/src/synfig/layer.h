@@ -33,6 +33,7 @@
 /* === H E A D E R S ======================================================= */
 
 #include <map>
+#include <memory>
 
 #include <ETL/handle>
 
@@ -187,6 +188,7 @@ class SoundProcessor;
 class Surface;
 class Transform;
 class ValueNode;
+class ValueNodeProgram;
 
 
 /*!	\class Layer
@@ -294,6 +296,11 @@ private:
 	//! Map of parameter with animated value nodes
 	DynamicParamList dynamic_param_list_;
 
+	//! Flattened graphs of arithmetic dynamic parameters, built by set_time(),
+	//! null when the graph of the parameter has nothing to flatten
+	//! \see ValueNodeProgram
+	std::map<String, std::shared_ptr<ValueNodeProgram> > dynamic_param_programs_;
+
 	//! A description of what this layer does
 	String description_;
 
@@ -559,6 +566,18 @@ public:
 	void set_outline_grow_mark(Real outline_grow) { outline_grow_mark_ = outline_grow; }
 	void clear_outline_grow_mark() { outline_grow_mark_ = 0.0; }
 
+	//! Returns \c true if the layer renders the same at any time.
+	//! By default checks that all dynamic parameters are time-invariant,
+	//! layers which use time directly should override it.
+	//! \see ValueNode::is_time_invariant(), CanvasTaskCache
+	virtual bool is_time_invariant()const;
+
+	//! Returns \c true if the layer sets the other time to its context
+	//! than its own time (time loop, motion blur etc.), so a change of
+	//! the layers under it affects unknown frames.
+	//! \see Node::get_child_changed_time()
+	virtual bool changes_context_time()const { return false; }
+
 	//! Sets the \a time for the Layer and those under it
 	/*!	\param context		Context iterator referring to next Layer.
 	**	\param time			writeme
@@ -566,6 +585,11 @@ public:
 	*/
 	void set_time(IndependentContext context, Time time);
 	
+private:
+	//! Returns the value of the dynamic parameter at \a time, through its program when it has one
+	ValueBase evaluate_dynamic_param(const String &param, const etl::handle<ValueNode> &value_node, Time time);
+
+public:
 	//! Loads external resources (frames) for the Layer recursively
 	/*!	\param context		Context iterator referring to next Layer.
 	**	\param time			writeme
@@ -641,9 +665,24 @@ public:
 	**  context until the final blend operation. */
 	virtual bool reads_context()const;
 
+	//! Returns true if accelerated_render() and get_color() may be called
+	//! simultaneously from several threads for the different parts of a frame.
+	/*! Legacy layers are rendered by the pieces of split rendering task,
+	**  each piece renders its own clone of the layer unless the layer is
+	**  thread-safe. Layers which only read their parameters while
+	**  rendering (no caches or other mutable state) should return true. */
+	virtual bool is_render_thread_safe()const { return false; }
+
 	//! Duplicates the Layer without duplicating the value nodes
 	virtual Handle simple_clone()const;
 
+	//! Makes a flat copy of the Layer for rendering in other thread.
+	/*! The copy has the current values of the parameters, the same canvas
+	**  and time mark, but no value nodes, so nothing shared with the document
+	**  is modified. The copy is not connected to the signals of the canvas,
+	**  it must not outlive the rendering task which holds it. */
+	Handle clone_for_rendering()const;
+
 	//! Connects the parameter to another Value Node
 	virtual bool connect_dynamic_param(const String& param, etl::loose_handle<ValueNode>);
 
@@ -122,7 +122,7 @@ Layer_Duplicate::get_color(Context context, const Point &pos)const
 	float amount(get_amount());
 	Color color;
 
-	std::lock_guard<std::mutex> lock(mutex);
+	std::lock_guard<std::mutex> lock(duplicate_param->get_mutex());
 	Time time_cur = get_time_mark();
 	duplicate_param->reset_index(time_cur);
 	do
@@ -173,7 +173,7 @@ Layer_Duplicate::build_rendering_task_vfunc(Context context) const
 
 	rendering::Task::Handle task;
 
-	std::lock_guard<std::mutex> lock(mutex);
+	std::lock_guard<std::mutex> lock(duplicate_param->get_mutex());
 	duplicate_param->reset_index(time_cur);
 	ContextParams dup_context_params(context.get_params());
 	dup_context_params.force_set_time = true;
@@ -45,7 +45,6 @@ class Layer_Duplicate : public synfig::Layer_CompositeFork
 
 private:
 	mutable ValueBase param_index;
-	mutable std::mutex mutex;
 
 public:
 
@@ -58,6 +57,7 @@ public:
 	virtual Color get_color(Context context, const Point &pos)const;
 	virtual ValueNode_Duplicate::Handle get_duplicate_param()const;
 	virtual Vocab get_param_vocab()const;
+	virtual bool is_time_invariant()const { return false; }
 	virtual bool reads_context()const { return true; }
 
 protected:
@@ -64,6 +64,9 @@ public:
 	virtual ValueBase get_param(const String & param)const;
 	virtual Color get_color(Context context, const Point &pos)const;
 	virtual Vocab get_param_vocab()const;
+	//! Renders the context at different times
+	virtual bool is_time_invariant()const { return false; }
+	virtual bool changes_context_time()const { return true; }
 	virtual bool reads_context()const { return true; }
 
 protected:
@@ -49,6 +49,7 @@
 #include <synfig/valuenode.h>
 
 #include <synfig/rendering/common/task/taskblend.h>
+#include <synfig/rendering/common/task/taskcache.h>
 #include <synfig/rendering/common/task/tasktransformation.h>
 #include <synfig/rendering/common/task/taskpixelprocessor.h>
 #include <synfig/rendering/primitive/transformationaffine.h>
@@ -334,6 +335,20 @@ Layer_PasteCanvas::load_resources_vfunc(IndependentContext context, Time time)co
 	sub_canvas->load_resources(time*time_dilation + time_offset);
 }
 
+bool
+Layer_PasteCanvas::is_time_invariant()const
+{
+	if (!Layer_Composite::is_time_invariant())
+		return false;
+	if (!sub_canvas)
+		return true;
+	if (depth == MAX_DEPTH)
+		return false;
+	depth_counter counter(depth);
+
+	return sub_canvas->is_time_invariant();
+}
+
 void
 Layer_PasteCanvas::set_outline_grow_vfunc(IndependentContext context, Real outline_grow)
 {
@@ -466,6 +481,24 @@ Layer_PasteCanvas::get_times_vfunc(Node::time_set &set) const
 	Layer::get_times_vfunc(set);
 }
 
+void
+Layer_PasteCanvas::get_child_changed_time(const Node *x, Time &begin, Time &end)const
+{
+	Layer_Composite::get_child_changed_time(x, begin, end);
+	if (!sub_canvas || x != sub_canvas.get())
+		return;
+
+	Real time_dilation = param_time_dilation.get(Real());
+	Time time_offset = param_time_offset.get(Time());
+	if ( dynamic_param_list().count("time_dilation")
+	  || dynamic_param_list().count("time_offset")
+	  || !approximate_greater(time_dilation, Real(0)) )
+		{ begin = Time::begin(); end = Time::end(); return; }
+
+	if (begin != Time::begin()) begin = (begin - time_offset)/time_dilation;
+	if (end != Time::end()) end = (end - time_offset)/time_dilation;
+}
+
 void
 Layer_PasteCanvas::fill_sound_processor(SoundProcessor &soundProcessor) const
 {
@@ -483,7 +516,15 @@ Layer_PasteCanvas::build_rendering_task_vfunc(Context context)const
 
 		rendering::TaskTransformationAffine::Handle task_transformation(new rendering::TaskTransformationAffine());
 		task_transformation->transformation->matrix = get_summary_transformation().get_matrix();
-		task_transformation->sub_task() = sub_context.build_rendering_task();
+		String fingerprint;
+		task_transformation->sub_task() = sub_canvas->build_rendering_task_cached(sub_context, &fingerprint);
+		if (!fingerprint.empty() && task_transformation->sub_task()) {
+			// the same contents are rendered every frame, let renderer take them from the surface cache
+			rendering::TaskCache::Handle task_cache(new rendering::TaskCache());
+			task_cache->key = fingerprint;
+			task_cache->sub_task() = task_transformation->sub_task();
+			task_transformation->sub_task() = task_cache;
+		}
 		sub_task = task_transformation;
 		
 		if (sub_canvas->get_root() != get_canvas()->get_root()) {
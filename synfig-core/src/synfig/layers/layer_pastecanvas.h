@@ -187,6 +187,9 @@ public:
 
 	virtual void fill_sound_processor(SoundProcessor &soundProcessor) const;
 
+	//! Paste Canvas Layer is time-invariant when its parameters and all layers of its canvas are
+	virtual bool is_time_invariant()const;
+
 	virtual void on_childs_changed() { }
 
 protected:
@@ -203,6 +206,8 @@ protected:
 	//! are the canvas parameter children layers Time points and the Paste Canvas
 	//! Layer time points. \todo clarify all this comments.
 	virtual void get_times_vfunc(Node::time_set &set) const;
+	//! Converts the changed time interval of the canvas to the time of the layer
+	virtual void get_child_changed_time(const Node *x, Time &begin, Time &end)const;
 
 	virtual rendering::Task::Handle build_rendering_task_vfunc(Context context)const;
 }; // END of class Layer_PasteCanvas
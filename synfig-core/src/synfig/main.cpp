@@ -274,9 +274,19 @@ synfig::Main::Main(const synfig::String& rootpath,ProgressCallback *cb):
 		throw std::runtime_error(_("Unable to initialize subsystem \"Types\""));
 	}
 
+	// rendering threads are run by the thread pool
+	if(cb)cb->task(_("Starting Subsystem \"Thread Pool\""));
+	if(!ThreadPool::subsys_init())
+	{
+		Type::subsys_stop();
+		SoundProcessor::subsys_stop();
+		throw std::runtime_error(_("Unable to initialize subsystem \"Thread Pool\""));
+	}
+
 	if(cb)cb->task(_("Starting Subsystem \"Rendering\""));
 	if(!rendering::Renderer::subsys_init())
 	{
+		ThreadPool::subsys_stop();
 		Type::subsys_stop();
 		SoundProcessor::subsys_stop();
 		throw std::runtime_error(_("Unable to initialize subsystem \"Rendering\""));
@@ -286,6 +296,7 @@ synfig::Main::Main(const synfig::String& rootpath,ProgressCallback *cb):
 	if(!Module::subsys_init(root_path))
 	{
 		rendering::Renderer::subsys_stop();
+		ThreadPool::subsys_stop();
 		Type::subsys_stop();
 		SoundProcessor::subsys_stop();
 		throw std::runtime_error(_("Unable to initialize subsystem \"Modules\""));
@@ -296,6 +307,7 @@ synfig::Main::Main(const synfig::String& rootpath,ProgressCallback *cb):
 	{
 		Module::subsys_stop();
 		rendering::Renderer::subsys_stop();
+		ThreadPool::subsys_stop();
 		Type::subsys_stop();
 		SoundProcessor::subsys_stop();
 		throw std::runtime_error(_("Unable to initialize subsystem \"Layers\""));
@@ -307,6 +319,7 @@ synfig::Main::Main(const synfig::String& rootpath,ProgressCallback *cb):
 		Layer::subsys_stop();
 		Module::subsys_stop();
 		rendering::Renderer::subsys_stop();
+		ThreadPool::subsys_stop();
 		Type::subsys_stop();
 		SoundProcessor::subsys_stop();
 		throw std::runtime_error(_("Unable to initialize subsystem \"Targets\""));
@@ -319,15 +332,12 @@ synfig::Main::Main(const synfig::String& rootpath,ProgressCallback *cb):
 		Layer::subsys_stop();
 		Module::subsys_stop();
 		rendering::Renderer::subsys_stop();
+		ThreadPool::subsys_stop();
 		Type::subsys_stop();
 		SoundProcessor::subsys_stop();
 		throw std::runtime_error(_("Unable to initialize subsystem \"Importers\""));
 	}
 
-	if(cb)cb->task(_("Starting Subsystem \"Thread Pool\""));
-	if(!ThreadPool::subsys_init())
-		throw std::runtime_error(_("Unable to initialize subsystem \"Thread Pool\""));
-
 	// Rebuild tokens data
 	Token::rebuild();
 
@@ -416,8 +426,6 @@ synfig::Main::~Main()
 		}
 	}
 
-	// synfig::info("ThreadPool::subsys_stop()");
-	ThreadPool::subsys_stop();
 	// synfig::info("Importer::subsys_stop()");
 	Importer::subsys_stop();
 	// synfig::info("Target::subsys_stop()");
@@ -430,6 +438,8 @@ synfig::Main::~Main()
 	// Module::subsys_stop();
 	// synfig::info("Exiting");
 	rendering::Renderer::subsys_stop();
+	// synfig::info("ThreadPool::subsys_stop()");
+	ThreadPool::subsys_stop();
 	Type::subsys_stop();
 	SoundProcessor::subsys_stop();
 
@@ -167,6 +167,8 @@ Node::Node():
 	guid_(GUID::zero()),
 	bchanged(true),
 	time_last_changed_(clock()),
+	changed_time_begin_(Time::begin()),
+	changed_time_end_(Time::end()),
 	deleting_(false)
 {
 }
@@ -180,7 +182,13 @@ Node::~Node()
 
 void
 Node::changed()
+	{ changed(Time::begin(), Time::end()); }
+
+void
+Node::changed(const Time &begin, const Time &end)
 {
+	changed_time_begin_ = begin;
+	changed_time_end_ = end;
 	time_last_changed_= clock();
 	on_changed();
 }
@@ -374,13 +382,26 @@ Node::on_changed()
 	{
 		(*iter)->child_changed(this);
 	}
+
+	// on_changed() may be called directly, without changed(begin, end)
+	changed_time_begin_ = Time::begin();
+	changed_time_end_ = Time::end();
 }
 
 void
 Node::on_child_changed(const Node *x)
 {
 	signal_child_changed()(x);
-	changed();
+	Time begin, end;
+	get_child_changed_time(x, begin, end);
+	changed(begin, end);
+}
+
+void
+Node::get_child_changed_time(const Node *x, Time &begin, Time &end)const
+{
+	begin = x->get_changed_time_begin();
+	end = x->get_changed_time_end();
 }
 
 void
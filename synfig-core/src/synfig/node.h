@@ -159,6 +159,10 @@ private:
 	//! The last time the node was modified since the program started
 	mutable clock_t time_last_changed_;
 
+	//! Time interval affected by the change which is being signaled now
+	Time changed_time_begin_;
+	Time changed_time_end_;
+
 	//! \writeme
 	mutable Glib::Threads::RWLock rw_lock_;
 
@@ -232,6 +236,9 @@ public:
 	//! This way programmer can batch its changes and call it only once
 	//! It emits signal_changed()
 	void changed();
+	//! Flag this node has changed only in the time interval from \p begin to \p end.
+	//! Nodes which do not know which times were affected call changed()
+	void changed(const Time &begin, const Time &end);
 	//! Flag the child node \p x has changed.
 	//! This way programmer can batch its changes and call it only once
 	//! It emits signal_child_changed() and signal_changed()
@@ -246,6 +253,12 @@ public:
 	//! Gets the time when the Node was changed
 	int get_time_last_changed()const;
 
+	//! Gets the time interval affected by the change of the node.
+	//! Valid only while the change is signaled, the whole time line
+	//! (Time::begin(), Time::end()) means that any time may be affected
+	const Time& get_changed_time_begin()const { return changed_time_begin_; }
+	const Time& get_changed_time_end()const { return changed_time_end_; }
+
 	//! Adds the parameter \p x as the child of the current Node
 	void add_child(Node *x);
 
@@ -324,6 +337,10 @@ public:
 protected:
 	void begin_delete();
 
+	//! Narrows or widens the time interval of the change, to be called from on_changed()
+	void set_changed_time(const Time &begin, const Time &end)
+		{ changed_time_begin_ = begin; changed_time_end_ = end; }
+
 private:
 	//! Add a new parent Node to parent_set
 	void add_parent(Node* new_parent);
@@ -345,6 +362,11 @@ protected:
 	//! the GUI can be connected to.
 	virtual void on_child_changed(const Node *x);
 
+	//! Calculates the time interval of this node affected by the change of
+	//! the child node \p x. By default it is the interval of the child,
+	//! nodes which evaluate their children at the other times must widen it.
+	virtual void get_child_changed_time(const Node *x, Time &begin, Time &end)const;
+
 	//! Used when the node's GUID has changed.
 	//! To be overloaded by the derivative classes. Emits a signal where the
 	//! the GUI can be connected to.
@@ -0,0 +1,144 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/optimizer/optimizerpixelprocessormerge.cpp
+**	\brief OptimizerPixelProcessorMerge
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "optimizerpixelprocessormerge.h"
+
+#include "../task/taskpixelprocessor.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+
+OptimizerPixelProcessorMerge::OptimizerPixelProcessorMerge()
+{
+	category_id = CATEGORY_ID_BEGIN;
+	mode = MODE_REPEAT_LAST;
+	for_task = true;
+}
+
+void
+OptimizerPixelProcessorMerge::run(const RunParams& params) const
+{
+	//
+	// merge chain of per-pixel operations into single pass
+	//
+	//  processorA
+	//  - processorB
+	//    - taskC
+	//
+	// converts to:
+	//
+	//  processorAB
+	//  - taskC
+	//
+	// where:
+	//  matrixA(matrixB)          -> matrixBA
+	//  gammaA(gammaB)            -> gammaBA
+	//  matrixA(gammaB)           -> gammaB_matrixA
+	//  matrixA(gammaB_matrixB)   -> gammaB_matrixBA
+	//  gammaA_matrixA(gammaB)    -> gammaBA_matrixA
+	//
+
+	TaskPixelProcessor::Handle processor = TaskPixelProcessor::Handle::cast_dynamic(params.ref_task);
+	if (!processor) return;
+
+	TaskPixelProcessor::Handle sub_processor = TaskPixelProcessor::Handle::cast_dynamic(processor->sub_task());
+	if ( !sub_processor
+	  || sub_processor->target_surface ) // exclude tasks with prerendered result
+		return;
+
+	// colors are row vectors, so the matrix of the inner task goes first
+	if (TaskPixelColorMatrix::Handle matrix = TaskPixelColorMatrix::Handle::cast_dynamic(processor))
+	{
+		if (TaskPixelColorMatrix::Handle sub_matrix = TaskPixelColorMatrix::Handle::cast_dynamic(sub_processor))
+		{
+			TaskPixelColorMatrix::Handle new_matrix = TaskPixelColorMatrix::Handle::cast_dynamic(matrix->clone());
+			new_matrix->matrix = sub_matrix->matrix * matrix->matrix;
+			new_matrix->sub_task() = sub_matrix->sub_task();
+			apply(params, new_matrix);
+		}
+		else
+		if (TaskPixelGamma::Handle sub_gamma = TaskPixelGamma::Handle::cast_dynamic(sub_processor))
+		{
+			TaskPixelGammaColorMatrix::Handle new_task(new TaskPixelGammaColorMatrix());
+			new_task->assign(*matrix);
+			new_task->gamma = sub_gamma->gamma;
+			new_task->matrix = matrix->matrix;
+			new_task->sub_task() = sub_gamma->sub_task();
+			apply(params, new_task);
+		}
+		else
+		if (TaskPixelGammaColorMatrix::Handle sub_task = TaskPixelGammaColorMatrix::Handle::cast_dynamic(sub_processor))
+		{
+			TaskPixelGammaColorMatrix::Handle new_task = TaskPixelGammaColorMatrix::Handle::cast_dynamic(sub_task->clone());
+			new_task->assign_target(*matrix);
+			new_task->matrix = sub_task->matrix * matrix->matrix;
+			apply(params, new_task);
+		}
+	}
+	else
+	if (TaskPixelGamma::Handle gamma = TaskPixelGamma::Handle::cast_dynamic(processor))
+	{
+		if (TaskPixelGamma::Handle sub_gamma = TaskPixelGamma::Handle::cast_dynamic(sub_processor))
+		{
+			TaskPixelGamma::Handle new_gamma = TaskPixelGamma::Handle::cast_dynamic(gamma->clone());
+			new_gamma->gamma = sub_gamma->gamma * gamma->gamma;
+			new_gamma->sub_task() = sub_gamma->sub_task();
+			apply(params, new_gamma);
+		}
+	}
+	else
+	if (TaskPixelGammaColorMatrix::Handle task = TaskPixelGammaColorMatrix::Handle::cast_dynamic(processor))
+	{
+		if (TaskPixelGamma::Handle sub_gamma = TaskPixelGamma::Handle::cast_dynamic(sub_processor))
+		{
+			TaskPixelGammaColorMatrix::Handle new_task = TaskPixelGammaColorMatrix::Handle::cast_dynamic(task->clone());
+			new_task->gamma = sub_gamma->gamma * task->gamma;
+			new_task->sub_task() = sub_gamma->sub_task();
+			apply(params, new_task);
+		}
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,60 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/optimizer/optimizerpixelprocessormerge.h
+**	\brief OptimizerPixelProcessorMerge Header
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_OPTIMIZERPIXELPROCESSORMERGE_H
+#define __SYNFIG_RENDERING_OPTIMIZERPIXELPROCESSORMERGE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include "../../optimizer.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+//! Merges the chain of gamma and color matrix tasks into single task,
+//! so the pixels are read and written once for the whole chain
+class OptimizerPixelProcessorMerge: public Optimizer
+{
+public:
+	OptimizerPixelProcessorMerge();
+	virtual void run(const RunParams &params) const;
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -32,8 +32,11 @@
 #	include <config.h>
 #endif
 
+#include <algorithm>
+
 #include <synfig/general.h>
 #include <synfig/localization.h>
+#include <synfig/threadpool.h>
 
 #include "optimizersplit.h"
 
@@ -48,6 +51,32 @@ using namespace rendering;
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+// cloning and scheduling of each piece are not free,
+// so the piece should be big enough
+const Real min_piece_cost = 128.0*128.0;
+const int min_piece_rows = 16;
+
+int
+calc_pieces_count(const RectInt &rect, Real pixel_cost, int overlap, int threads)
+{
+	int w = rect.get_width();
+	int h = rect.get_height();
+	if (w <= 0 || h <= 0)
+		return 1;
+
+	Real cost = Real(w)*Real(h)*pixel_cost;
+	int count = std::min(threads, (int)(cost/min_piece_cost));
+
+	// each piece processes the overlapped rows too,
+	// the piece should be much higher than the overlap
+	int min_rows = std::max(min_piece_rows, 2*overlap);
+	return std::min(count, h/min_rows);
+}
+
+} // end of anonymous namespace
+
 /* === M E T H O D S ======================================================= */
 
 OptimizerSplit::OptimizerSplit()
@@ -61,32 +90,38 @@ void
 OptimizerSplit::run(const RunParams &params) const
 {
 	if (!params.list) return;
-	const int min_area = 256*256;
+
+	// rendering threads are run by the common thread pool
+	const int threads = ThreadPool::instance().get_max_threads() - 1;
+	if (threads < 2) return;
+
 	for(Task::List::iterator i = params.list->begin(); i != params.list->end(); ++i)
 	{
-		if (TaskInterfaceSplit *split = i->type_pointer<TaskInterfaceSplit>())
-		if (split->is_splittable())
+		if (!*i || !(*i)->is_valid_coords()) continue;
+		TaskInterfaceSplit *split = i->type_pointer<TaskInterfaceSplit>();
+		if (!split || !split->is_splittable()) continue;
+
+		RectInt r = (*i)->target_rect;
+		int count = calc_pieces_count(r, split->get_split_pixel_cost(), split->get_split_overlap(), threads);
+		if (count < 2) continue;
+
+		// pieces are horizontal strips, rows of the surface are continuous in memory,
+		// so the pieces share only the boundary cache lines
+		Task::Handle task = *i;
+		int h = r.get_height();
+		for(int j = 0; j < count; ++j)
 		{
-			RectInt r = (*i)->target_rect;
-			int w = r.maxx - r.minx;
-			int h = r.maxy - r.miny;
-			int t = std::min(h/10, w*h/min_area);
-			if (t >= 2)
-			{
-				int hh = h/t;
-				int y = r.miny;
-				for(int j = 1; j < t; ++j, y += hh)
-				{
-					Task::Handle task = (*i)->clone();
-					task->trunc_target_rect( RectInt(r.minx, y, r.maxx, y + hh) );
-					i = params.list->insert(i, task);
-					++i;
-				}
-				*i = (*i)->clone();
-				(*i)->trunc_target_rect( RectInt(r.minx, y, r.maxx, r.maxy) );
-				apply(params);
-			}
+			Task::Handle piece = task->clone();
+			piece->trunc_target_rect( RectInt(r.minx, r.miny + h*j/count, r.maxx, r.miny + h*(j + 1)/count) );
+			if (TaskInterfaceSplit *piece_split = piece.type_pointer<TaskInterfaceSplit>())
+				piece_split->on_split();
+
+			if (j + 1 < count)
+				{ i = params.list->insert(i, piece); ++i; }
+			else
+				*i = piece;
 		}
+		apply(params);
 	}
 }
 
@@ -0,0 +1,110 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/optimizer/optimizersurfacecache.cpp
+**	\brief OptimizerSurfaceCache
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <synfig/string_helper.h>
+
+#include "optimizersurfacecache.h"
+
+#include "../task/taskcache.h"
+#include "../../renderer.h"
+#include "../../surfacecache.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+OptimizerSurfaceCache::OptimizerSurfaceCache(const String &prefix):
+	prefix(prefix)
+{
+	category_id = CATEGORY_ID_COORDS;
+	depends_from = CATEGORY_BEGIN;
+	for_task = true;
+}
+
+void
+OptimizerSurfaceCache::run(const RunParams& params) const
+{
+	TaskCache::Handle cache = TaskCache::Handle::cast_dynamic(params.ref_task);
+	if ( !cache
+	  || !cache->surface_key.empty()
+	  || !cache->sub_task()
+	  || !cache->is_valid() )
+		return;
+
+	SurfaceCache &surface_cache = Renderer::get_surface_cache();
+	if (!surface_cache.is_enabled())
+		return;
+
+	// pixels of result are fully determined by the contents,
+	// the source rect and the target rect
+	const Rect &sr = cache->source_rect;
+	const RectInt &tr = cache->target_rect;
+	cache = TaskCache::Handle::cast_dynamic(cache->clone());
+	cache->surface_key = prefix + "|" + cache->key
+		               + strprintf( "|%a %a %a %a|%d %d %d %d",
+		                            sr.minx, sr.miny, sr.maxx, sr.maxy,
+		                            tr.minx, tr.miny, tr.maxx, tr.maxy );
+
+	SurfaceResource::Handle surface = surface_cache.get(cache->surface_key);
+	if ( surface
+	  && surface->get_width() == tr.get_width()
+	  && surface->get_height() == tr.get_height() )
+	{
+		// share the stored pixels with a new resource, so conversions
+		// made for the tasks do not stay in the cache
+		SurfaceResource::LockReadBase lock(surface);
+		if (lock.convert(Surface::Token::Handle(), false, true))
+			surface = new SurfaceResource(lock.get_handle());
+
+		Task::Handle sub_task = new TaskSurface();
+		sub_task->target_surface = surface;
+		sub_task->source_rect = sr;
+		sub_task->target_rect = RectInt(VectorInt::zero(), tr.get_size());
+		cache->sub_task() = sub_task;
+		cache->cached = true;
+	}
+
+	apply(params, cache);
+}
+
+/* === E N T R Y P O I N T ================================================= */
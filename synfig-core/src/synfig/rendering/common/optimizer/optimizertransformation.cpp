@@ -137,6 +137,8 @@ OptimizerTransformation::run(const RunParams& params) const
 		{
 			sub_task = sub_task->clone();
 			sub_task->assign_target(*transformation);
+			sub_task.type_pointer<TaskInterfaceTransformationPass>()->on_transformation_passed(
+				*TransformationAffine::Handle::cast_static(transformation->get_transformation()) );
 			for(Task::List::iterator i = sub_task->sub_tasks.begin(); i != sub_task->sub_tasks.end(); ++i)
 				if (*i) {
 					Task::Handle t = transformation->clone();
@@ -0,0 +1,69 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/task/taskcache.cpp
+**	\brief TaskCache
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "taskcache.h"
+
+
+#include <synfig/string_helper.h>
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+
+SYNFIG_EXPORT Task::Token TaskCache::token(
+	DescAbstract<TaskCache>("Cache") );
+
+
+void
+TaskCache::on_transformation_passed(const TransformationAffine &transformation)
+{
+	// the transformation becomes the part of the contents
+	const Matrix &m = transformation.matrix;
+	key += strprintf( "|%a %a %a %a %a %a %a %a %a",
+		m.m00, m.m01, m.m02,
+		m.m10, m.m11, m.m12,
+		m.m20, m.m21, m.m22 );
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,97 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/task/taskcache.h
+**	\brief TaskCache Header
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_TASKCACHE_H
+#define __SYNFIG_RENDERING_TASKCACHE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include "../../task.h"
+#include "tasktransformation.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+/*!	\class TaskCache
+**	\brief Marks the sub-task which result may be taken from SurfaceCache.
+**
+**	The task just copies the result of the sub-task.
+**	OptimizerSurfaceCache completes the key by the coordinates and resolution
+**	and replaces the sub-task by the surface from the cache when it's found,
+**	otherwise the software implementation puts the result into the cache.
+**	The software implementation keeps cached surfaces as half floats
+**	(see SurfaceSWCompact) and renders with the stored precision on both
+**	a miss and a hit, so values over 65504 become infinite.
+**	Without the optimizer the task is removed by OptimizerPass.
+*/
+class TaskCache: public Task, public TaskInterfaceTransformationPass
+{
+public:
+	typedef etl::handle<TaskCache> Handle;
+	SYNFIG_EXPORT static Token token;
+	virtual Token::Handle get_token() const { return token.handle(); }
+
+	//! Identifies the contents of the sub-task,
+	//! only equal sub-tasks may have equal keys
+	String key;
+	//! Key of the surface in the SurfaceCache, set by the optimizer
+	String surface_key;
+	//! The sub-task is the surface taken from the cache
+	bool cached;
+
+	TaskCache(): cached() { }
+
+	const Task::Handle& sub_task() const { return Task::sub_task(0); }
+	Task::Handle& sub_task() { return Task::sub_task(0); }
+
+	virtual int get_pass_subtask_index() const
+	{
+		return !sub_task() ? PASSTO_NO_TASK
+		     : surface_key.empty() ? 0
+		     : PASSTO_THIS_TASK;
+	}
+
+	virtual Rect calc_bounds() const
+		{ return sub_task() ? sub_task()->get_bounds() : Rect::zero(); }
+
+	virtual void on_transformation_passed(const TransformationAffine &transformation);
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
@@ -0,0 +1,96 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/common/task/taskpixelgenerator.h
+**	\brief TaskPixelGenerator Header
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_TASKPIXELGENERATOR_H
+#define __SYNFIG_RENDERING_TASKPIXELGENERATOR_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <synfig/color.h>
+
+#include "../../task.h"
+#include "tasktransformation.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+
+//! Calculates color of each pixel independently from other pixels.
+//! Generator is shared between pieces of the split task,
+//! so it must not be changed after the task is built
+class PixelGenerator: public etl::shared_object
+{
+public:
+	typedef etl::handle<PixelGenerator> Handle;
+
+	//! Fills \a rows rows of \a count pixels, \a pitch is the distance between rows in pixels.
+	//! \a p is position of the first pixel in units of generator,
+	//! \a dx is the step to the next pixel and \a dy is the step to the next row
+	virtual void generate(Color *dst, int pitch, int count, int rows, const Vector &p, const Vector &dx, const Vector &dy) const = 0;
+
+	//! Signed width of the pixel in units of generator,
+	//! it's equal to RendDesc::get_pw() of the legacy rendering when the transformation is not rotated
+	static Real get_pw(const Vector &dx)
+		{ return dx[0] < 0.0 ? -dx.mag() : dx.mag(); }
+
+	//! Approximate cost of one pixel relative to the simple blending of two surfaces
+	virtual Real get_pixel_cost() const
+		{ return 4.0; }
+
+	virtual ~PixelGenerator() { }
+};
+
+
+class TaskPixelGenerator: public Task, public TaskInterfaceTransformation
+{
+public:
+	typedef etl::handle<TaskPixelGenerator> Handle;
+	SYNFIG_EXPORT static Token token;
+	virtual Token::Handle get_token() const { return token.handle(); }
+
+	PixelGenerator::Handle generator;
+	Holder<TransformationAffine> transformation;
+
+	virtual Transformation::Handle get_transformation() const
+		{ return transformation.handle(); }
+};
+
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
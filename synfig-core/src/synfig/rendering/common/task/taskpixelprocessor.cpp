@@ -54,6 +54,8 @@ Task::Token TaskPixelGamma::token(
 	DescAbstract<TaskPixelGamma, TaskPixelProcessor>("PixelGamma") );
 SYNFIG_EXPORT Task::Token TaskPixelColorMatrix::token(
 	DescAbstract<TaskPixelColorMatrix, TaskPixelProcessor>("PixelColorMatrix") );
+SYNFIG_EXPORT Task::Token TaskPixelGammaColorMatrix::token(
+	DescAbstract<TaskPixelGammaColorMatrix, TaskPixelProcessor>("PixelGammaColorMatrix") );
 
 
 Rect
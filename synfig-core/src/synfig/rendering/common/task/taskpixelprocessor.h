@@ -129,6 +129,34 @@ public:
 };
 
 
+//! Gamma correction followed by color matrix in the single pass,
+//! made by OptimizerPixelProcessorMerge from the chain of tasks
+class TaskPixelGammaColorMatrix: public TaskPixelProcessor
+{
+public:
+	typedef etl::handle<TaskPixelGammaColorMatrix> Handle;
+	SYNFIG_EXPORT static Token token;
+	virtual Token::Handle get_token() const { return token.handle(); }
+
+	Gamma gamma;
+	ColorMatrix matrix;
+
+	virtual bool is_zero() const
+		{ return matrix.is_transparent(); }
+	virtual bool is_transparent() const
+	{
+		return matrix.is_identity()
+			&& approximate_equal_lp(gamma.get_r(), ColorReal(1.0))
+			&& approximate_equal_lp(gamma.get_g(), ColorReal(1.0))
+			&& approximate_equal_lp(gamma.get_b(), ColorReal(1.0));
+	}
+	virtual bool is_constant() const
+		{ return matrix.is_constant(); }
+	virtual bool is_affects_transparent() const
+		{ return matrix.is_affects_transparent(); }
+};
+
+
 } /* end namespace rendering */
 } /* end namespace synfig */
 
@@ -51,6 +51,9 @@ class TaskInterfaceTransformationPass
 {
 public:
 	virtual ~TaskInterfaceTransformationPass() { }
+	//! Optimizer calls it for the copy of this task when it moves
+	//! the affine transformation from the parent into the sub-tasks
+	virtual void on_transformation_passed(const TransformationAffine& /* transformation */) { }
 };
 
 
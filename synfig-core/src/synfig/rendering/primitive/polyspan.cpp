@@ -42,6 +42,7 @@
 
 #include <synfig/general.h>
 #include <synfig/localization.h>
+#include <synfig/threadpool.h>
 
 #endif
 
@@ -54,6 +55,76 @@ using namespace rendering;
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+	typedef Polyspan::cover_array::iterator MarkIterator;
+
+	//! Less marks are just sorted by std::sort
+	const size_t min_binned_marks = 256;
+	//! Less marks are sorted in the current thread
+	const size_t min_parallel_marks = 16384;
+
+	bool
+	less_by_x(const Polyspan::PenMark &a, const Polyspan::PenMark &b)
+		{ return a.x < b.x; }
+
+	void
+	sort_rows(const int *row_offsets, int row_begin, int row_end, MarkIterator marks)
+	{
+		for(int i = row_begin; i < row_end; ++i)
+			if (row_offsets[i + 1] - row_offsets[i] > 1)
+				std::sort(marks + row_offsets[i], marks + row_offsets[i + 1], less_by_x);
+	}
+
+	//! Bins marks by rows, then sorts every row by x, rows are sorted in parallel
+	void
+	sort_marks_by_rows(MarkIterator begin, MarkIterator end)
+	{
+		size_t count = end - begin;
+		if (count < min_binned_marks)
+			{ std::sort(begin, end); return; }
+
+		int miny = begin->y, maxy = begin->y;
+		for(MarkIterator i = begin; i != end; ++i)
+			{ miny = std::min(miny, i->y); maxy = std::max(maxy, i->y); }
+		size_t rows = (size_t)((long long)maxy - miny + 1);
+		if (rows > 4*count)
+			{ std::sort(begin, end); return; }
+
+		// counting sort by rows, it keeps order of marks within a row
+		std::vector<int> row_offsets(rows + 1, 0);
+		for(MarkIterator i = begin; i != end; ++i)
+			++row_offsets[i->y - miny + 1];
+		for(size_t i = 1; i <= rows; ++i)
+			row_offsets[i] += row_offsets[i - 1];
+
+		Polyspan::cover_array binned(count);
+		std::vector<int> next(row_offsets.begin(), row_offsets.end() - 1);
+		for(MarkIterator i = begin; i != end; ++i)
+			binned[ next[i->y - miny]++ ] = *i;
+
+		int threads = count < min_parallel_marks ? 1 : ThreadPool::instance().get_max_threads();
+		if (threads <= 1) {
+			sort_rows(&row_offsets.front(), 0, (int)rows, binned.begin());
+		} else {
+			// bands with equal count of marks
+			ThreadPool::Group group;
+			int row = 0;
+			for(int i = 1; i <= threads && row < (int)rows; ++i) {
+				int limit = (int)(count*i/threads);
+				int band_end = (int)(std::upper_bound(row_offsets.begin() + row + 1, row_offsets.end(), limit) - row_offsets.begin()) - 1;
+				band_end = std::max(row + 1, std::min(band_end, (int)rows));
+				if (i == threads) band_end = (int)rows;
+				group.enqueue( sigc::bind( sigc::ptr_fun(&sort_rows),
+					&row_offsets.front(), row, band_end, binned.begin() ));
+				row = band_end;
+			}
+			group.run();
+		}
+
+		std::copy(binned.begin(), binned.end(), begin);
+	}
+}
+
 /* === M E T H O D S ======================================================= */
 
 //default constructor - 0 everything
@@ -156,7 +227,7 @@ Polyspan::sort_marks()
 		addcurrent();
 		current.setcover(0,0);
 
-		std::sort(covers.begin() + open_index,covers.end());
+		sort_marks_by_rows(covers.begin() + open_index, covers.end());
 		flags &= ~NotSorted;
 	}
 }
@@ -46,6 +46,8 @@
 
 #include "renderer.h"
 #include "renderqueue.h"
+#include "surfacecache.h"
+#include "surfacepool.h"
 
 #include "software/renderersw.h"
 #include "software/rendererdraftsw.h"
@@ -80,14 +82,36 @@ using namespace rendering;
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+
+// each task has a fixed overhead of scheduling and locking of surfaces,
+// in units of cost of the simple blending of one pixel
+const Real task_base_cost = 1024.0;
+
+Real
+estimate_task_cost(const Task &task)
+{
+	Real cost = task_base_cost;
+	if (task.target_rect.is_valid()) {
+		Real pixel_cost = 1.0;
+		if (const TaskInterfaceSplit *split = dynamic_cast<const TaskInterfaceSplit*>(&task))
+			pixel_cost = split->get_split_pixel_cost();
+		cost += Real(task.target_rect.get_width())*Real(task.target_rect.get_height())*pixel_cost;
+	}
+	return cost;
+}
+
+} // end of anonymous namespace
+
 /* === M E T H O D S ======================================================= */
 
 Renderer::Handle Renderer::blank;
 std::map<String, Renderer::Handle> *Renderer::renderers;
 RenderQueue *Renderer::queue;
+SurfaceCache *Renderer::surface_cache;
 Renderer::DebugOptions Renderer::debug_options;
 long long Renderer::last_registered_optimizer_index = 0;
-long long Renderer::last_batch_index = 0;
+std::atomic<long long> Renderer::last_batch_index(0);
 
 
 void
@@ -783,6 +807,17 @@ Renderer::find_deps(const Task::List &list, long long batch_index) const
 		task_rd.tmp_deps.clear();
 		task_rd.tmp_back_deps.clear();
 	}
+
+	// calculate priorities by the longest path to the end of batch,
+	// dependent tasks are always placed after their dependencies
+	for(Task::List::const_reverse_iterator i = list.rbegin(); i != list.rend(); ++i) {
+		Task::RendererData &task_rd = (*i)->renderer_data;
+		Real max_priority = 0.0;
+		for(Task::Set::const_iterator j = task_rd.back_deps.begin(); j != task_rd.back_deps.end(); ++j)
+			max_priority = std::max(max_priority, (*j)->renderer_data.priority);
+		task_rd.cost = estimate_task_cost(**i);
+		task_rd.priority = task_rd.cost + max_priority;
+	}
 }
 
 bool
@@ -850,9 +885,13 @@ Renderer::enqueue(const Task::List &list, const TaskEvent::Handle &finish_event_
 
 	if (finish_event_task)
 	{
+		// tasks of the sub-queue continue the chain of the task which created it
+		Real priority = finish_event_task->renderer_data.priority;
 		finish_event_task->renderer_data.deps.insert(optimized_list.begin(), optimized_list.end());
-		for(Task::List::const_iterator i = optimized_list.begin(); i != optimized_list.end(); ++i)
+		for(Task::List::const_iterator i = optimized_list.begin(); i != optimized_list.end(); ++i) {
 			(*i)->renderer_data.back_deps.insert(finish_event_task);
+			(*i)->renderer_data.priority += priority;
+		}
 		optimized_list.push_back(finish_event_task);
 	}
 
@@ -928,6 +967,7 @@ Renderer::log(
 			+ (trd.index ? strprintf("#%05d-%04d ", trd.batch_index, trd.index): "")
 			+ deps
 			+ back_deps
+			+ (trd.index ? strprintf("p%.0f ", trd.priority): "")
 			+ t->get_token()->name
 			+ ( t->get_bounds().valid()
 			  ? strprintf(" bounds (%f, %f)-(%f, %f)",
@@ -989,8 +1029,20 @@ Renderer::initialize()
 	if (const char *s = getenv("SYNFIG_RENDERING_DEBUG_RESULT_IMAGE"))
 		debug_options.result_image = s;
 
+	// size of the surface cache in megabytes
+	size_t surface_cache_size = 256;
+	if (const char *s = getenv("SYNFIG_RENDERING_SURFACE_CACHE_SIZE"))
+		surface_cache_size = (size_t)std::max(0, atoi(s));
+
+	// limit of the free buffers waiting for reuse in megabytes
+	size_t surface_pool_size = 128;
+	if (const char *s = getenv("SYNFIG_RENDERING_SURFACE_POOL_SIZE"))
+		surface_pool_size = (size_t)std::max(0, atoi(s));
+
 	renderers = new std::map<String, Handle>();
 	queue = new RenderQueue();
+	surface_cache = new SurfaceCache(surface_cache_size*1024*1024);
+	get_surface_pool().set_max_bytes(surface_pool_size*1024*1024);
 
 	initialize_renderers();
 }
@@ -1010,6 +1062,19 @@ Renderer::deinitialize()
 	renderers = nullptr;
 	delete queue;
 	queue = nullptr;
+
+	SurfaceCache::Stats stats = surface_cache->get_stats();
+	if (stats.hits || stats.misses)
+		synfig::info( "rendering::Renderer surface cache: %lld hits, %lld misses, %lld evictions",
+		              stats.hits, stats.misses, stats.evictions );
+	delete surface_cache;
+	surface_cache = nullptr;
+
+	SurfacePool::Stats pool_stats = get_surface_pool().get_stats();
+	if (pool_stats.requests)
+		synfig::info( "rendering::Renderer surface pool: %lld of %lld buffers reused, peak %zu KB in use",
+		              pool_stats.reuses, pool_stats.requests, pool_stats.peak_bytes/1024 );
+	get_surface_pool().set_max_bytes(0);
 }
 
 void
@@ -1037,6 +1102,22 @@ Renderer::get_renderer(const String &name)
 		 : blank;
 }
 
+SurfaceCache&
+Renderer::get_surface_cache()
+{
+	if (!surface_cache)
+		synfig::error("rendering::Renderer not initialized");
+	return *surface_cache;
+}
+
+SurfacePool&
+Renderer::get_surface_pool()
+{
+	// never deleted, surfaces may be released after deinitialization
+	static SurfacePool *surface_pool = new SurfacePool();
+	return *surface_pool;
+}
+
 const std::map<String, Renderer::Handle>&
 Renderer::get_renderers()
 {
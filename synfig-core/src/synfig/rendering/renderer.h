@@ -49,6 +49,8 @@ namespace rendering
 {
 
 class RenderQueue;
+class SurfaceCache;
+class SurfacePool;
 
 class Renderer: public etl::shared_object
 {
@@ -66,9 +68,10 @@ private:
 	static Handle blank;
 	static std::map<String, Handle> *renderers;
 	static RenderQueue *queue;
+	static SurfaceCache *surface_cache;
 	static DebugOptions debug_options;
 	static long long last_registered_optimizer_index;
-	static long long last_batch_index; // TODO: atomic
+	static std::atomic<long long> last_batch_index;
 
 	ModeList modes;
 	Optimizer::List optimizers[Optimizer::CATEGORIES_COUNT];
@@ -186,6 +189,12 @@ public:
 	static const DebugOptions& get_debug_options()
 		{ return debug_options; }
 
+	//! Rendered surfaces of the static parts of the canvas, shared by all renderers
+	static SurfaceCache& get_surface_cache();
+
+	//! Memory of pixel buffers reused by the surfaces of all renderers
+	static SurfacePool& get_surface_pool();
+
 	static bool subsys_init()
 		{ initialize(); return true; }
 	static bool subsys_stop()
@@ -32,6 +32,7 @@
 #	include <config.h>
 #endif
 
+#include <algorithm>
 #include <cstdlib>
 
 
@@ -41,6 +42,8 @@
 #include <synfig/debug/log.h>
 #include <synfig/debug/measure.h>
 
+#include <synfig/threadpool.h>
+
 #include "renderqueue.h"
 #include "renderer.h"
 
@@ -83,10 +86,44 @@ public:
 Task::Token TaskSubQueue::token(
 	DescSpecial<TaskSubQueue>("SubQueue") );
 
+// index of the rendering thread, -1 for threads which are not belong to the queue
+thread_local int current_thread_index = -1;
+
 } // end of anonimous namespace
 
 
-RenderQueue::RenderQueue(): started(false) { start(); }
+bool
+RenderQueue::ReadyQueue::Entry::operator<(const Entry &other) const
+{
+	if (!task || !other.task)
+		return !task && other.task;
+	if (task->renderer_data.priority != other.task->renderer_data.priority)
+		return task->renderer_data.priority < other.task->renderer_data.priority;
+	return index < other.index;
+}
+
+void
+RenderQueue::ReadyQueue::push(const Task::Handle &task)
+{
+	entries.push_back(Entry(task, ++last_index));
+	std::push_heap(entries.begin(), entries.end());
+}
+
+Task::Handle
+RenderQueue::ReadyQueue::pop()
+{
+	if (entries.empty())
+		return Task::Handle();
+	std::pop_heap(entries.begin(), entries.end());
+	Task::Handle task = entries.back().task;
+	entries.pop_back();
+	return task;
+}
+
+
+RenderQueue::RenderQueue():
+	started(false), next_worker_queue(1), threads_count(0), running_threads(0)
+	{ start(); }
 RenderQueue::~RenderQueue() { stop(); }
 
 void
@@ -98,7 +135,8 @@ RenderQueue::start()
 	// one thread reserved for non-multithreading tasks (OpenGL)
 	// also this thread almost don't use CPU time
 	// so we have ~50% of one core for GUI
-	unsigned int count = std::thread::hardware_concurrency();
+	// other threads are limited by the common thread pool
+	unsigned int count = ThreadPool::instance().get_max_threads();
 
 	#ifdef DEBUG_TASK_SURFACE
 	count = 2;
@@ -110,30 +148,34 @@ RenderQueue::start()
 	if (count > SYNFIG_RENDERING_MAX_THREADS) count = SYNFIG_RENDERING_MAX_THREADS;
 	if (count < 2) count = 2;
 
+	// queues should be created before threads, and never resized while threads are running
+	// queue #0 is not used, thread 0 takes tasks from single_ready_tasks
+	worker_queues.resize(count);
+	tasks_in_process.resize(count);
+
+	started = true;
+	threads_count = running_threads = count;
 	for(unsigned int i = 0; i < count; ++i)
-		threads.push_back(
-			std::thread(
-				sigc::bind(sigc::mem_fun(*this, &RenderQueue::process), i) ));
+		ThreadPool::instance().enqueue(
+			sigc::bind(sigc::mem_fun(*this, &RenderQueue::process), i) );
 	info("rendering threads %d", count);
-	started = true;
 }
 
 void
 RenderQueue::stop()
 {
-	{
-		std::lock_guard<std::mutex> lock(mutex);
-		started = false;
-		cond.notify_all();
-		single_cond.notify_all();
-	}
-	while(!threads.empty())
-		{ threads.front().join(); threads.pop_front(); }
+	std::unique_lock<std::mutex> lock(mutex);
+	started = false;
+	cond.notify_all();
+	single_cond.notify_all();
+	while(running_threads > 0)
+		ThreadPool::instance().wait(stopped_cond, lock);
 }
 
 void
 RenderQueue::process(int thread_index)
 {
+	current_thread_index = thread_index;
 	while(Task::Handle task = get(thread_index))
 	{
 		#ifdef DEBUG_THREAD_TASK
@@ -182,6 +224,7 @@ RenderQueue::process(int thread_index)
 			{
 				TaskSubQueue::Handle task_sub_queue(new TaskSubQueue());
 				task_sub_queue->sub_task() = task;
+				task_sub_queue->renderer_data.priority = task->renderer_data.priority;
 				task->renderer_data.params.renderer->enqueue(task->renderer_data.params.sub_queue, task_sub_queue, true);
 				continue;
 			}
@@ -190,6 +233,10 @@ RenderQueue::process(int thread_index)
 
 		done(thread_index, task);
 	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (--running_threads <= 0)
+		stopped_cond.notify_all();
 }
 
 void
@@ -198,25 +245,24 @@ RenderQueue::done(int thread_index, const Task::Handle &task)
 	assert(task);
 	int single_signals = 0;
 	int signals = 0;
-	std::lock_guard<std::mutex> lock(mutex);
-	for(Task::Set::iterator i = task->renderer_data.back_deps.begin(); i != task->renderer_data.back_deps.end(); ++i)
 	{
-		assert(*i);
-		(*i)->renderer_data.deps.erase(task);
-		if ((*i)->renderer_data.deps.empty())
+		std::lock_guard<std::mutex> lock(mutex);
+		for(Task::Set::iterator i = task->renderer_data.back_deps.begin(); i != task->renderer_data.back_deps.end(); ++i)
 		{
-			bool mt = (*i)->get_allow_multithreading();
-			TaskQueue &queue = mt ? ready_tasks     : single_ready_tasks;
-			TaskSet   &wait  = mt ? not_ready_tasks : single_not_ready_tasks;
-			wait.erase(*i);
-			queue.push_back(*i);
-			++(mt ? signals : single_signals);
+			assert(*i);
+			(*i)->renderer_data.deps.erase(task);
+			if ((*i)->renderer_data.deps.empty())
+			{
+				bool mt = (*i)->get_allow_multithreading();
+				(mt ? not_ready_tasks : single_not_ready_tasks).erase(*i);
+				if (mt) push_ready(thread_index, *i); else single_ready_tasks.push(*i);
+				++(mt ? signals : single_signals);
+			}
 		}
+		task->renderer_data.back_deps.clear();
 	}
-	task->renderer_data.back_deps.clear();
-	assert( tasks_in_process.count(thread_index) == 1 );
-	tasks_in_process.erase(thread_index);
-	//info("rendering threads used %d", tasks_in_process.size());
+	// only this thread touches its slot
+	tasks_in_process[thread_index].reset();
 
 	// limit signals count
 	int threads = get_threads_count() - 1;
@@ -231,35 +277,106 @@ RenderQueue::done(int thread_index, const Task::Handle &task)
 	while(single_signals-- > 0) single_cond.notify_one();
 }
 
+void
+RenderQueue::push_ready(int thread_index, const Task::Handle &task)
+{
+	// mutex must be already locked
+
+	// keep the task in the thread which made its dependencies,
+	// tasks from other threads are distributed between all workers
+	if (thread_index <= 0 || thread_index >= (int)worker_queues.size()) {
+		thread_index = next_worker_queue;
+		if (++next_worker_queue >= (int)worker_queues.size())
+			next_worker_queue = 1;
+	}
+	WorkerQueue &queue = worker_queues[thread_index];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	queue.tasks.push(task);
+}
+
+Task::Handle
+RenderQueue::pop_ready(int thread_index)
+{
+	// own tasks first, among the tasks with the same priority
+	// the latest task is a most likely to use hot surfaces
+	{
+		WorkerQueue &queue = worker_queues[thread_index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		while(!queue.tasks.empty())
+			if (Task::Handle task = queue.tasks.pop())
+				return task;
+	}
+
+	// steal the most important task from other threads
+	int count = (int)worker_queues.size();
+	for(int j = 1; j < count; ++j) {
+		int i = (thread_index + j) % count;
+		if (i == 0) continue;
+		WorkerQueue &queue = worker_queues[i];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		while(!queue.tasks.empty())
+			if (Task::Handle task = queue.tasks.pop())
+				return task;
+	}
+
+	return Task::Handle();
+}
+
+bool
+RenderQueue::has_ready()
+{
+	for(WorkerQueueList::iterator i = worker_queues.begin(); i != worker_queues.end(); ++i) {
+		std::lock_guard<std::mutex> lock(i->mutex);
+		if (!i->tasks.empty()) return true;
+	}
+	return false;
+}
+
 Task::Handle
 RenderQueue::get(int thread_index)
 {
-	std::unique_lock<std::mutex> lock(mutex);
+	if (thread_index == 0) {
+		std::unique_lock<std::mutex> lock(mutex);
+		while(started)
+		{
+			if (!single_ready_tasks.empty())
+			{
+				Task::Handle task = single_ready_tasks.pop();
+				if (!task) continue;
+				tasks_in_process[thread_index] = task;
+				return task;
+			}
+
+			#ifdef DEBUG_THREAD_WAIT
+			if (!single_not_ready_tasks.empty())
+				info("thread %d: rendering wait for task", thread_index);
+			#endif
+
+			ThreadPool::instance().wait(single_cond, lock);
+		}
+		return Task::Handle();
+	}
 
-	TaskQueue &queue  = thread_index == 0 ? single_ready_tasks     : ready_tasks;
-	TaskQueue &queue2 = thread_index != 0 ? single_ready_tasks     : ready_tasks;
-	TaskSet   &wait   = thread_index == 0 ? single_not_ready_tasks : not_ready_tasks;
 	while(started)
 	{
-		if (!queue.empty())
-		{
-			Task::Handle task = queue.front();
-			queue.pop_front();
-			if (!task) continue;
-			assert( tasks_in_process.count(thread_index) == 0 );
+		// main mutex is not needed to take the task
+		if (Task::Handle task = pop_ready(thread_index)) {
 			tasks_in_process[thread_index] = task;
-			//info("rendering threads used %d", tasks_in_process.size());
 			return task;
 		}
 
+		// tasks are pushed only under the main mutex,
+		// so check the queues again under the lock before the sleep
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!started) break;
+		if (has_ready()) continue;
+
 		#ifdef DEBUG_THREAD_WAIT
-		if (!wait.empty())
+		if (!not_ready_tasks.empty())
 			info("thread %d: rendering wait for task", thread_index);
 		#endif
 
-		assert( wait.empty() || !tasks_in_process.empty() || !queue2.empty() );
-
-		(thread_index ? cond : single_cond).wait(lock);
+		ThreadPool::instance().wait(cond, lock);
 	}
 	return Task::Handle();
 }
@@ -277,7 +394,7 @@ RenderQueue::fix_task(const Task &task, const Task::RunParams &params)
 int
 RenderQueue::get_threads_count() const
 {
-	return threads.size();
+	return threads_count;
 }
 
 bool
@@ -323,10 +440,11 @@ RenderQueue::remove_orphans()
 {
 	// mutex must be already locked
 
-	for(TaskQueue::iterator i = ready_tasks.begin(); i != ready_tasks.end();)
-		if (remove_if_orphan(*i, true)) ready_tasks.erase(i++); else ++i;
-	for(TaskQueue::iterator i = single_ready_tasks.begin(); i != single_ready_tasks.end();)
-		if (remove_if_orphan(*i, true)) single_ready_tasks.erase(i++); else ++i;
+	for(WorkerQueueList::iterator q = worker_queues.begin(); q != worker_queues.end(); ++q) {
+		std::lock_guard<std::mutex> lock(q->mutex);
+		q->tasks.remove_if([this](const Task::Handle &task) { return remove_if_orphan(task, true); });
+	}
+	single_ready_tasks.remove_if([this](const Task::Handle &task) { return remove_if_orphan(task, true); });
 
 	for(TaskSet::iterator i = not_ready_tasks.begin(); i != not_ready_tasks.end();)
 		if (remove_if_orphan(*i, true)) not_ready_tasks.erase(i++); else ++i;
@@ -343,10 +461,9 @@ RenderQueue::enqueue(const Task::Handle &task, const Task::RunParams &params)
 	std::lock_guard<std::mutex> lock(mutex);
 
 	bool mt = task->get_allow_multithreading();
-	TaskQueue &queue = mt ? ready_tasks     : single_ready_tasks;
-	TaskSet   &wait  = mt ? not_ready_tasks : single_not_ready_tasks;
+	TaskSet &wait = mt ? not_ready_tasks : single_not_ready_tasks;
 	if (task->renderer_data.deps.empty()) {
-		queue.push_back(task);
+		if (mt) push_ready(current_thread_index, task); else single_ready_tasks.push(task);
 		(mt ? cond : single_cond).notify_one();
 	}
 	else
@@ -375,10 +492,9 @@ RenderQueue::enqueue(const Task::List &tasks, const Task::RunParams &params)
 		if (*i)
 		{
 			bool mt = (*i)->get_allow_multithreading();
-			TaskQueue &queue = mt ? ready_tasks     : single_ready_tasks;
-			TaskSet   &wait  = mt ? not_ready_tasks : single_not_ready_tasks;
+			TaskSet &wait = mt ? not_ready_tasks : single_not_ready_tasks;
 			if ((*i)->renderer_data.deps.empty()) {
-				queue.push_back(*i);
+				if (mt) push_ready(current_thread_index, *i); else single_ready_tasks.push(*i);
 				++(mt ? signals : single_signals);
 			} else {
 				wait.insert(*i);
@@ -404,16 +520,17 @@ RenderQueue::remove_task(const Task::Handle &task)
 	bool found = false;
 	if (task) {
 		bool mt = task->get_allow_multithreading();
-		TaskQueue &queue = mt ? ready_tasks     : single_ready_tasks;
-		TaskSet   &wait  = mt ? not_ready_tasks : single_not_ready_tasks;
+		TaskSet &wait = mt ? not_ready_tasks : single_not_ready_tasks;
 
-		for(TaskQueue::iterator i = queue.begin(); i != queue.end(); ) {
-			if (*i == task) {
-				found = true;
-				i = queue.erase(i);
-			} else {
-				++i;
+		if (mt) {
+			for(WorkerQueueList::iterator q = worker_queues.begin(); q != worker_queues.end(); ++q) {
+				std::lock_guard<std::mutex> lock(q->mutex);
+				if (q->tasks.remove_if([&task](const Task::Handle &t) { return t == task; }))
+					found = true;
 			}
+		} else {
+			if (single_ready_tasks.remove_if([&task](const Task::Handle &t) { return t == task; }))
+				found = true;
 		}
 		if (wait.erase(task)) found = true;
 	}
@@ -462,7 +579,10 @@ void
 RenderQueue::clear()
 {
 	std::lock_guard<std::mutex> lock(mutex);
-	ready_tasks.clear();
+	for(WorkerQueueList::iterator q = worker_queues.begin(); q != worker_queues.end(); ++q) {
+		std::lock_guard<std::mutex> queue_lock(q->mutex);
+		q->tasks.clear();
+	}
 	single_ready_tasks.clear();
 	not_ready_tasks.clear();
 	single_not_ready_tasks.clear();
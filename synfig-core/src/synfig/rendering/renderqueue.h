@@ -30,11 +30,15 @@
 
 /* === H E A D E R S ======================================================= */
 
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <list>
+#include <set>
+#include <vector>
 
 #include <mutex>
 #include <condition_variable>
-#include <thread>
 
 #include "task.h"
 
@@ -49,31 +53,90 @@ namespace synfig
 namespace rendering
 {
 
+/*!	\class RenderQueue
+**	\brief Runs the tasks in the threads when their dependencies are done.
+**
+**	Every multithreaded worker has own queue of ready tasks.
+**	Tasks which became ready after the task is done are pushed to the queue
+**	of the thread which did the task, so they use the surfaces just written by this thread.
+**	Queues are binary heaps ordered by the priority of tasks (see Task::RendererData::priority),
+**	so the long chains of dependent tasks are started as soon as possible.
+**	The worker takes the task with the highest priority from own queue and, when it's empty,
+**	steals the task with the highest priority from the queues of other workers.
+**	Main mutex protects the dependencies of tasks and must be locked when the task is pushed,
+**	but the worker doesn't lock it to take the task.
+**	Thread 0 is reserved for tasks without multithreading support,
+**	they are queued in single_ready_tasks under the main mutex.
+**	Rendering threads are the long jobs of synfig::ThreadPool, they sleep via ThreadPool::wait(),
+**	so the generic jobs and the rendering tasks share the same limit of running threads.
+*/
 class RenderQueue
 {
 public:
-	typedef std::list<std::thread> ThreadList;
-	typedef std::map<int, Task::Handle> ThreadTaskMap;
+	typedef std::vector<Task::Handle> ThreadTaskList;
 	typedef std::set<Task::Handle> TaskSet;
 	typedef std::list<Task::Handle> TaskQueue;
 
 private:
+	//! Binary heap of ready tasks, pop() returns the task with the highest priority,
+	//! the last pushed task is the first among the tasks with the same priority
+	class ReadyQueue {
+	private:
+		struct Entry {
+			Task::Handle task;
+			long long index;
+			Entry(): index() { }
+			Entry(const Task::Handle &task, long long index): task(task), index(index) { }
+			bool operator<(const Entry &other) const;
+		};
+		std::vector<Entry> entries;
+		long long last_index;
+
+	public:
+		ReadyQueue(): last_index() { }
+
+		bool empty() const { return entries.empty(); }
+		void clear() { entries.clear(); }
+		void push(const Task::Handle &task);
+		Task::Handle pop();
+
+		//! Removes the tasks which satisfy \a pred, returns true if something was removed
+		template<typename T>
+		bool remove_if(T pred) {
+			typename std::vector<Entry>::iterator j = entries.begin();
+			for(typename std::vector<Entry>::iterator i = entries.begin(); i != entries.end(); ++i)
+				if (!pred(i->task)) { if (j != i) *j = *i; ++j; }
+			if (j == entries.end()) return false;
+			entries.erase(j, entries.end());
+			std::make_heap(entries.begin(), entries.end());
+			return true;
+		}
+	};
+
+	struct WorkerQueue {
+		std::mutex mutex;
+		ReadyQueue tasks;
+	};
+	typedef std::deque<WorkerQueue> WorkerQueueList;
+
 	static int last_batch_index;
 
 	std::mutex mutex;
-	std::mutex threads_mutex;
 	std::condition_variable cond;
 	std::condition_variable single_cond;
+	std::condition_variable stopped_cond;
 
-	TaskQueue ready_tasks;
-	TaskQueue single_ready_tasks;
+	WorkerQueueList worker_queues;
+	ReadyQueue single_ready_tasks;
 	TaskSet not_ready_tasks;
 	TaskSet single_not_ready_tasks;
 
-	bool started;
+	std::atomic<bool> started;
+	int next_worker_queue;
 
-	ThreadList threads;
-	ThreadTaskMap tasks_in_process;
+	int threads_count;
+	int running_threads;
+	ThreadTaskList tasks_in_process;
 
 	void start();
 	void stop();
@@ -82,6 +145,11 @@ private:
 	void done(int thread_index, const Task::Handle &task);
 	Task::Handle get(int thread_index);
 
+	// main mutex must be locked to push
+	void push_ready(int thread_index, const Task::Handle &task);
+	Task::Handle pop_ready(int thread_index);
+	bool has_ready();
+
 	static void fix_task(const Task &task, const Task::RunParams &params);
 	bool remove_if_orphan(const Task::Handle &task, bool in_queue);
 	void remove_orphans();
@@ -41,6 +41,8 @@
 
 #include "blurtemplates.h"
 #include "fft.h"
+
+#include <synfig/threadpool.h>
 //#include "blur_iir_coefficients.cpp"
 #endif
 
@@ -51,8 +53,41 @@ using namespace rendering;
 
 /* === G L O B A L S ======================================================= */
 
+namespace {
+	//! Columns per band of the column pass, 16 pixels of 4 channels are 4 cache lines per row
+	const int box_column_block = 16;
+	//! Images with less pixels are blurred in the current thread
+	const int min_parallel_pixels = 256*256;
+}
+
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+	typedef std::function<void(int, int)> BandFunc;
+
+	void
+	process_bands(const BandFunc *func, int begin, int end)
+		{ (*func)(begin, end); }
+
+	//! Splits [0, count) into the bands and processes them in the ThreadPool
+	void
+	run_bands(int count, int pixels, const BandFunc &func)
+	{
+		int threads = pixels < min_parallel_pixels ? 1
+		            : std::min(count, ThreadPool::instance().get_max_threads());
+		if (threads <= 1) {
+			if (count > 0) func(0, count);
+			return;
+		}
+
+		ThreadPool::Group group;
+		for(int i = 0; i < threads; ++i)
+			group.enqueue( sigc::bind( sigc::ptr_fun(&process_bands),
+				&func, i*count/threads, (i + 1)*count/threads ));
+		group.run();
+	}
+}
+
 /* === M E T H O D S ======================================================= */
 
 bool
@@ -465,7 +500,6 @@ software::Blur::blur_fft(const Params &params)
 void
 software::Blur::blur_box(const Params &params)
 {
-	const Real precision(1e-5);
 	const int channels = 4;
 	int rows = params.src_rect.get_size()[1];
 	int cols = params.src_rect.get_size()[0];
@@ -498,7 +532,6 @@ software::Blur::blur_box(const Params &params)
 		return;
 	}
 
-	std::deque<ColorReal> q;
 	std::vector<ColorReal> surface_copy;
 	Array<ColorReal, 3> arr_surface_rows(arr_surface.reorder(2, 0, 1));
 	Array<ColorReal, 3> arr_surface_cols(arr_surface_rows.reorder(0, 2, 1));
@@ -510,27 +543,33 @@ software::Blur::blur_box(const Params &params)
 		arr_surface_cols.pointer = &surface_copy.front();
 	}
 
-	if (true || fabs(size[0] - round(size[0])) < precision)
-		for(Array<ColorReal, 3>::Iterator channel(arr_surface_rows); channel; ++channel)
-			for(Array<ColorReal, 2>::Iterator r(*channel); r; ++r)
-				for(int i = 0; i < count; ++i)
-					BlurTemplates::blur_box_discrete(*r, q, (int)round(size[0]));
-	else
-		for(Array<ColorReal, 3>::Iterator channel(arr_surface_rows); channel; ++channel)
-			for(Array<ColorReal, 2>::Iterator r(*channel); r; ++r)
-				for(int i = 0; i < count; ++i)
-					BlurTemplates::blur_box_aa(*r, q, (ColorReal)size[0]);
-
-	if (true || fabs(size[1] - round(size[1])) < precision)
-		for(Array<ColorReal, 3>::Iterator channel(arr_surface_cols); channel; ++channel)
-			for(Array<ColorReal, 2>::Iterator c(*channel); c; ++c)
-				for(int i = 0; i < count; ++i)
-					BlurTemplates::blur_box_discrete(*c, q, (int)round(size[1]));
-	else
-		for(Array<ColorReal, 3>::Iterator channel(arr_surface_cols); channel; ++channel)
-			for(Array<ColorReal, 2>::Iterator c(*channel); c; ++c)
-				for(int i = 0; i < count; ++i)
-					BlurTemplates::blur_box_aa(*c, q, (ColorReal)size[1]);
+	// all channels of pixel are blurred together,
+	// column pass goes row by row through the bands of neighbour columns
+	int size_x = (int)round(size[0]);
+	int size_y = (int)round(size[1]);
+	int passes = count;
+	ColorReal *rows_data = arr_surface_rows.pointer;
+	ColorReal *cols_data = arr_surface_cols.pointer;
+
+	run_bands(rows, rows*cols, [=](int begin, int end) {
+		std::vector<ColorReal> buffer;
+		for(int r = begin; r < end; ++r)
+			for(int i = 0; i < passes; ++i)
+				BlurTemplates::blur_box_discrete_lanes(
+					rows_data + r*cols*channels, channels, channels, cols, buffer, size_x );
+	});
+
+	run_bands((cols + box_column_block - 1)/box_column_block, rows*cols, [=](int begin, int end) {
+		std::vector<ColorReal> buffer;
+		for(int b = begin; b < end; ++b)
+		{
+			int c0 = b*box_column_block;
+			int c1 = std::min(c0 + box_column_block, cols);
+			for(int i = 0; i < passes; ++i)
+				BlurTemplates::blur_box_discrete_lanes(
+					cols_data + c0*channels, cols*channels, (c1 - c0)*channels, rows, buffer, size_y );
+		}
+	});
 
 	if (cross)
 		arr_surface_rows
@@ -34,10 +34,16 @@
 
 #include <algorithm>
 #include <deque>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "array.h"
 
 #include <synfig/angle.h>
+#include <synfig/rect.h>
 #include <synfig/surface.h>
 
 /* === M A C R O S ========================================================= */
@@ -349,6 +355,71 @@ public:
 		}
 	}
 
+	template<typename T>
+	static void blur_box_lanes_step(T *dst, const T *src, T *ring, T *sum, int lanes, const T &w)
+	{
+		for(int l = 0; l < lanes; ++l)
+		{
+			dst[l] = w*sum[l];
+			sum[l] += src[l] - ring[l];
+			ring[l] = src[l];
+		}
+	}
+
+#ifdef __SSE2__
+	static void blur_box_lanes_step(float *dst, const float *src, float *ring, float *sum, int lanes, const float &w)
+	{
+		int l = 0;
+		__m128 ww = _mm_set1_ps(w);
+		for(; l + 4 <= lanes; l += 4)
+		{
+			__m128 s = _mm_loadu_ps(sum + l);
+			__m128 v = _mm_loadu_ps(src + l);
+			_mm_storeu_ps(dst + l, _mm_mul_ps(ww, s));
+			_mm_storeu_ps(sum + l, _mm_add_ps(s, _mm_sub_ps(v, _mm_loadu_ps(ring + l))));
+			_mm_storeu_ps(ring + l, v);
+		}
+		for(; l < lanes; ++l)
+		{
+			dst[l] = w*sum[l];
+			sum[l] += src[l] - ring[l];
+			ring[l] = src[l];
+		}
+	}
+#endif
+
+	//! Same as blur_box_discrete() for several lanes at once, results are bit-identical.
+	//! Lanes are stored continuously, \a stride is the distance between
+	//! the neighbour items of the lane, so the column of the surface
+	//! may be processed together with its neighbours row by row.
+	template<typename T>
+	static void blur_box_discrete_lanes(T *x, int stride, int lanes, int count, std::vector<T> &buffer, const int size)
+	{
+		if (size == 0) return;
+
+		int s = abs(size);
+		int full_size = 1 + 2*s;
+		if (count < full_size) return;
+		T w(T(1.0)/T(full_size));
+
+		// ring of the source values which are not overwritten yet, and sums
+		buffer.assign((full_size + 1)*lanes, T(0.0));
+		T *sum = &buffer[full_size*lanes];
+		for(int i = 0; i < full_size; ++i)
+		{
+			const T *src = x + i*stride;
+			T *ring = &buffer[i*lanes];
+			for(int l = 0; l < lanes; ++l)
+				{ ring[l] = src[l]; sum[l] += src[l]; }
+		}
+
+		for(int i = full_size, j = s, k = 0; i < count; ++i, ++j)
+		{
+			blur_box_lanes_step(x + j*stride, x + i*stride, &buffer[k*lanes], sum, lanes, w);
+			if (++k == full_size) k = 0;
+		}
+	}
+
 	template<typename T>
 	static void blur_box_discrete(const Array<T, 1> &dst, const Array<const T, 1> &src, const int size, const int offset)
 	{
@@ -34,7 +34,12 @@
 
 #include "contour.h"
 
+#include <climits>
+
+#include <algorithm>
+
 #include <synfig/debug/debugsurface.h>
+#include <synfig/threadpool.h>
 
 #endif
 
@@ -47,12 +52,67 @@ using namespace rendering;
 
 /* === P R O C E D U R E S ================================================= */
 
+namespace {
+	typedef Polyspan::cover_array::const_iterator MarkIterator;
+
+	//! Less rows are rendered in the current thread
+	const int min_parallel_rows = 64;
+	//! Less marks and pixels are rendered in the current thread
+	const size_t min_parallel_marks = 4096;
+	const long long min_parallel_pixels = 512*512;
+
+	void
+	fill_hline(synfig::Surface &surface, synfig::Surface::alpha_pen &p, const Color &color, int l)
+	{
+		if (l <= 0) return;
+		surface.fill(color, p, l, 1);
+		p.inc_x(l);
+	}
+
+	struct Band {
+		RectInt window;
+		MarkIterator begin;
+		MarkIterator end;
+	};
+
+	struct BandParams {
+		synfig::Surface *target_surface;
+		const Polyspan *polyspan;
+		bool invert;
+		bool antialias;
+		rendering::Contour::WindingStyle winding_style;
+		Color color;
+		Color::value_type opacity;
+		Color::BlendMethod blend_method;
+	};
+
+	void
+	render_band(const BandParams *params, const Band *band)
+	{
+		software::Contour::render_rows(
+			*params->target_surface,
+			*params->polyspan,
+			band->window,
+			band->begin,
+			band->end,
+			params->invert,
+			params->antialias,
+			params->winding_style,
+			params->color,
+			params->opacity,
+			params->blend_method );
+	}
+}
+
 /* === M E T H O D S ======================================================= */
 
 void
-software::Contour::render_polyspan(
+software::Contour::render_rows(
 	synfig::Surface &target_surface,
 	const Polyspan &polyspan,
+	const RectInt &window,
+	Polyspan::cover_array::const_iterator cur_mark,
+	Polyspan::cover_array::const_iterator end_mark,
 	bool invert,
 	bool antialias,
 	rendering::Contour::WindingStyle winding_style,
@@ -65,11 +125,6 @@ software::Contour::render_polyspan(
 
 	synfig::Surface::alpha_pen p(target_surface.begin(), opacity, blend_method);
 	synfig::Surface::pen sp(target_surface.begin());
-	const RectInt &window = polyspan.get_window();
-	const Polyspan::cover_array &covers = polyspan.get_covers();
-
-	Polyspan::cover_array::const_iterator cur_mark = covers.begin();
-	Polyspan::cover_array::const_iterator end_mark = covers.end();
 
 	Real cover = 0, area = 0, alpha = 0;
 	int	y = 0, x = 0;
@@ -91,7 +146,7 @@ software::Contour::render_polyspan(
 			else
 			{
 				p.move_to(window.minx, window.miny);
-				p.put_block(window.maxy - window.miny, window.maxx - window.minx);
+				target_surface.fill(color, p, window.maxx - window.minx, window.maxy - window.miny);
 			}
 		}
 		return;
@@ -121,12 +176,12 @@ software::Contour::render_polyspan(
 			y = window.miny;
 			int l = window.maxx - window.minx;
 
-			p.put_block(cur_mark->y - window.miny, l);
+			target_surface.fill(color, p, l, cur_mark->y - window.miny);
 
 			// fill the area to the left of the first vertex on that line
 			l = cur_mark->x - window.minx;
 			p.move_to(window.minx, cur_mark->y);
-			if (l) p.put_hline(l);
+			if (l) fill_hline(target_surface, p, color, l);
 		}
 	}
 
@@ -141,7 +196,7 @@ software::Contour::render_polyspan(
 		cover += cur_mark->cover;
 
 		// accumulate for the current pixel
-		while(++cur_mark != covers.end())
+		while(++cur_mark != end_mark)
 		{
 			if (y != cur_mark->y || x != cur_mark->x)
 				break;
@@ -185,7 +240,7 @@ software::Contour::render_polyspan(
 				}
 				else
 				{
-					p.put_hline(window.maxx - x);
+					fill_hline(target_surface, p, color, window.maxx - x);
 				}
 
 				// fill any empty line until next mark
@@ -199,7 +254,7 @@ software::Contour::render_polyspan(
 					else
 					{
 						p.move_to(window.minx, y);
-						p.put_block(cur_mark->y - y, window.maxx - window.minx);
+						target_surface.fill(color, p, window.maxx - window.minx, cur_mark->y - y);
 					}
 				}
 
@@ -212,7 +267,7 @@ software::Contour::render_polyspan(
 				else
 				{
 					p.move_to(window.minx, cur_mark->y);
-					p.put_hline(cur_mark->x - window.minx);
+					fill_hline(target_surface, p, color, cur_mark->x - window.minx);
 				}
 			}
 
@@ -235,7 +290,7 @@ software::Contour::render_polyspan(
 				}
 				else
 				{
-					p.put_hline(cur_mark->x - x);
+					fill_hline(target_surface, p, color, cur_mark->x - x);
 				}
 			}
 
@@ -269,15 +324,68 @@ software::Contour::render_polyspan(
 		else
 		{
 			//fill the area at the end of the line
-			p.put_hline(window.maxx - x);
+			fill_hline(target_surface, p, color, window.maxx - x);
 
 			//fill area at the beginning of the next line
 			p.move_to(window.minx, y+1);
-			p.put_block(window.maxy - y - 1, window.maxx - window.minx);
+			target_surface.fill(color, p, window.maxx - window.minx, window.maxy - y - 1);
 		}
 	}
 }
 
+void
+software::Contour::render_polyspan(
+	synfig::Surface &target_surface,
+	const Polyspan &polyspan,
+	bool invert,
+	bool antialias,
+	rendering::Contour::WindingStyle winding_style,
+	const Color &color,
+	Color::value_type opacity,
+	Color::BlendMethod blend_method )
+{
+	const RectInt &window = polyspan.get_window();
+	const Polyspan::cover_array &covers = polyspan.get_covers();
+
+	// rows are independent, so horizontal bands are rendered in parallel
+	int rows = window.maxy - window.miny;
+	long long pixels = (long long)rows*(window.maxx - window.minx);
+	int threads = (covers.size() < min_parallel_marks && pixels < min_parallel_pixels) || rows < min_parallel_rows
+	            ? 1 : std::min(ThreadPool::instance().get_max_threads(), rows/(min_parallel_rows/2));
+	if (threads <= 1)
+	{
+		render_rows(
+			target_surface, polyspan, window, covers.begin(), covers.end(),
+			invert, antialias, winding_style, color, opacity, blend_method );
+		return;
+	}
+
+	BandParams params = {
+		&target_surface, &polyspan, invert, antialias,
+		winding_style, color, opacity, blend_method };
+
+	// marks out of window (if any) go to the first and to the last bands
+	std::vector<Band> bands(threads);
+	MarkIterator mark = covers.begin();
+	for(int i = 0; i < threads; ++i)
+	{
+		Band &band = bands[i];
+		band.window = window;
+		band.window.miny = window.miny + (int)((long long)rows*i/threads);
+		band.window.maxy = window.miny + (int)((long long)rows*(i + 1)/threads);
+		band.begin = mark;
+		band.end = i + 1 == threads ? covers.end()
+		         : std::lower_bound(mark, covers.end(), Polyspan::PenMark(INT_MIN, band.window.maxy, 0, 0));
+		mark = band.end;
+	}
+
+	ThreadPool::Group group;
+	for(std::vector<Band>::const_iterator i = bands.begin(); i != bands.end(); ++i)
+		group.enqueue( sigc::bind( sigc::ptr_fun(&render_band), &params, &*i ),
+			1.0 + (Real)(i->end - i->begin)/(Real)covers.size() );
+	group.run();
+}
+
 void
 software::Contour::build_polyspan(
 	const rendering::Contour::ChunkList &chunks,
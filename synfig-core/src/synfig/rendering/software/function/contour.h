@@ -51,6 +51,21 @@ namespace software
 class Contour
 {
 public:
+	//! Renders rows [window.miny, window.maxy) using the sorted marks [cur_mark, end_mark),
+	//! the bands of rows may be rendered independently
+	static void render_rows(
+		synfig::Surface &target_surface,
+		const Polyspan &polyspan,
+		const RectInt &window,
+		Polyspan::cover_array::const_iterator cur_mark,
+		Polyspan::cover_array::const_iterator end_mark,
+		bool invert,
+		bool antialias,
+		rendering::Contour::WindingStyle winding_style,
+		const Color &color,
+		Color::value_type opacity,
+		Color::BlendMethod blend_method );
+
 	static void render_polyspan(
 		synfig::Surface &target_surface,
 		const Polyspan &polyspan,
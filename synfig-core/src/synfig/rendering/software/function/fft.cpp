@@ -36,6 +36,10 @@
 #include <climits>
 //#include <ccomplex>
 
+#include <cstdlib>
+
+#include <map>
+#include <memory>
 #include <mutex>
 
 #include <vector>
@@ -43,6 +47,8 @@
 
 #include <fftw3.h>
 
+#include <synfig/general.h>
+
 #include "fft.h"
 
 #endif
@@ -61,12 +67,80 @@ using namespace rendering;
 class software::FFT::Internal
 {
 public:
+	//! Destroys the plan under the planner lock, must not be released while the lock is held
+	class Plan {
+	public:
+		const fftw_plan plan;
+		explicit Plan(fftw_plan plan): plan(plan) { }
+		~Plan() { std::lock_guard<std::mutex> lock(mutex); fftw_destroy_plan(plan); }
+	};
+
+	typedef std::shared_ptr<Plan> PlanHandle;
+	typedef std::vector<int> PlanKey;
+	typedef std::map<PlanKey, PlanHandle> PlanMap;
+
+	enum { MaxPlans = 256 };
+
 	static std::set<int> counts;
-	static std::mutex mutex;
+	static std::mutex mutex; //!< FFTW planner is not thread-safe
+	static PlanMap plans;
+	static String wisdom_filename;
+
+	static void push_iodims(PlanKey &key, int rank, const fftw_iodim *dims) {
+		key.push_back(rank);
+		for(int i = 0; i < rank; ++i)
+			key.push_back(dims[i].n), key.push_back(dims[i].is), key.push_back(dims[i].os);
+	}
+
+	//! Executes in-place transform, plans are made once for each
+	//! combination of sizes, strides, direction and alignment of data
+	static void execute(
+		int rank, const fftw_iodim *dims,
+		int howmany_rank, const fftw_iodim *howmany_dims,
+		Complex *data, bool invert )
+	{
+		fftw_complex *d = (fftw_complex*)data;
+		int sign = invert ? FFTW_BACKWARD : FFTW_FORWARD;
+
+		PlanKey key;
+		key.reserve(4 + 3*(rank + howmany_rank));
+		key.push_back(sign);
+		key.push_back(fftw_alignment_of((double*)d));
+		push_iodims(key, rank, dims);
+		push_iodims(key, howmany_rank, howmany_dims);
+
+		PlanHandle plan;
+		PlanMap dropped_plans; // destroyed after unlocking
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			PlanMap::const_iterator i = plans.find(key);
+			if (i != plans.end()) {
+				plan = i->second;
+			} else {
+				// measured plans are used only from wisdom, measuring would overwrite the data
+				fftw_plan p = nullptr;
+				if (!wisdom_filename.empty())
+					p = fftw_plan_guru_dft(rank, dims, howmany_rank, howmany_dims, d, d, sign, FFTW_MEASURE | FFTW_WISDOM_ONLY);
+				if (!p)
+					p = fftw_plan_guru_dft(rank, dims, howmany_rank, howmany_dims, d, d, sign, FFTW_ESTIMATE);
+				if (!p) {
+					synfig::error("rendering::software::FFT cannot create plan");
+					return;
+				}
+				if (plans.size() >= MaxPlans)
+					dropped_plans.swap(plans);
+				plan = plans[key] = std::make_shared<Plan>(p);
+			}
+		}
+
+		fftw_execute_dft(plan->plan, d, d);
+	}
 };
 
 std::set<int> software::FFT::Internal::counts;
 std::mutex software::FFT::Internal::mutex;
+software::FFT::Internal::PlanMap software::FFT::Internal::plans;
+String software::FFT::Internal::wisdom_filename;
 
 void
 software::FFT::initialize()
@@ -81,11 +155,27 @@ software::FFT::initialize()
 				for(int c7 = c5; c7 < max7; c7 *= 7)
 					Internal::counts.insert(c7);
 	fftw_set_timelimit(0.0);
+
+	// file to load the FFTW wisdom from, and to save it back at exit
+	if (const char *s = getenv("SYNFIG_RENDERING_FFTW_WISDOM")) {
+		std::lock_guard<std::mutex> lock(Internal::mutex);
+		Internal::wisdom_filename = s;
+		if (!fftw_import_wisdom_from_filename(s))
+			synfig::info("rendering::software::FFT cannot load wisdom from '%s'", s);
+	}
 }
 
 void
 software::FFT::deinitialize()
 {
+	Internal::PlanMap plans;
+	{
+		std::lock_guard<std::mutex> lock(Internal::mutex);
+		plans.swap(Internal::plans);
+		if (!Internal::wisdom_filename.empty() && !fftw_export_wisdom_to_filename(Internal::wisdom_filename.c_str()))
+			synfig::warning("rendering::software::FFT cannot save wisdom to '%s'", Internal::wisdom_filename.c_str());
+		Internal::wisdom_filename.clear();
+	}
 	Internal::counts.clear();
 }
 
@@ -120,15 +210,7 @@ software::FFT::fft(const Array<Complex, 1> &x, bool invert)
 	iodim.is = x.stride;
 	iodim.os = x.stride;
 
-	{
-		std::lock_guard<std::mutex> lock(Internal::mutex);
-		fftw_plan plan = fftw_plan_guru_dft(
-			1, &iodim, 0, nullptr,
-			(fftw_complex*)x.pointer, (fftw_complex*)x.pointer,
-			invert ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_ESTIMATE );
-		fftw_execute(plan);
-		fftw_destroy_plan(plan);
-	}
+	Internal::execute(1, &iodim, 0, nullptr, x.pointer, invert);
 
 	// divide by count to complete back-FFT
 	if (invert)
@@ -155,27 +237,10 @@ software::FFT::fft2d(const Array<Complex, 2> &x, bool invert, bool do_rows, bool
 	iodim[1].is = x.stride;
 	iodim[1].os = x.stride;
 
-	{
-		std::lock_guard<std::mutex> lock(Internal::mutex);
-
-		fftw_plan plan;
-		if (do_rows && do_cols)
-		{
-			plan = fftw_plan_guru_dft(
-				2, iodim, 0, nullptr,
-				(fftw_complex*)x.pointer, (fftw_complex*)x.pointer,
-				invert ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_ESTIMATE );
-		}
-		else
-		{
-			plan = fftw_plan_guru_dft(
-				1, &iodim[do_rows ? 0 : 1], 1, &iodim[do_rows ? 1 : 0],
-				(fftw_complex*)x.pointer, (fftw_complex*)x.pointer,
-				invert ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_ESTIMATE );
-		}
-		fftw_execute(plan);
-		fftw_destroy_plan(plan);
-	}
+	if (do_rows && do_cols)
+		Internal::execute(2, iodim, 0, nullptr, x.pointer, invert);
+	else
+		Internal::execute(1, &iodim[do_rows ? 0 : 1], 1, &iodim[do_rows ? 1 : 0], x.pointer, invert);
 
 	// divide by count to complete back-FFT
 	if (invert)
@@ -58,7 +58,9 @@ public:
 	static void fft(const Array<Complex, 1> &x, bool invert);
 	static void fft2d(const Array<Complex, 2> &x, bool invert, bool do_rows = true, bool do_cols = true);
 
+	//! Loads FFTW wisdom from file set by SYNFIG_RENDERING_FFTW_WISDOM environment variable
 	static void initialize();
+	//! Saves FFTW wisdom back to the file and releases cached plans
 	static void deinitialize();
 };
 
@@ -43,7 +43,9 @@
 #include "../common/optimizer/optimizerblendtotarget.h"
 #include "../common/optimizer/optimizerdraft.h"
 #include "../common/optimizer/optimizerlist.h"
+#include "../common/optimizer/optimizerpixelprocessormerge.h"
 #include "../common/optimizer/optimizersplit.h"
+#include "../common/optimizer/optimizersurfacecache.h"
 #include "../common/optimizer/optimizertransformation.h"
 #include "../common/optimizer/optimizerpass.h"
 
@@ -93,7 +95,9 @@ RendererDraftSW::RendererDraftSW()
 	register_optimizer(new OptimizerDraftLayerSkip("xor_pattern"));
 
 	register_optimizer(new OptimizerTransformation());
+	register_optimizer(new OptimizerPixelProcessorMerge());
 	register_optimizer(new OptimizerDraftTransformation());
+	register_optimizer(new OptimizerSurfaceCache("draft"));
 
 	register_optimizer(new OptimizerPass(false));
 	register_optimizer(new OptimizerPass(true));
@@ -101,7 +105,7 @@ RendererDraftSW::RendererDraftSW()
 	register_optimizer(new OptimizerBlendToTarget());
 	register_optimizer(new OptimizerList());
 	register_optimizer(new OptimizerBlendAssociative());
-	//register_optimizer(new OptimizerSplit());
+	register_optimizer(new OptimizerSplit());
 }
 
 String RendererDraftSW::get_name() const
@@ -43,7 +43,9 @@
 #include "../common/optimizer/optimizerblendtotarget.h"
 #include "../common/optimizer/optimizerdraft.h"
 #include "../common/optimizer/optimizerlist.h"
+#include "../common/optimizer/optimizerpixelprocessormerge.h"
 #include "../common/optimizer/optimizersplit.h"
+#include "../common/optimizer/optimizersurfacecache.h"
 #include "../common/optimizer/optimizertransformation.h"
 #include "../common/optimizer/optimizerpass.h"
 
@@ -68,7 +70,9 @@ RendererLowResSW::RendererLowResSW(int level):
 	// register optimizers
 	register_optimizer(new OptimizerDraftLowRes(level));
 	register_optimizer(new OptimizerTransformation());
+	register_optimizer(new OptimizerPixelProcessorMerge());
 	register_optimizer(new OptimizerDraftTransformation());
+	register_optimizer(new OptimizerSurfaceCache(strprintf("lowres%d", level)));
 
 	register_optimizer(new OptimizerPass(false));
 	register_optimizer(new OptimizerPass(true));
@@ -76,7 +80,7 @@ RendererLowResSW::RendererLowResSW(int level):
 	register_optimizer(new OptimizerBlendToTarget());
 	register_optimizer(new OptimizerList());
 	register_optimizer(new OptimizerBlendAssociative());
-	//register_optimizer(new OptimizerSplit());
+	register_optimizer(new OptimizerSplit());
 }
 
 String RendererLowResSW::get_name() const
@@ -42,7 +42,9 @@
 #include "../common/optimizer/optimizerblendmerge.h"
 #include "../common/optimizer/optimizerblendtotarget.h"
 #include "../common/optimizer/optimizerlist.h"
+#include "../common/optimizer/optimizerpixelprocessormerge.h"
 #include "../common/optimizer/optimizersplit.h"
+#include "../common/optimizer/optimizersurfacecache.h"
 #include "../common/optimizer/optimizertransformation.h"
 #include "../common/optimizer/optimizerpass.h"
 
@@ -67,6 +69,8 @@ RendererSW::RendererSW()
 
 	// register optimizers
 	register_optimizer(new OptimizerTransformation());
+	register_optimizer(new OptimizerPixelProcessorMerge());
+	register_optimizer(new OptimizerSurfaceCache("sw"));
 
 	register_optimizer(new OptimizerPass(false));
 	register_optimizer(new OptimizerPass(true));
@@ -74,7 +78,7 @@ RendererSW::RendererSW()
 	register_optimizer(new OptimizerList());
 	register_optimizer(new OptimizerBlendToTarget());
 	register_optimizer(new OptimizerBlendAssociative());
-	//register_optimizer(new OptimizerSplit());
+	register_optimizer(new OptimizerSplit());
 }
 
 RendererSW::~RendererSW() { }
@@ -34,6 +34,9 @@
 
 #include "surfacesw.h"
 
+#include "../renderer.h"
+#include "../surfacepool.h"
+
 #endif
 
 using namespace synfig;
@@ -54,12 +57,16 @@ rendering::Surface::Token SurfaceSW::token(
 
 SurfaceSW::SurfaceSW():
 	own_surface(true),
-	surface(new synfig::Surface())
+	surface(new synfig::Surface()),
+	pool_buffer(),
+	pool_buffer_size()
 { }
 
 SurfaceSW::SurfaceSW(synfig::Surface &surface, bool own_surface):
 	own_surface(own_surface),
-	surface(&surface)
+	surface(&surface),
+	pool_buffer(),
+	pool_buffer_size()
 {
 	assert(this->surface);
 	set_desc(this->surface->get_w(), this->surface->get_h(), false);
@@ -71,14 +78,46 @@ SurfaceSW::~SurfaceSW()
 	if (own_surface)
 		{ assert(surface); delete surface; }
 	surface = nullptr;
+	set_pool_buffer(nullptr, 0);
 	set_desc(0, 0, true);
 }
 
+void
+SurfaceSW::set_pool_buffer(Color *buffer, size_t size)
+{
+	if (pool_buffer)
+		Renderer::get_surface_pool().free(pool_buffer, pool_buffer_size);
+	pool_buffer = buffer;
+	pool_buffer_size = size;
+}
+
+void
+SurfaceSW::alloc_surface(int width, int height)
+{
+	assert(surface);
+	if (!own_surface) {
+		// external surface manages its memory by itself
+		surface->set_wh(width, height);
+		return;
+	}
+
+	if ( pool_buffer
+	  && surface->get_w() == width
+	  && surface->get_h() == height
+	  && &(*surface)[0][0] == pool_buffer )
+		return;
+
+	size_t size = size_t(width)*size_t(height)*sizeof(Color);
+	Color *buffer = static_cast<Color*>(Renderer::get_surface_pool().alloc(size));
+	delete surface;
+	surface = new synfig::Surface(buffer, width, height);
+	set_pool_buffer(buffer, size);
+}
+
 bool
 SurfaceSW::create_vfunc(int width, int height)
 {
-	assert(surface);
-	surface->set_wh(width, height);
+	alloc_surface(width, height);
 	surface->clear();
 	return true;
 }
@@ -86,11 +125,10 @@ SurfaceSW::create_vfunc(int width, int height)
 bool
 SurfaceSW::assign_vfunc(const rendering::Surface &surface)
 {
-	assert(this->surface);
-	this->surface->set_wh(surface.get_width(), surface.get_height());
+	alloc_surface(surface.get_width(), surface.get_height());
 	if (surface.get_pixels(&(*this->surface)[0][0]))
 		return true;
-	this->surface->set_wh(0, 0);
+	reset_vfunc();
 	set_desc(0, 0, true);
 	return false;
 }
@@ -107,7 +145,13 @@ bool
 SurfaceSW::reset_vfunc()
 {
 	assert(surface);
-	surface->set_wh(0, 0);
+	if (own_surface && pool_buffer) {
+		delete surface;
+		surface = new synfig::Surface();
+		set_pool_buffer(nullptr, 0);
+	} else {
+		surface->set_wh(0, 0);
+	}
 	return true;
 }
 
@@ -123,6 +167,11 @@ void
 SurfaceSW::set_surface(synfig::Surface &surface, bool own_surface)
 {
 	if (&surface == this->surface) {
+		if (!own_surface && pool_buffer) {
+			// the pool buffer will be released, so surface should get own memory
+			surface = synfig::Surface(surface);
+			set_pool_buffer(nullptr, 0);
+		}
 		this->own_surface = own_surface;
 		return;
 	}
@@ -131,6 +180,7 @@ SurfaceSW::set_surface(synfig::Surface &surface, bool own_surface)
 		assert(this->surface);
 		delete(this->surface);
 	}
+	set_pool_buffer(nullptr, 0);
 
 	this->surface = &surface;
 	assert(this->surface);
@@ -145,6 +195,7 @@ SurfaceSW::reset_surface()
 		assert(surface);
 		delete(surface);
 	}
+	set_pool_buffer(nullptr, 0);
 	own_surface = true;
 	surface = new synfig::Surface();
 	set_desc(0, 0, true);
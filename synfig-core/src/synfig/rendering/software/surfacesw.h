@@ -57,6 +57,11 @@ public:
 private:
 	bool own_surface;
 	synfig::Surface *surface;
+	Color *pool_buffer; //!< memory of own surface taken from Renderer::get_surface_pool()
+	size_t pool_buffer_size;
+
+	void set_pool_buffer(Color *buffer, size_t size);
+	void alloc_surface(int width, int height);
 
 protected:
 	virtual bool create_vfunc(int width, int height);
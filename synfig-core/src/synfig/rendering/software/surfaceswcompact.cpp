@@ -0,0 +1,203 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/surfaceswcompact.cpp
+**	\brief SurfaceSWCompact
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "surfaceswcompact.h"
+
+#endif
+
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	inline std::uint32_t float_bits(float x)
+		{ std::uint32_t i; memcpy(&i, &x, sizeof(i)); return i; }
+	inline float bits_float(std::uint32_t i)
+		{ float x; memcpy(&x, &i, sizeof(x)); return x; }
+}
+
+/* === M E T H O D S ======================================================= */
+
+
+rendering::Surface::Token SurfaceSWCompact::token(
+	Desc<SurfaceSWCompact>("SurfaceSWCompact") );
+
+
+SurfaceSWCompact::Half
+SurfaceSWCompact::float_to_half(float x)
+{
+	// round to nearest even, as the hardware conversion does
+	std::uint32_t f = float_bits(x);
+	std::uint32_t sign = f & 0x80000000u;
+	f ^= sign;
+
+	std::uint32_t h;
+	if (f >= 0x47800000u) {
+		// too big for half, infinity or NaN
+		h = f > 0x7f800000u ? 0x7e00u : 0x7c00u;
+	} else
+	if (f < 0x38800000u) {
+		// subnormal half or zero, let the float adder do the rounding
+		const std::uint32_t magic = 126u << 23;
+		h = float_bits(bits_float(f) + bits_float(magic)) - magic;
+	} else {
+		std::uint32_t odd = (f >> 13) & 1u;
+		f += ((std::uint32_t)(15 - 127) << 23) + 0xfffu + odd;
+		h = f >> 13;
+	}
+	return (Half)(h | (sign >> 16));
+}
+
+float
+SurfaceSWCompact::half_to_float(Half x)
+{
+	const float magic = bits_float((254u - 15u) << 23);
+	const float infinity_or_nan = bits_float((127u + 16u) << 23);
+
+	// rescaling of exponent handles subnormal values too
+	float f = bits_float((std::uint32_t)(x & 0x7fffu) << 13)*magic;
+	std::uint32_t bits = float_bits(f);
+	if (f >= infinity_or_nan)
+		bits |= 255u << 23;
+	return bits_float(bits | ((std::uint32_t)(x & 0x8000u) << 16));
+}
+
+void
+SurfaceSWCompact::pack(Half *r, Half *g, Half *b, Half *a, const Color *src, int count)
+{
+	int i = 0;
+#ifdef __F16C__
+	for(; i + 4 <= count; i += 4) {
+		const float *s = reinterpret_cast<const float*>(src + i);
+		__m128 c0 = _mm_loadu_ps(s), c1 = _mm_loadu_ps(s + 4), c2 = _mm_loadu_ps(s + 8), c3 = _mm_loadu_ps(s + 12);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(r + i), _mm_cvtps_ph(c0, _MM_FROUND_TO_NEAREST_INT));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(g + i), _mm_cvtps_ph(c1, _MM_FROUND_TO_NEAREST_INT));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(b + i), _mm_cvtps_ph(c2, _MM_FROUND_TO_NEAREST_INT));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(a + i), _mm_cvtps_ph(c3, _MM_FROUND_TO_NEAREST_INT));
+	}
+#endif
+	for(; i < count; ++i) {
+		const Color &c = src[i];
+		r[i] = float_to_half(c.get_r());
+		g[i] = float_to_half(c.get_g());
+		b[i] = float_to_half(c.get_b());
+		a[i] = float_to_half(c.get_a());
+	}
+}
+
+void
+SurfaceSWCompact::unpack(Color *dst, const Half *r, const Half *g, const Half *b, const Half *a, int count)
+{
+	int i = 0;
+#ifdef __F16C__
+	for(; i + 4 <= count; i += 4) {
+		__m128 c0 = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(r + i)));
+		__m128 c1 = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(g + i)));
+		__m128 c2 = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + i)));
+		__m128 c3 = _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i)));
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		float *d = reinterpret_cast<float*>(dst + i);
+		_mm_storeu_ps(d, c0), _mm_storeu_ps(d + 4, c1), _mm_storeu_ps(d + 8, c2), _mm_storeu_ps(d + 12, c3);
+	}
+#endif
+	for(; i < count; ++i)
+		dst[i] = Color(half_to_float(r[i]), half_to_float(g[i]), half_to_float(b[i]), half_to_float(a[i]));
+}
+
+bool
+SurfaceSWCompact::create_vfunc(int width, int height)
+{
+	// zero bits are zero values
+	data.assign(4*width*height, 0);
+	return true;
+}
+
+bool
+SurfaceSWCompact::assign_vfunc(const rendering::Surface &surface)
+{
+	std::vector<Color> buffer;
+	const Color *pixels = surface.get_pixels_pointer();
+	if (!pixels) {
+		buffer.resize(surface.get_pixels_count());
+		if (!surface.get_pixels(&buffer.front()))
+			return false;
+		pixels = &buffer.front();
+	}
+
+	int count = surface.get_pixels_count();
+	data.resize(4*count);
+	Half *planes = &data.front();
+	pack(planes, planes + count, planes + 2*count, planes + 3*count, pixels, count);
+	return true;
+}
+
+bool
+SurfaceSWCompact::clear_vfunc()
+{
+	std::fill(data.begin(), data.end(), 0);
+	return true;
+}
+
+bool
+SurfaceSWCompact::reset_vfunc()
+{
+	std::vector<Half>().swap(data);
+	return true;
+}
+
+bool
+SurfaceSWCompact::get_pixels_vfunc(Color *buffer) const
+{
+	int count = get_pixels_count();
+	if ((int)data.size() != 4*count)
+		return false;
+	const Half *planes = &data.front();
+	unpack(buffer, planes, planes + count, planes + 2*count, planes + 3*count, count);
+	return true;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,105 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/surfaceswcompact.h
+**	\brief SurfaceSWCompact Header
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_SURFACESWCOMPACT_H
+#define __SYNFIG_RENDERING_SURFACESWCOMPACT_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <cstdint>
+#include <vector>
+
+#include "../surface.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+/*!	\class SurfaceSWCompact
+**	\brief Keeps the pixels as four planes of half-precision floats.
+**
+**	Takes a half of the memory of SurfaceSW, values keep about three
+**	significant decimal digits, it is enough for the surfaces
+**	that will be converted to 8 or 10 bits per channel.
+**	Values over 65504 become infinite.
+**	Tasks cannot draw into it, use it to keep the results which are
+**	rarely read, SurfaceResource converts it to SurfaceSW on demand.
+*/
+class SurfaceSWCompact: public Surface
+{
+public:
+	typedef etl::handle<SurfaceSWCompact> Handle;
+	typedef std::uint16_t Half;
+	static Token token;
+	virtual Token::Handle get_token() const
+		{ return token.handle(); }
+
+protected:
+	virtual bool create_vfunc(int width, int height);
+	virtual bool assign_vfunc(const Surface &surface);
+	virtual bool clear_vfunc();
+	virtual bool reset_vfunc();
+	virtual bool get_pixels_vfunc(Color *buffer) const;
+
+private:
+	std::vector<Half> data;
+
+public:
+	SurfaceSWCompact()
+		{ }
+	explicit SurfaceSWCompact(const Surface &other)
+		{ assign(other); }
+
+	virtual size_t get_memory_size() const
+		{ return data.size()*sizeof(Half); }
+
+	//! Returns plane of channel (0 - red, 1 - green, 2 - blue, 3 - alpha)
+	const Half* get_plane(int channel) const
+		{ return data.empty() ? nullptr : &data[channel*get_pixels_count()]; }
+
+	static Half float_to_half(float x);
+	static float half_to_float(Half x);
+
+	//! Converts pixels to the planes, each plane must have room for count values
+	static void pack(Half *r, Half *g, Half *b, Half *a, const Color *src, int count);
+	//! Converts planes to pixels
+	static void unpack(Color *dst, const Half *r, const Half *g, const Half *b, const Half *a, int count);
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
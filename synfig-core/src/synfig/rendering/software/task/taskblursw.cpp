@@ -32,6 +32,8 @@
 #	include <config.h>
 #endif
 
+#include <cstdlib>
+
 #include "../../common/task/taskblur.h"
 #include "../../common/task/taskblend.h"
 #include "tasksw.h"
@@ -52,7 +54,8 @@ using namespace rendering;
 
 namespace {
 
-class TaskBlurSW: public TaskBlur, public TaskSW, public TaskInterfaceBlendToTarget
+class TaskBlurSW: public TaskBlur, public TaskSW, public TaskInterfaceBlendToTarget,
+	public TaskInterfaceSplit
 {
 public:
 	typedef etl::handle<TaskBlurSW> Handle;
@@ -64,6 +67,26 @@ public:
 	virtual Color::BlendMethodFlags get_supported_blend_methods() const
 		{ return Color::BLEND_METHODS_ALL & ~Color::BLEND_METHODS_STRAIGHT; }
 
+	VectorInt get_extra_size() const
+		{ return software::Blur::get_extra_size(blur.type, blur.size.multiply_coords(get_pixels_per_unit())); }
+
+	// each piece reads its own border of the source (see software::Blur::Params::validate()),
+	// so the pieces are seamless
+	virtual Real get_split_pixel_cost() const {
+		// rough estimation of the methods choosen by software::Blur::blur()
+		VectorInt s = get_extra_size();
+		if ( blur.type == rendering::Blur::BOX
+		  || blur.type == rendering::Blur::CROSS
+		  || blur.type == rendering::Blur::FASTGAUSSIAN )
+			return 4.0;
+		if ( (blur.type == rendering::Blur::DISC && (s[0] + 1)*(s[1] + 1) < 64)
+		  || (blur.type == rendering::Blur::GAUSSIAN && s[0] < 32 && s[1] < 32) )
+			return 1.0 + (s[0] + s[1])/4.0;
+		return 16.0;
+	}
+	virtual int get_split_overlap() const
+		{ return std::abs(get_extra_size()[1]); }
+
 	virtual bool run(RunParams&) const {
 		if (!is_valid() || !sub_task() || !sub_task()->is_valid())
 			return true;
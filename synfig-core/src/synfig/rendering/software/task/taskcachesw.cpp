@@ -0,0 +1,134 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/taskcachesw.cpp
+**	\brief TaskCacheSW
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <cstring>
+
+#include <synfig/general.h>
+
+#include "../../common/task/taskcache.h"
+#include "../../renderer.h"
+#include "../../surfacecache.h"
+#include "../surfaceswcompact.h"
+#include "tasksw.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+namespace {
+
+class TaskCacheSW: public TaskCache, public TaskSW
+{
+public:
+	typedef etl::handle<TaskCacheSW> Handle;
+	static Token token;
+	virtual Token::Handle get_token() const { return token.handle(); }
+
+private:
+	static void copy(synfig::Surface &dst, const RectInt &rd, const synfig::Surface &src, const VectorInt &src_origin)
+	{
+		for(int y = rd.miny; y < rd.maxy; ++y)
+			memcpy( &dst[y][rd.minx],
+			        &src[y - rd.miny + src_origin[1]][src_origin[0]],
+			        rd.get_width()*sizeof(Color) );
+	}
+
+	void store(synfig::Surface &dst) const
+	{
+		// cached surfaces are rarely read, so keep them in compact form
+		const RectInt &rs = target_rect;
+		synfig::Surface surface(rs.get_width(), rs.get_height());
+		copy(surface, RectInt(VectorInt::zero(), rs.get_size()), dst, rs.get_min());
+		SurfaceSWCompact::Handle compact = new SurfaceSWCompact();
+		if (!compact->assign(&surface[0][0], surface.get_w(), surface.get_h()))
+			return;
+		Renderer::get_surface_cache().put(surface_key, new SurfaceResource(compact));
+
+		// the frame which fills the cache gets the same pixels as the frames which read it
+		if (compact->get_pixels(&surface[0][0]))
+			copy(dst, rs, surface, VectorInt::zero());
+	}
+
+public:
+	virtual bool run(RunParams&) const {
+		if (!is_valid())
+			return true;
+
+		const RectInt &rd = target_rect;
+		RectInt rs;
+		VectorInt src_origin;
+		if (sub_task() && sub_task()->is_valid()) {
+			Vector offset = (sub_task()->source_rect.get_min() - source_rect.get_min()).multiply_coords(get_pixels_per_unit());
+			VectorInt origin = rd.get_min() + VectorInt((int)round(offset[0]), (int)round(offset[1]));
+			rs = sub_task()->target_rect - sub_task()->target_rect.get_min() + origin;
+			rect_set_intersect(rs, rs, rd);
+			src_origin = rs.get_min() - origin + sub_task()->target_rect.get_min();
+		}
+
+		LockWrite ldst(this);
+		if (!ldst) return false;
+		synfig::Surface &dst = ldst->get_surface();
+
+		if (!rs.is_valid() || rs != rd)
+			dst.fill(Color(0, 0, 0, 0), rd.minx, rd.miny, rd.get_width(), rd.get_height());
+
+		if (rs.is_valid() && sub_task()->target_surface != target_surface) {
+			LockRead lsrc(sub_task());
+			if (!lsrc) return false;
+			copy(dst, rs, lsrc->get_surface(), src_origin);
+		}
+
+		if (!cached && !surface_key.empty())
+			store(dst);
+
+		return true;
+	}
+};
+
+
+Task::Token TaskCacheSW::token(
+	DescReal<TaskCacheSW, TaskCache>("CacheSW") );
+
+} // end of anonimous namespace
+
+/* === E N T R Y P O I N T ================================================= */
@@ -32,6 +32,8 @@
 #	include <config.h>
 #endif
 
+#include <cstring>
+
 #include <synfig/guid.h>
 #include <synfig/canvas.h>
 #include <synfig/context.h>
@@ -56,17 +58,75 @@ using namespace rendering;
 
 namespace {
 
-class TaskLayerSW: public TaskLayer, public TaskSW
+class TaskLayerSW: public TaskLayer, public TaskSW, public TaskInterfaceSplit
 {
+private:
+	//! task is a piece made by OptimizerSplit, it renders its target rect only
+	bool split_piece;
+
+	//! renders the layer over sub tasks, \a rect is the area of \a surface of size \a size
+	bool render_layer(const Rect &rect, const VectorInt &size, synfig::Surface &surface) const {
+		RendDesc desc;
+		desc.set_tl(rect.get_min());
+		desc.set_br(rect.get_max());
+		desc.set_wh(size[0], size[1]);
+		desc.set_antialias(1);
+
+		etl::handle<Layer_RenderingTask> sub_layer(new Layer_RenderingTask());
+		sub_layer->tasks = sub_tasks;
+
+		CanvasBase fake_canvas_base;
+		fake_canvas_base.push_back(layer);
+		fake_canvas_base.push_back(sub_layer);
+		fake_canvas_base.push_back(Layer::Handle());
+
+		Context context(fake_canvas_base.begin(), ContextParams());
+		return context.accelerated_render(&surface, 4, desc, nullptr);
+	}
+
 public:
 	typedef etl::handle<TaskLayerSW> Handle;
 	static Token token;
 	virtual Token::Handle get_token() const { return token.handle(); }
 
+	TaskLayerSW(): split_piece() { }
+
+	// legacy layers are rendered pixel by pixel via get_color()
+	virtual Real get_split_pixel_cost() const
+		{ return 16.0; }
+
+	// most of legacy layers are not thread-safe,
+	// so each piece renders its own flat copy of the layer
+	virtual void on_split() {
+		split_piece = true;
+		if (layer && !layer->is_render_thread_safe())
+			if (Layer::Handle copy = layer->clone_for_rendering())
+				layer = copy;
+	}
+
 	virtual bool run(RunParams&) const {
 		if (!is_valid() || !layer)
 			return false;
 
+		if (split_piece) {
+			// render the target rect only and copy it to the target surface
+			VectorInt size(target_rect.get_width(), target_rect.get_height());
+			synfig::Surface surface;
+			if (!render_layer(source_rect, size, surface))
+				return false;
+			if (surface.get_w() != size[0] || surface.get_h() != size[1])
+				return false;
+
+			LockWrite ldst(this);
+			if (!ldst)
+				return false;
+
+			synfig::Surface &dst = ldst->get_surface();
+			for(int y = 0; y < surface.get_h(); ++y)
+				memcpy(&dst[target_rect.miny + y][target_rect.minx], surface[y], surface.get_w()*sizeof(Color));
+			return true;
+		}
+
 		Vector upp = get_units_per_pixel();
 		Vector lt = source_rect.get_min();
 		Vector rb = source_rect.get_max();
@@ -75,27 +135,11 @@ public:
 		rb[0] += (target_surface->get_width() - target_rect.maxx)*upp[0];
 		rb[1] += (target_surface->get_height() - target_rect.maxy)*upp[1];
 
-		RendDesc desc;
-		desc.set_tl(lt);
-		desc.set_br(rb);
-		desc.set_wh(target_surface->get_width(), target_surface->get_height());
-		desc.set_antialias(1);
-
-		etl::handle<Layer_RenderingTask> sub_layer(new Layer_RenderingTask());
-		sub_layer->tasks = sub_tasks;
-
-		CanvasBase fake_canvas_base;
-		fake_canvas_base.push_back(layer);
-		fake_canvas_base.push_back(sub_layer);
-		fake_canvas_base.push_back(Layer::Handle());
-
-		Context context(fake_canvas_base.begin(), ContextParams());
-
 		LockWrite ldst(this);
 		if (!ldst)
 			return false;
 
-		return context.accelerated_render(&ldst->get_surface(), 4, desc, nullptr);
+		return render_layer(Rect(lt, rb), target_surface->get_size(), ldst->get_surface());
 	}
 };
 
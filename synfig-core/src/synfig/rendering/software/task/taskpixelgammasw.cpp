@@ -32,6 +32,8 @@
 #	include <config.h>
 #endif
 
+#include <vector>
+
 #include <synfig/debug/debugsurface.h>
 #include <synfig/general.h>
 
@@ -61,6 +63,8 @@ public:
 	virtual Token::Handle get_token() const { return token.handle(); }
 
 private:
+	friend class TaskPixelGammaColorMatrixSW;
+
 	typedef void Func(ColorReal &dst, const ColorReal &src, const ColorReal &gamma);
 
 	struct Params
@@ -227,6 +231,71 @@ public:
 Task::Token TaskPixelGammaSW::token(
 	DescReal<TaskPixelGammaSW, TaskPixelGamma>("PixelGammaSW") );
 
+
+class TaskPixelGammaColorMatrixSW: public TaskPixelGammaColorMatrix, public TaskSW
+{
+public:
+	typedef etl::handle<TaskPixelGammaColorMatrixSW> Handle;
+	static Token token;
+	virtual Token::Handle get_token() const { return token.handle(); }
+
+	virtual bool run(RunParams&) const {
+		if (!is_valid())
+			return true;
+
+		RectInt rd = target_rect;
+		ColorMatrix::BatchProcessor processor(matrix);
+		std::vector<RectInt> constant_rects(1, rd);
+
+		LockWrite ldst(this);
+		if (!ldst) return false;
+		synfig::Surface &dst = ldst->get_surface();
+
+		if (!processor.is_constant() && sub_task() && sub_task()->is_valid())
+		{
+			VectorInt offset = get_offset();
+			RectInt rs = sub_task()->target_rect + rd.get_min() + offset;
+			rect_set_intersect(rs, rs, rd);
+			if (rs.is_valid())
+			{
+				LockRead lsrc(sub_task());
+				if (!lsrc) return false;
+				const synfig::Surface &src = lsrc->get_surface();
+
+				rs.list_subtract(constant_rects);
+
+				// gamma writes the row into the small buffer and the matrix
+				// reads it back from the cache, so the surfaces are swept once
+				int width = rs.get_width();
+				std::vector<Color> row(width);
+				for(int y = rs.miny; y < rs.maxy; ++y)
+				{
+					TaskPixelGammaSW::process(TaskPixelGammaSW::Params(
+						&row.front(),
+						width,
+						&src[y - rd.miny - offset[1]][rs.minx - rd.minx - offset[0]],
+						width,
+						width,
+						1,
+						TaskPixelGammaSW::clamp_positive(gamma.get_r()),
+						TaskPixelGammaSW::clamp_positive(gamma.get_g()),
+						TaskPixelGammaSW::clamp_positive(gamma.get_b()) ));
+					processor.process(&dst[y][rs.minx], width, &row.front(), width, width, 1);
+				}
+			}
+		}
+
+		for(std::vector<RectInt>::const_iterator i = constant_rects.begin(); i != constant_rects.end(); ++i)
+			dst.fill(processor.get_constant_value(), i->minx, i->miny, i->get_width(), i->get_height());
+
+		return true;
+	}
+};
+
+
+Task::Token TaskPixelGammaColorMatrixSW::token(
+	DescReal<TaskPixelGammaColorMatrixSW, TaskPixelGammaColorMatrix>("PixelGammaColorMatrixSW") );
+
 } // end of anonimous namespace
 
 /* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,132 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/software/task/taskpixelgeneratorsw.cpp
+**	\brief TaskPixelGeneratorSW
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <vector>
+
+#include "../../common/task/taskblend.h"
+#include "../../common/task/taskpixelgenerator.h"
+#include "tasksw.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+namespace {
+
+class TaskPixelGeneratorSW: public TaskPixelGenerator, public TaskSW,
+	public TaskInterfaceBlendToTarget,
+	public TaskInterfaceSplit
+{
+public:
+	typedef etl::handle<TaskPixelGeneratorSW> Handle;
+	static Token token;
+	virtual Token::Handle get_token() const { return token.handle(); }
+
+	virtual void on_target_set_as_source() {
+		Task::Handle &subtask = sub_task(0);
+		if ( subtask
+		  && subtask->target_surface == target_surface
+		  && !Color::is_straight(blend_method) )
+		{
+			trunc_by_bounds();
+			subtask->source_rect = source_rect;
+			subtask->target_rect = target_rect;
+		}
+	}
+
+	virtual Color::BlendMethodFlags get_supported_blend_methods() const
+		{ return Color::BLEND_METHODS_ALL; }
+
+	virtual Real get_split_pixel_cost() const
+		{ return generator ? generator->get_pixel_cost() : 1.0; }
+
+	virtual bool run(RunParams&) const {
+		if (!is_valid() || !generator)
+			return true;
+
+		Vector ppu = get_pixels_per_unit();
+
+		Matrix bounds_transfromation;
+		bounds_transfromation.m00 = ppu[0];
+		bounds_transfromation.m11 = ppu[1];
+		bounds_transfromation.m20 = target_rect.minx - ppu[0]*source_rect.minx;
+		bounds_transfromation.m21 = target_rect.miny - ppu[1]*source_rect.miny;
+
+		Matrix matrix = bounds_transfromation * transformation->matrix;
+		Matrix inv_matrix = matrix.get_inverted();
+
+		int tw = target_rect.get_width();
+		int th = target_rect.get_height();
+		Vector dx = inv_matrix.axis_x();
+		Vector dy = inv_matrix.axis_y();
+		Vector p = inv_matrix.get_transformed( Vector((Real)target_rect.minx, (Real)target_rect.miny) );
+
+		LockWrite la(this);
+		if (!la)
+			return false;
+
+		synfig::Surface &dst = la->get_surface();
+		if (blend) {
+			// generate all rows into the buffer and blend them onto the target
+			std::vector<Color> buffer((size_t)tw*th);
+			generator->generate(&buffer.front(), tw, tw, th, p, dx, dy);
+			const Color *src_row = &buffer.front();
+			for(int y = target_rect.miny; y < target_rect.maxy; ++y, src_row += tw) {
+				Color *dst_row = &dst[y][target_rect.minx];
+				Color::blend_span(dst_row, src_row, 1, dst_row, 1, tw, amount, blend_method);
+			}
+		} else {
+			generator->generate(&dst[target_rect.miny][target_rect.minx], dst.get_pitch()/sizeof(Color), tw, th, p, dx, dy);
+		}
+
+		return true;
+	}
+};
+
+
+Task::Token TaskPixelGeneratorSW::token(
+	DescReal<TaskPixelGeneratorSW, TaskPixelGenerator>("PixelGeneratorSW") );
+
+} // end of anonimous namespace
+
+/* === E N T R Y P O I N T ================================================= */
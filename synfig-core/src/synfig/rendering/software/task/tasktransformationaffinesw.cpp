@@ -60,7 +60,7 @@ using namespace rendering;
 namespace {
 
 class TaskTransformationAffineSW: public TaskTransformationAffine, public TaskSW,
-	public TaskInterfaceBlendToTarget
+	public TaskInterfaceBlendToTarget, public TaskInterfaceSplit
 {
 private:
 	class Helper;
@@ -74,6 +74,10 @@ public:
 	virtual Color::BlendMethodFlags get_supported_blend_methods() const
 		{ return Color::BLEND_METHODS_ALL; }
 
+	// resampling reads the whole source surface, so the pieces are seamless
+	virtual Real get_split_pixel_cost() const
+		{ return interpolation == Color::INTERPOLATION_NEAREST ? 1.0 : 4.0; }
+
 	virtual bool run(RunParams&) const
 	{
 		if (!is_valid() || !sub_task() || !sub_task()->is_valid())
@@ -160,6 +160,9 @@ public:
 		{ return get_width()*get_height(); }
 	size_t get_buffer_size() const
 		{ return get_pixels_count()*sizeof(Color); }
+	//! Returns the amount of memory used by the pixels
+	virtual size_t get_memory_size() const
+		{ return get_buffer_size(); }
 	bool is_exists() const
 		{ return get_width() > 0 && get_height() > 0; }
 	bool is_blank() const
@@ -377,6 +380,14 @@ public:
 	template<typename T>
 	bool has_surface() const
 		{ return has_surface(T::token.handle()); }
+	//! Returns the summary memory size of all representations of the surface
+	size_t get_memory_size() const {
+		std::lock_guard<std::mutex> lock(mutex);
+		size_t size = 0;
+		for(Map::const_iterator i = surfaces.begin(); i != surfaces.end(); ++i)
+			size += i->second->get_memory_size();
+		return size;
+	}
 	bool get_tokens(std::vector<Surface::Token::Handle> &outTokens) const {
 		std::lock_guard<std::mutex> lock(mutex);
 		for(Map::const_iterator i = surfaces.begin(); i != surfaces.end(); ++i)
@@ -0,0 +1,140 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/surfacecache.cpp
+**	\brief SurfaceCache
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "surfacecache.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	size_t surface_bytes(const SurfaceResource::Handle &surface) {
+		if (!surface) return 0;
+		// blank resource has no pixels yet, they will be allocated on reading
+		size_t bytes = surface->get_memory_size();
+		return bytes ? bytes : size_t(surface->get_width())*size_t(surface->get_height())*sizeof(Color);
+	}
+}
+
+/* === M E T H O D S ======================================================= */
+
+SurfaceCache::SurfaceCache(size_t max_bytes):
+	max_bytes(max_bytes)
+{ }
+
+void
+SurfaceCache::shrink(size_t bytes)
+{
+	while(!entries.empty() && stats.bytes > bytes) {
+		stats.bytes -= entries.back().bytes;
+		entries_by_key.erase(entries.back().key);
+		entries.pop_back();
+		++stats.evictions;
+	}
+	stats.count = entries.size();
+}
+
+size_t
+SurfaceCache::get_max_bytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return max_bytes;
+}
+
+void
+SurfaceCache::set_max_bytes(size_t max_bytes)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	this->max_bytes = max_bytes;
+	shrink(max_bytes);
+}
+
+SurfaceResource::Handle
+SurfaceCache::get(const String &key)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	EntryMap::iterator i = entries_by_key.find(key);
+	if (i == entries_by_key.end())
+		{ ++stats.misses; return SurfaceResource::Handle(); }
+	++stats.hits;
+	entries.splice(entries.begin(), entries, i->second);
+	return i->second->surface;
+}
+
+void
+SurfaceCache::put(const String &key, const SurfaceResource::Handle &surface)
+{
+	size_t bytes = surface_bytes(surface);
+	std::lock_guard<std::mutex> lock(mutex);
+	if (!bytes || bytes > max_bytes) return;
+
+	EntryMap::iterator i = entries_by_key.find(key);
+	if (i != entries_by_key.end()) {
+		stats.bytes -= i->second->bytes;
+		entries.erase(i->second);
+		entries_by_key.erase(i);
+	}
+
+	shrink(max_bytes - bytes);
+	entries.push_front(Entry(key, surface, bytes));
+	entries_by_key[key] = entries.begin();
+	stats.bytes += bytes;
+	stats.count = entries.size();
+}
+
+void
+SurfaceCache::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	entries_by_key.clear();
+	entries.clear();
+	stats.bytes = 0;
+	stats.count = 0;
+}
+
+SurfaceCache::Stats
+SurfaceCache::get_stats() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+/* === E N T R Y P O I N T ================================================= */
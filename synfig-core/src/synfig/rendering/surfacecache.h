@@ -0,0 +1,113 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/surfacecache.h
+**	\brief SurfaceCache Header
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_SURFACECACHE_H
+#define __SYNFIG_RENDERING_SURFACECACHE_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <list>
+#include <map>
+#include <mutex>
+
+#include <synfig/string.h>
+
+#include "surface.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+/*!	\class SurfaceCache
+**	\brief Keeps the rendered surfaces of the tasks between the renderings.
+**
+**	Surfaces are stored by the string keys made by the optimizer
+**	(see TaskCache), least recently used surfaces are dropped
+**	when the summary size of the pixels exceeds the limit.
+**	Stored surfaces must not be changed, tasks only read them.
+*/
+class SurfaceCache
+{
+public:
+	struct Stats {
+		long long hits;
+		long long misses;
+		long long evictions;
+		size_t bytes;
+		size_t count;
+		Stats(): hits(), misses(), evictions(), bytes(), count() { }
+	};
+
+private:
+	struct Entry {
+		String key;
+		SurfaceResource::Handle surface;
+		size_t bytes; //!< memory size at the moment of storing
+		Entry(const String &key, const SurfaceResource::Handle &surface, size_t bytes):
+			key(key), surface(surface), bytes(bytes) { }
+	};
+	typedef std::list<Entry> EntryList;
+	typedef std::map<String, EntryList::iterator> EntryMap;
+
+	mutable std::mutex mutex;
+	EntryList entries; //!< most recently used first
+	EntryMap entries_by_key;
+	size_t max_bytes;
+	Stats stats;
+
+	void shrink(size_t bytes);
+
+public:
+	explicit SurfaceCache(size_t max_bytes = 0);
+
+	size_t get_max_bytes() const;
+	//! Zero disables the cache
+	void set_max_bytes(size_t max_bytes);
+	bool is_enabled() const
+		{ return get_max_bytes() > 0; }
+
+	//! Returns null handle if there is no such surface, counts hit or miss
+	SurfaceResource::Handle get(const String &key);
+	void put(const String &key, const SurfaceResource::Handle &surface);
+	void clear();
+
+	Stats get_stats() const;
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
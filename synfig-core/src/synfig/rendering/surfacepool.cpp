@@ -0,0 +1,163 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/surfacepool.cpp
+**	\brief SurfacePool
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include <algorithm>
+#include <new>
+
+#include "surfacepool.h"
+
+#endif
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+/* === M E T H O D S ======================================================= */
+
+SurfacePool::SurfacePool(size_t max_bytes):
+	max_bytes(max_bytes)
+{ }
+
+SurfacePool::~SurfacePool()
+	{ clear(); }
+
+size_t
+SurfacePool::get_class_size(size_t bytes)
+{
+	if (bytes < get_min_bytes())
+		return bytes;
+	size_t power = get_min_bytes();
+	while(power <= bytes/2) power *= 2;
+	size_t step = power/8;
+	return (bytes + step - 1)/step*step;
+}
+
+void
+SurfacePool::shrink(size_t bytes, size_t keep_class)
+{
+	// largest buffers are released first
+	for(FreeMap::reverse_iterator i = free_buffers.rbegin(); i != free_buffers.rend() && stats.free_bytes > bytes; ++i) {
+		if (i->first == keep_class) continue;
+		while(!i->second.empty() && stats.free_bytes > bytes) {
+			::operator delete(i->second.back());
+			i->second.pop_back();
+			stats.free_bytes -= i->first;
+		}
+	}
+}
+
+size_t
+SurfacePool::get_max_bytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return max_bytes;
+}
+
+void
+SurfacePool::set_max_bytes(size_t max_bytes)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	this->max_bytes = max_bytes;
+	shrink(max_bytes, 0);
+}
+
+void*
+SurfacePool::alloc(size_t bytes)
+{
+	size_t size = get_class_size(bytes);
+	if (!size) return nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		++stats.requests;
+		stats.used_bytes += size;
+		if (stats.peak_bytes < stats.used_bytes)
+			stats.peak_bytes = stats.used_bytes;
+
+		FreeMap::iterator i = free_buffers.find(size);
+		if (i != free_buffers.end() && !i->second.empty()) {
+			void *buffer = i->second.back();
+			i->second.pop_back();
+			stats.free_bytes -= size;
+			++stats.reuses;
+			return buffer;
+		}
+	}
+
+	return ::operator new(size);
+}
+
+void
+SurfacePool::free(void *buffer, size_t bytes)
+{
+	if (!buffer) return;
+	size_t size = get_class_size(bytes);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stats.used_bytes -= std::min(stats.used_bytes, size);
+		if (size >= get_min_bytes() && size <= max_bytes) {
+			shrink(max_bytes - size, size);
+			if (stats.free_bytes + size <= max_bytes) {
+				free_buffers[size].push_back(buffer);
+				stats.free_bytes += size;
+				return;
+			}
+		}
+	}
+
+	::operator delete(buffer);
+}
+
+void
+SurfacePool::clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	shrink(0, 0);
+	free_buffers.clear();
+}
+
+SurfacePool::Stats
+SurfacePool::get_stats() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+/* === E N T R Y P O I N T ================================================= */
@@ -0,0 +1,109 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file synfig/rendering/surfacepool.h
+**	\brief SurfacePool Header
+**
+**	\legal
+**	......... ... 2026 Synfig Contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_RENDERING_SURFACEPOOL_H
+#define __SYNFIG_RENDERING_SURFACEPOOL_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig
+{
+namespace rendering
+{
+
+/*!	\class SurfacePool
+**	\brief Reuses the memory of large pixel buffers.
+**
+**	Sizes of buffers are rounded up to size classes (eight classes
+**	for each power of two), freed buffers wait in the pool
+**	for the next request of the same class, so the tasks of the next
+**	frame take the memory released by the tasks of the previous one.
+**	Summary size of the waiting buffers is limited,
+**	buffers smaller than get_min_bytes() are not pooled.
+*/
+class SurfacePool
+{
+public:
+	struct Stats {
+		long long requests;
+		long long reuses;
+		size_t used_bytes;  //!< size of allocated buffers which are in use now
+		size_t peak_bytes;  //!< maximal value of used_bytes
+		size_t free_bytes;  //!< size of buffers waiting in pool
+		Stats(): requests(), reuses(), used_bytes(), peak_bytes(), free_bytes() { }
+	};
+
+private:
+	typedef std::map<size_t, std::vector<void*> > FreeMap;
+
+	mutable std::mutex mutex;
+	FreeMap free_buffers;
+	size_t max_bytes;
+	Stats stats;
+
+	void shrink(size_t bytes, size_t keep_class);
+
+public:
+	explicit SurfacePool(size_t max_bytes = 0);
+	~SurfacePool();
+
+	static size_t get_min_bytes()
+		{ return 64*1024; }
+	//! Returns the real size of buffer allocated for the request of \a bytes
+	static size_t get_class_size(size_t bytes);
+
+	size_t get_max_bytes() const;
+	//! Zero disables pooling, buffers are allocated and freed immediately
+	void set_max_bytes(size_t max_bytes);
+
+	//! Allocates buffer of at least \a bytes size
+	void* alloc(size_t bytes);
+	//! Returns buffer to the pool, \a bytes must be the same as passed to alloc()
+	void free(void *buffer, size_t bytes);
+	//! Frees all waiting buffers
+	void clear();
+
+	Stats get_stats() const;
+};
+
+} /* end namespace rendering */
+} /* end namespace synfig */
+
+/* -- E N D ----------------------------------------------------------------- */
+
+#endif
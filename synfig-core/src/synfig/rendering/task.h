@@ -292,10 +292,16 @@ public:
 		Set tmp_deps;
 		Set tmp_back_deps;
 
+		//! estimated time of the task, relative to the simple blending of one pixel
+		Real cost;
+		//! cost of the longest chain of tasks which starts from this task,
+		//! ready tasks with greater priority are run first
+		Real priority;
+
 		RunParams params;
 		bool success;
 
-		RendererData(): batch_index(), index(), success() { }
+		RendererData(): batch_index(), index(), cost(), priority(), success() { }
 	};
 
 	class LockReadBase: public SurfaceResource::LockReadBase
@@ -487,11 +493,20 @@ public:
 };
 
 
+//! Task may be split into several tasks with smaller target rects (see OptimizerSplit)
 class TaskInterfaceSplit
 {
 public:
 	virtual bool is_splittable() const
 		{ return true; }
+	//! Approximate cost of one pixel relative to the simple blending of two surfaces
+	virtual Real get_split_pixel_cost() const
+		{ return 1.0; }
+	//! Rows of the source which should be processed additionally by each piece of split task
+	virtual int get_split_overlap() const
+		{ return 0; }
+	//! Called for each piece after the task is cloned and target rect is truncated
+	virtual void on_split() { }
 	virtual ~TaskInterfaceSplit() { }
 };
 
@@ -95,6 +95,10 @@ public:
 	Surface(const size_type &s):
 		surface<Color, ColorPrep>(s) { }
 
+	//! Uses external buffer of \a w x \a h pixels, it will not be freed by surface
+	Surface(value_type* data, int w, int h):
+		surface<Color, ColorPrep>(data, w, h, false) { }
+
 	template <typename _pen>
 	Surface(const _pen &_begin, const _pen &_end):
 		surface<Color, ColorPrep>(_begin,_end) { }
@@ -110,6 +114,11 @@ public:
 
 	void clear();
 
+	using surface<Color, ColorPrep>::fill;
+
+	//! Blends the \a color onto the area of the size \a w x \a h started from the \a pen position
+	void fill(Color color, alpha_pen& pen, int w, int h);
+
 	void blit_to(alpha_pen& DEST_PEN, int x, int y, int w, int h);
 };	// END of class Surface
 
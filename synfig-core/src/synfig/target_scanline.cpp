@@ -36,18 +36,30 @@
 
 #include "target_scanline.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sigc++/bind.h>
+
 #include "general.h"
 #include <synfig/localization.h>
 
 #include "canvas.h"
+#include "clock.h"
 #include "context.h"
 #include "render.h"
 #include "string.h"
 #include "surface.h"
+#include "evaluatedframe.h"
 #include "rendering/renderer.h"
 #include "rendering/surface.h"
 #include "rendering/software/surfacesw.h"
-#include "rendering/common/task/tasktransformation.h"
 
 #endif
 
@@ -62,14 +74,256 @@ using namespace rendering;
 
 #define USE_PIXELRENDERING_LIMIT 1
 
+//#define DEBUG_FRAME_QUEUE
+
 /* === G L O B A L S ======================================================= */
 
 /* === P R O C E D U R E S ================================================= */
 
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+/*!	\class Target_Scanline::FrameQueue
+**	\brief Bounded queue of rendered frames, which are put onto the target in separate thread.
+**
+**	So the next frame is rendered while the previous one is encoded and written by the target.
+**	Target::curr_frame_ is used by both threads, so it's guarded by the frame mutex.
+**
+**	Progress callback is not thread-safe, so the messages of the target are collected
+**	in the writer thread and reported from the render thread in push() and finish().
+**	Unknown exceptions of the target are rethrown in the render thread too.
+*/
+class Target_Scanline::FrameQueue
+{
+private:
+	struct Entry {
+		SurfaceResource::Handle surface;
+		int frame;
+		Entry(): frame() { }
+		Entry(const SurfaceResource::Handle &surface, int frame): surface(surface), frame(frame) { }
+	};
+
+	//! Collects messages of the target in the writer thread
+	class MessageCollector: public ProgressCallback
+	{
+	public:
+		std::vector< std::pair<bool, String> > messages; //!< pairs of (is error, message)
+		virtual bool error(const String &task) { messages.push_back(std::make_pair(true, task)); return true; }
+		virtual bool warning(const String &task) { messages.push_back(std::make_pair(false, task)); return true; }
+	};
+
+	Target_Scanline &target;
+	ProgressCallback *cb;
+	const int max_size;
+
+	std::mutex frame_mutex;
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::deque<Entry> entries;
+	bool busy;
+	bool stopped;
+	bool failed;
+	std::vector< std::pair<bool, String> > messages;
+	std::exception_ptr exception;
+	std::thread thread;
+
+	// statistics
+	int frames;
+	int render_stalls;
+	int target_stalls;
+	Real render_stall_time;
+	Real target_stall_time;
+
+	void thread_loop();
+	//! Stops the thread, all the frames in the queue are put onto the target before
+	void stop();
+	//! Reports collected messages and rethrows the exception of the target, called from the render thread
+	void report();
+
+public:
+	FrameQueue(Target_Scanline &target, int max_size, ProgressCallback *cb);
+	~FrameQueue();
+
+	//! Calls Target::next_frame(), returns the number of frame in \a frame
+	int next_frame(Time &time, int &frame);
+	//! Puts the frame into the queue, waits while the queue is full.
+	//! \return \c false if the target failed
+	bool push(const SurfaceResource::Handle &surface, int frame);
+	//! Waits until all frames are put onto the target and stops the thread.
+	//! \return \c false if the target failed
+	bool finish();
+	//! Drops the frames which are not passed to the target yet and stops the thread
+	void cancel();
+};
+
 /* === M E T H O D S ======================================================= */
 
+Target_Scanline::FrameQueue::FrameQueue(Target_Scanline &target, int max_size, ProgressCallback *cb):
+	target(target),
+	cb(cb),
+	max_size(std::max(1, max_size)),
+	busy(),
+	stopped(),
+	failed(),
+	frames(),
+	render_stalls(),
+	target_stalls(),
+	render_stall_time(),
+	target_stall_time()
+{
+	thread = std::thread(&FrameQueue::thread_loop, this);
+}
+
+Target_Scanline::FrameQueue::~FrameQueue()
+	{ cancel(); }
+
+void
+Target_Scanline::FrameQueue::thread_loop()
+{
+	while(true) {
+		Entry entry;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			if (entries.empty() && !stopped) {
+				// waiting for the first frame is not a stall
+				if (frames) ++target_stalls;
+				synfig::clock timer;
+				while(entries.empty() && !stopped) cond.wait(lock);
+				if (frames) target_stall_time += timer();
+			}
+			if (entries.empty()) break;
+			entry = entries.front();
+			entries.pop_front();
+			busy = true;
+		}
+
+		// same messages as in Target_Scanline::render()
+		bool success = false;
+		MessageCollector collector;
+		std::exception_ptr error;
+		try {
+			std::lock_guard<std::mutex> lock(frame_mutex);
+			success = target.put_frame(entry.surface, entry.frame, nullptr, &collector);
+		}
+		catch(const String& str)
+			{ collector.error(_("Caught string: ")+str); }
+		catch(std::bad_alloc&)
+			{ collector.error(_("Ran out of memory (Probably a bug)")); }
+		catch(...)
+			{ error = std::current_exception(); }
+		entry.surface.reset();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		busy = false;
+		++frames;
+		messages.insert(messages.end(), collector.messages.begin(), collector.messages.end());
+		if (!success) {
+			failed = true;
+			if (error && !exception) exception = error;
+			entries.clear();
+		}
+		cond.notify_all();
+		if (failed) break;
+	}
+}
+
+int
+Target_Scanline::FrameQueue::next_frame(Time &time, int &frame)
+{
+	std::lock_guard<std::mutex> lock(frame_mutex);
+	int frames_left = target.next_frame(time);
+	frame = target.curr_frame_;
+	return frames_left;
+}
+
+bool
+Target_Scanline::FrameQueue::push(const SurfaceResource::Handle &surface, int frame)
+{
+	report();
+
+	bool success;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (!failed && (int)entries.size() + (busy ? 1 : 0) >= max_size) {
+			++render_stalls;
+			synfig::clock timer;
+			while(!failed && (int)entries.size() + (busy ? 1 : 0) >= max_size) cond.wait(lock);
+			render_stall_time += timer();
+		}
+		success = !failed;
+		if (success) {
+			entries.push_back(Entry(surface, frame));
+			cond.notify_all();
+		}
+	}
+
+	if (!success) report();
+	return success;
+}
+
+void
+Target_Scanline::FrameQueue::report()
+{
+	std::vector< std::pair<bool, String> > list;
+	std::exception_ptr error;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		list.swap(messages);
+		std::swap(error, exception);
+	}
+
+	if (cb)
+		for(std::vector< std::pair<bool, String> >::const_iterator i = list.begin(); i != list.end(); ++i)
+			if (i->first) cb->error(i->second); else cb->warning(i->second);
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void
+Target_Scanline::FrameQueue::stop()
+{
+	if (!thread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopped = true;
+		cond.notify_all();
+	}
+	thread.join();
+
+	#ifdef DEBUG_FRAME_QUEUE
+	synfig::info( "Target_Scanline: %d frames passed through the queue, "
+				  "renderer waited for target %d times (%.3f s), "
+				  "target waited for renderer %d times (%.3f s)",
+				  frames,
+				  render_stalls, render_stall_time,
+				  target_stalls, target_stall_time );
+	#endif
+}
+
+bool
+Target_Scanline::FrameQueue::finish()
+{
+	stop();
+	report();
+	return !failed;
+}
+
+void
+Target_Scanline::FrameQueue::cancel()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		entries.clear();
+	}
+	// called from destructor, so messages are dropped
+	stop();
+}
+
 Target_Scanline::Target_Scanline():
-	threads_(2)
+	threads_(2),
+	parallel_frames_(1),
+	frame_queue_size_(0)
 {
 	curr_frame_=0;
 	if (const char *s = getenv("SYNFIG_TARGET_DEFAULT_ENGINE"))
@@ -89,8 +343,7 @@ synfig::Target_Scanline::call_renderer(
 	const ContextParams &context_params,
 	const RendDesc &renddesc )
 {
-	surface->create(renddesc.get_w(), renddesc.get_h());
-	rendering::Task::Handle task = canvas.build_rendering_task(context_params);
+	rendering::Task::Handle task = EvaluatedFrame::build_rendering_task(canvas, context_params, renddesc, surface);
 
 	if (task)
 	{
@@ -98,22 +351,6 @@ synfig::Target_Scanline::call_renderer(
 		if (!renderer)
 			throw "Renderer '" + get_engine() + "' not found";
 
-		Vector p0 = renddesc.get_tl();
-		Vector p1 = renddesc.get_br();
-		if (p0[0] > p1[0] || p0[1] > p1[1]) {
-			Matrix m;
-			if (p0[0] > p1[0]) { m.m00 = -1.0; m.m20 = p0[0] + p1[0]; std::swap(p0[0], p1[0]); }
-			if (p0[1] > p1[1]) { m.m11 = -1.0; m.m21 = p0[1] + p1[1]; std::swap(p0[1], p1[1]); }
-			TaskTransformationAffine::Handle t = new TaskTransformationAffine();
-			t->transformation->matrix = m;
-			t->sub_task() = task;
-			task = t;
-		}
-
-		task->target_surface = surface;
-		task->target_rect = RectInt( VectorInt(), surface->get_size() );
-		task->source_rect = Rect(p0, p1);
-
 		rendering::Task::List list;
 		list.push_back(task);
 		renderer->run(list);
@@ -121,6 +358,57 @@ synfig::Target_Scanline::call_renderer(
 	return true;
 }
 
+bool
+synfig::Target_Scanline::put_frame(const SurfaceResource::Handle &surface, int frame, FrameQueue *queue, ProgressCallback *cb)
+{
+	if (queue)
+		return queue->push(surface, frame);
+
+	SurfaceResource::LockRead<SurfaceSW> lock(surface);
+	if (!lock) {
+		if (cb) cb->error(_("Bad surface"));
+		return false;
+	}
+
+	// targets may check the frame number, so it should match to the frame being added
+	int last_frame = curr_frame_;
+	curr_frame_ = frame;
+	bool added = add_frame(&lock->get_surface(), cb);
+	curr_frame_ = last_frame;
+	if (!added) {
+		if (cb) cb->error(_("Unable to put surface on target"));
+		return false;
+	}
+	return true;
+}
+
+int
+synfig::Target_Scanline::next_frame_index(Time &time, int &frame, FrameQueue *queue)
+{
+	if (queue)
+		return queue->next_frame(time, frame);
+	int frames = next_frame(time);
+	frame = curr_frame_;
+	return frames;
+}
+
+bool
+synfig::Target_Scanline::render_parallel_frames(const ContextParams &context_params, int total_frames, FrameQueue *queue, ProgressCallback *cb)
+{
+	// The copies of the layer tree are not fully independent (see EvaluatedFrame):
+	// they share value nodes with the document
+	// and the copied canvases refer to the parent canvases of the document.
+	rendering::Renderer::Handle renderer = rendering::Renderer::get_renderer(get_engine());
+	if (!renderer)
+		throw "Renderer '" + get_engine() + "' not found";
+
+	return EvaluatedFrame::render_frames(
+		*canvas, context_params, desc, renderer, parallel_frames_, total_frames,
+		sigc::bind(sigc::mem_fun(*this, &Target_Scanline::next_frame_index), queue),
+		sigc::bind(sigc::mem_fun(*this, &Target_Scanline::put_frame), queue, cb),
+		cb );
+}
+
 bool
 synfig::Target_Scanline::render(ProgressCallback *cb)
 {
@@ -150,10 +438,29 @@ synfig::Target_Scanline::render(ProgressCallback *cb)
 	total_frames=frame_end-frame_start+1;
 	if(total_frames<=0)total_frames=1;
 
+	bool whole_frames = true;
+	#if USE_PIXELRENDERING_LIMIT
+	whole_frames = desc.get_w()*desc.get_h() <= PIXEL_RENDERING_LIMIT;
+	#endif
+
+	// Rendered frames are put onto the target in separate thread,
+	// so the target encodes the frame while the next one is rendering.
+	// Frames split into blocks are passed to the target directly.
+	std::unique_ptr<FrameQueue> queue;
+	if (frame_queue_size_ > 0 && total_frames > 1 && whole_frames)
+		queue.reset(new FrameQueue(*this, frame_queue_size_, cb));
+
 	try {
+		// the time of the document is not set when time sync is avoided,
+		// so the document is rendered as is by the sequential path
+		if (parallel_frames_ > 1 && total_frames > 1 && whole_frames && !get_avoid_time_sync())
+			return render_parallel_frames(context_params, total_frames, queue.get(), cb)
+			    && (!queue || queue->finish());
+
 		do{
 			// Grab the time
-			frames=next_frame(t);
+			int frame_index;
+			frames=next_frame_index(t, frame_index, queue.get());
 
 			// If we have a callback, and it returns
 			// false, go ahead and bail. (it may be a user cancel)
@@ -246,25 +553,18 @@ synfig::Target_Scanline::render(ProgressCallback *cb)
 						return false;
 					}
 
-					SurfaceResource::LockRead<SurfaceSW> lock(surface);
-					if(!lock)
-					{
-						if(cb)cb->error(_("Bad surface"));
-						return false;
-					}
-
 					// Put the surface we renderer
 					// onto the target.
-					if(!add_frame(&lock->get_surface(), cb))
-					{
-						if(cb)cb->error(_("Unable to put surface on target"));
+					if(!put_frame(surface, frame_index, queue.get(), cb))
 						return false;
-					}
 				#if USE_PIXELRENDERING_LIMIT
 				}
 				#endif
 			}
 		} while(frames);
+
+		if (queue && !queue->finish())
+			return false;
 	}
 	catch(const String& str)
 	{
@@ -321,9 +621,9 @@ Target_Scanline::process_block_alpha(const synfig::Surface& surface, int width,
 		switch(get_alpha_mode())
 		{
 			case TARGET_ALPHA_MODE_FILL:
-				for(int i = 0; i < width; i++)
 				{
-					colordata[i] = Color::blend(surface[y][i], desc.get_bg_color(), 1.0f);
+					Color bg = desc.get_bg_color();
+					Color::blend_span(colordata, surface[y], 1, &bg, 0, width, 1.0f, Color::BLEND_COMPOSITE);
 				}
 				break;
 			case TARGET_ALPHA_MODE_EXTRACT:
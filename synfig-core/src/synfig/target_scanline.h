@@ -51,6 +51,11 @@ class Target_Scanline : public Target
 {
 	//! Number of threads to use
 	int threads_;
+	//! Number of frames allowed to be rendered simultaneously
+	int parallel_frames_;
+	//! Number of rendered frames which may wait to be put onto the target,
+	//! when it's nonzero, frames are put onto the target in separate thread
+	int frame_queue_size_;
 
 	String engine_;
 
@@ -60,6 +65,17 @@ class Target_Scanline : public Target
 		const ContextParams &context_params,
 		const RendDesc &renddesc );
 
+	class FrameQueue;
+
+	//! Gets the time and the index of the next frame directly or from the \a queue
+	int next_frame_index(Time &time, int &frame, FrameQueue *queue);
+
+	//! Puts the rendered frame onto the target directly or through the \a queue
+	bool put_frame(const etl::handle<rendering::SurfaceResource> &surface, int frame, FrameQueue *queue, ProgressCallback *cb);
+
+	//! Renders several frames at once, frames are passed to the target in order
+	bool render_parallel_frames(const ContextParams &context_params, int total_frames, FrameQueue *queue, ProgressCallback *cb);
+
 public:
 	typedef etl::handle<Target_Scanline> Handle;
 	typedef etl::loose_handle<Target_Scanline> LooseHandle;
@@ -105,6 +121,14 @@ public:
 	void set_threads(int x) { threads_=x; }
 	//! Gets the number of threads
 	int get_threads()const { return threads_; }
+	//! Sets the number of frames which may be rendered simultaneously
+	void set_parallel_frames(int x) { parallel_frames_=x; }
+	//! Gets the number of frames which may be rendered simultaneously
+	int get_parallel_frames()const { return parallel_frames_; }
+	//! Sets the number of rendered frames which may wait for the target (0 - put frames synchronously)
+	void set_frame_queue_size(int x) { frame_queue_size_=x; }
+	//! Gets the number of rendered frames which may wait for the target
+	int get_frame_queue_size()const { return frame_queue_size_; }
 	//! Gets engine
 	const String& get_engine()const { return engine_; }
 	//! Sets engine
@@ -37,6 +37,8 @@
 #include <vector>
 #include <algorithm>
 
+#include <sigc++/bind.h>
+
 #include "synfig/clock.h"
 
 #include "target_tile.h"
@@ -52,10 +54,10 @@
 
 #include "debug/measure.h"
 
+#include "evaluatedframe.h"
 #include "rendering/renderer.h"
 #include "rendering/surface.h"
 #include "rendering/software/surfacesw.h"
-#include "rendering/common/task/tasktransformation.h"
 
 #endif
 
@@ -81,6 +83,7 @@ const unsigned int	DEF_TILE_HEIGHT = TILE_SIZE / 2;
 
 Target_Tile::Target_Tile():
 	threads_(2),
+	parallel_frames_(1),
 	tile_w_(DEF_TILE_WIDTH),
 	tile_h_(DEF_TILE_HEIGHT),
 	curr_tile_(0),
@@ -128,13 +131,12 @@ synfig::Target_Tile::call_renderer(
 	debug::Measure t("Target_Tile::call_renderer");
 	#endif
 
-	surface->create(renddesc.get_w(), renddesc.get_h());
 	rendering::Task::Handle task;
 	{
 		#ifdef DEBUG_MEASURE
 		debug::Measure t("build rendering task");
 		#endif
-		task = canvas.build_rendering_task(context_params);
+		task = EvaluatedFrame::build_rendering_task(canvas, context_params, renddesc, surface);
 	}
 
 	if (task)
@@ -143,22 +145,6 @@ synfig::Target_Tile::call_renderer(
 		if (!renderer)
 			throw "Renderer '" + get_engine() + "' not found";
 
-		Vector p0 = renddesc.get_tl();
-		Vector p1 = renddesc.get_br();
-		if (p0[0] > p1[0] || p0[1] > p1[1]) {
-			Matrix m;
-			if (p0[0] > p1[0]) { m.m00 = -1.0; m.m20 = p0[0] + p1[0]; std::swap(p0[0], p1[0]); }
-			if (p0[1] > p1[1]) { m.m11 = -1.0; m.m21 = p0[1] + p1[1]; std::swap(p0[1], p1[1]); }
-			TaskTransformationAffine::Handle t = new TaskTransformationAffine();
-			t->transformation->matrix = m;
-			t->sub_task() = task;
-			task = t;
-		}
-
-		task->target_surface = surface;
-		task->target_rect = RectInt( VectorInt(), surface->get_size() );
-		task->source_rect = Rect(p0, p1);
-
 		rendering::Task::List list;
 		list.push_back(task);
 
@@ -251,13 +237,37 @@ synfig::Target_Tile::async_render_tile(
 	}
 
 	synfig::Surface &s = lock->get_surface();
+	process_alpha(s);
+
+	// Add the tile to the target
+	if (!add_tile(s, rect.minx, rect.miny))
+	{
+		if(cb)cb->error(_("add_tile(): Unable to put surface on target"));
+		return false;
+	}
+
+	signal_progress()();
+	return true;
+}
+
+bool
+synfig::Target_Tile::wait_render_tiles(ProgressCallback* /* cb */)
+{
+	return true;
+}
+
+void
+synfig::Target_Tile::process_alpha(synfig::Surface &s)
+{
 	int cnt = s.get_w() * s.get_h();
 
 	switch(get_alpha_mode())
 	{
 		case TARGET_ALPHA_MODE_FILL:
-			for(int i = 0; i < cnt; ++i)
-				s[0][i] = Color::blend(s[0][i], desc.get_bg_color(), 1.0f);
+			{
+				Color bg = desc.get_bg_color();
+				Color::blend_span(s[0], s[0], 1, &bg, 0, cnt, 1.0f, Color::BLEND_COMPOSITE);
+			}
 			break;
 		case TARGET_ALPHA_MODE_EXTRACT:
 			for(int i = 0; i< cnt; ++i)
@@ -273,24 +283,76 @@ synfig::Target_Tile::async_render_tile(
 		default:
 			break;
 	}
+}
 
-	// Add the tile to the target
-	if (!add_tile(s, rect.minx, rect.miny))
-	{
-		if(cb)cb->error(_("add_tile(): Unable to put surface on target"));
-		return false;
-	}
+bool
+synfig::Target_Tile::add_frame_tiles(const synfig::Surface &surface, ProgressCallback *cb)
+{
+	curr_tile_ = 0;
+	RectInt rect;
+	while(next_tile(rect)) {
+		rect_set_intersect(rect, rect, RectInt(0, 0, surface.get_w(), surface.get_h()));
+		if (!rect.valid())
+			continue;
 
-	signal_progress()();
+		synfig::Surface tile(
+			surface.get_pen(rect.minx, rect.miny),
+			surface.get_pen(rect.maxx, rect.maxy) );
+		process_alpha(tile);
+
+		if (!add_tile(tile, rect.minx, rect.miny))
+		{
+			if(cb)cb->error(_("add_tile(): Unable to put surface on target"));
+			return false;
+		}
+		signal_progress()();
+	}
 	return true;
 }
 
+int
+synfig::Target_Tile::next_frame_index(Time &time, int &frame)
+{
+	int frames = next_frame(time);
+	frame = curr_frame_;
+	return frames;
+}
+
 bool
-synfig::Target_Tile::wait_render_tiles(ProgressCallback* /* cb */)
+synfig::Target_Tile::put_frame(const SurfaceResource::Handle &surface, int frame, ProgressCallback *cb)
 {
-	return true;
+	SurfaceResource::LockRead<SurfaceSW> lock(surface);
+	if (!lock) {
+		if (cb) cb->error(_("Bad surface"));
+		return false;
+	}
+
+	// targets may check the frame number, so it should match to the frame being added
+	int last_frame = curr_frame_;
+	curr_frame_ = frame;
+	bool added = start_frame(cb);
+	if (added) {
+		added = add_frame_tiles(lock->get_surface(), cb);
+		end_frame();
+	}
+	curr_frame_ = last_frame;
+	return added;
 }
 
+bool
+synfig::Target_Tile::render_parallel_frames(const ContextParams &context_params, int total_frames, ProgressCallback *cb)
+{
+	// Each frame is rendered as a whole and split into tiles when it is passed to the target.
+	rendering::Renderer::Handle renderer = rendering::Renderer::get_renderer(get_engine());
+	if (!renderer)
+		throw "Renderer '" + get_engine() + "' not found";
+
+	return EvaluatedFrame::render_frames(
+		*canvas, context_params, desc, renderer, parallel_frames_, total_frames,
+		sigc::mem_fun(*this, &Target_Tile::next_frame_index),
+		sigc::bind(sigc::mem_fun(*this, &Target_Tile::put_frame), cb),
+		cb );
+}
 
 bool
 synfig::Target_Tile::render(ProgressCallback *cb)
@@ -323,6 +385,10 @@ synfig::Target_Tile::render(ProgressCallback *cb)
 
 	try {
 
+		// see Target_Scanline::render()
+		if (parallel_frames_ > 1 && total_frames > 1 && !get_avoid_time_sync())
+			return render_parallel_frames(context_params, total_frames, cb);
+
 		if(total_frames>=1)
 		{
 			do
@@ -54,6 +54,8 @@ class Target_Tile : public Target
 {
 	//! Number of threads
 	int threads_;
+	//! Number of frames allowed to be rendered simultaneously
+	int parallel_frames_;
 	//! Tile width in pixels
 	int tile_w_;
 	//! Tile height in pixles
@@ -121,6 +123,10 @@ public:
 	void set_threads(int x) { threads_=x; }
 	//!Gets the number of threads
 	int get_threads()const { return threads_; }
+	//!Sets the number of frames which may be rendered simultaneously
+	void set_parallel_frames(int x) { parallel_frames_=x; }
+	//!Gets the number of frames which may be rendered simultaneously
+	int get_parallel_frames()const { return parallel_frames_; }
 	//!Sets the tile width
 	void set_tile_w(int w) { tile_w_=w; }
 	//!Gets the tile width
@@ -141,6 +147,16 @@ public:
 private:
 	//! Renders the context to the surface
 	bool render_frame_(Canvas::Handle canvas, ContextParams context_params, ProgressCallback *cb);
+	//! Applies the alpha mode of the target to the rendered surface
+	void process_alpha(synfig::Surface &surface);
+	//! Splits the whole rendered frame into tiles and adds them to the target
+	bool add_frame_tiles(const synfig::Surface &surface, ProgressCallback *cb);
+	//! Gets the time and the index of the next frame
+	int next_frame_index(Time &time, int &frame);
+	//! Splits the rendered frame into tiles and adds them to the target as the frame \a frame
+	bool put_frame(const etl::handle<rendering::SurfaceResource> &surface, int frame, ProgressCallback *cb);
+	//! Renders several frames at once, frames are passed to the target in order
+	bool render_parallel_frames(const ContextParams &context_params, int total_frames, ProgressCallback *cb);
 
 }; // END of class Target_Tile
 
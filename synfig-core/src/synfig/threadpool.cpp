@@ -41,8 +41,18 @@
 #endif
 
 #include <cassert>
+#include <cstdlib>
 #include <sigc++/bind.h>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
 #include <synfig/localization.h>
 #include <synfig/general.h>
 
@@ -61,6 +71,8 @@ using namespace synfig;
 /* === M E T H O D S ======================================================= */
 
 ThreadPool* ThreadPool::instance_ = 0;
+int ThreadPool::default_num_threads = 0;
+bool ThreadPool::default_affinity = false;
 
 
 // ThreadPool::Group
@@ -141,19 +153,27 @@ ThreadPool::ThreadPool():
 	running_threads(0),
 	ready_threads(0),
 	queue_size(0),
-	stopped(false)
+	stopped(false),
+	affinity(default_affinity)
 {
-	max_running_threads = std::thread::hardware_concurrency();
+	// the same meaning as in set_num_threads(), the calling thread is counted as running
+	if (default_num_threads > 0) {
+		max_running_threads = default_num_threads;
+	} else {
+		max_running_threads = std::thread::hardware_concurrency();
+		if (max_running_threads > 2) --max_running_threads;
+	}
 
 	if (const char *s = getenv("SYNFIG_GENERIC_THREADS"))
 		max_running_threads = atoi(s) + 1;
+	if (const char *s = getenv("SYNFIG_THREAD_AFFINITY"))
+		affinity = atoi(s) != 0;
 
 	if (max_running_threads < 2) max_running_threads = 2;
-	if (max_running_threads > 2) --max_running_threads;
 	++running_threads;
 
 	#ifdef DEBUG_PTHREAD_MEASURE
-	info("ThreadPool created with max running threads: %d", max_running_threads - 1);
+	info("ThreadPool: %d worker threads%s", max_running_threads - 1, affinity ? ", pinned to CPU cores" : "");
 	#endif
 }
 
@@ -191,11 +211,32 @@ ThreadPool::~ThreadPool() {
 }
 
 void
-ThreadPool::thread_loop(int
-	#ifdef DEBUG_PTHREAD_MEASURE
-	id
+ThreadPool::pin_thread(int id) {
+	unsigned int cpus = std::thread::hardware_concurrency();
+	if (cpus < 2) return;
+
+	// thread ids start from 1, core 0 is left for the main thread when possible
+	unsigned int cpu = (unsigned int)id % cpus;
+
+	#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set))
+		warning("ThreadPool: cannot pin thread #%d to CPU %u", id, cpu);
+	#elif defined(_WIN32)
+	if (cpu < 8*sizeof(DWORD_PTR) && !SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu))
+		warning("ThreadPool: cannot pin thread #%d to CPU %u", id, cpu);
+	#else
+	(void)cpu;
 	#endif
-) {
+}
+
+void
+ThreadPool::thread_loop(int id) {
+	if (affinity)
+		pin_thread(id);
+
 	++running_threads;
 
 	#ifdef DEBUG_PTHREAD_MEASURE
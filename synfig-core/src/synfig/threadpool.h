@@ -48,6 +48,14 @@
 
 namespace synfig {
 
+/*!	\class ThreadPool
+**	\brief The common set of worker threads.
+**
+**	Both the generic jobs (ThreadPool::Group, optimizers, blur)
+**	and the rendering threads of rendering::RenderQueue run here,
+**	so the number of threads running simultaneously is limited by the single value.
+**	Job which is going to sleep should use wait(), then the pool may run other jobs instead.
+*/
 class ThreadPool {
 public:
 	typedef sigc::slot<void> Slot;
@@ -86,10 +94,14 @@ private:
 	std::queue<Slot> queue;
 	std::vector<std::thread*> threads;
 	bool stopped;
+	bool affinity;
 
 	static ThreadPool *instance_;
+	static int default_num_threads;
+	static bool default_affinity;
 
 	void thread_loop(int id);
+	static void pin_thread(int id);
 	void wakeup();
 
 	ThreadPool();
@@ -103,6 +115,13 @@ public:
 
 	void set_num_threads(int num_threads);
 
+	//! Sets the number of running threads for the pool which is not created yet, zero means auto
+	static void set_default_num_threads(int num_threads)
+		{ default_num_threads = num_threads; }
+	//! Pins worker threads of the pool which is not created yet to the CPU cores
+	static void set_default_affinity(bool affinity)
+		{ default_affinity = affinity; }
+
 	int get_max_threads() const
 		{ return max_running_threads; }
 	int get_running_threads() const
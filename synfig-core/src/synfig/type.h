@@ -31,9 +31,11 @@
 /* === H E A D E R S ======================================================= */
 
 #include <cassert>
+#include <new>
 #include <vector>
 #include <map>
 #include <typeinfo>
+#include <type_traits>
 #include "string.h"
 
 /* === M A C R O S ========================================================= */
@@ -148,9 +150,18 @@ public:
 		TYPE_EQUAL,
 		TYPE_LESS,
 		TYPE_TO_STRING,
+		TYPE_CREATE_INPLACE,
 	};
 
+	//! Size of the storage inside of ValueBase. Values of trivially copyable
+	//! types which fit into it are created in place without heap allocation.
+	//! The storage is aligned like double instead of the default 16 bytes,
+	//! so ValueBase has no padding before it
+	enum { INPLACE_SIZE = 32 };
+	typedef std::aligned_storage<INPLACE_SIZE, alignof(double)>::type InplaceStorage;
+
 	typedef InternalPointer	(*CreateFunc)	();
+	typedef void			(*CreateInplaceFunc)(InternalPointer place);
 	typedef void			(*DestroyFunc)	(ConstInternalPointer);
 	typedef void			(*CopyFunc)		(InternalPointer dest, ConstInternalPointer src);
 	typedef bool			(*EqualFunc)	(ConstInternalPointer, ConstInternalPointer);
@@ -176,6 +187,17 @@ public:
 		static InternalPointer create()
 			{ return new Inner(); }
 		template<typename Inner>
+		static void create_inplace(InternalPointer place)
+			{ new(place) Inner(); }
+		//! Values created in place are copied by bytes and never destroyed
+		template<typename Inner>
+		static bool is_inplace()
+		{
+			return std::is_trivially_copyable<Inner>::value
+			    && sizeof(Inner) <= sizeof(InplaceStorage)
+			    && alignof(Inner) <= alignof(InplaceStorage);
+		}
+		template<typename Inner>
 		static void destroy(ConstInternalPointer x)
 			{ return delete (Inner*)x; }
 		template<typename Inner, typename Outer>
@@ -230,6 +252,8 @@ public:
 
 		inline static Description get_create(TypeId type)
 			{ return Description(TYPE_CREATE, type); }
+		inline static Description get_create_inplace(TypeId type)
+			{ return Description(TYPE_CREATE_INPLACE, type); }
 		inline static Description get_destroy(TypeId type)
 			{ return Description(TYPE_DESTROY, 0, type); }
 		inline static Description get_set(TypeId type)
@@ -487,6 +511,8 @@ public:
 private:
 	inline void register_create(TypeId type, Operation::CreateFunc func)
 		{ register_operation(Operation::Description::get_create(type), func); }
+	inline void register_create_inplace(TypeId type, Operation::CreateInplaceFunc func)
+		{ register_operation(Operation::Description::get_create_inplace(type), func); }
 	inline void register_destroy(TypeId type, Operation::DestroyFunc func)
 		{ register_operation(Operation::Description::get_destroy(type), func); }
 	template<typename T>
@@ -521,6 +547,8 @@ protected:
 
 	inline void register_create(Operation::CreateFunc func)
 		{ register_create(identifier, func); }
+	inline void register_create_inplace(Operation::CreateInplaceFunc func)
+		{ register_create_inplace(identifier, func); }
 	inline void register_destroy(Operation::DestroyFunc func)
 		{ register_destroy(identifier, func); }
 	template<typename T>
@@ -554,6 +582,8 @@ protected:
 	{
 		register_create     ( Operation::DefaultFuncs::create<Inner>          );
 		register_destroy    ( Operation::DefaultFuncs::destroy<Inner>         );
+		if (Operation::DefaultFuncs::is_inplace<Inner>())
+			register_create_inplace( Operation::DefaultFuncs::create_inplace<Inner> );
 		register_copy       ( Operation::DefaultFuncs::copy<Inner>            );
 		register_to_string  ( Operation::DefaultFuncs::to_string<Inner, Func> );
 		register_alias<Inner, Outer>();
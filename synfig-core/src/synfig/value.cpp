@@ -82,9 +82,17 @@ ValueBase::ValueBase(Type &x):
 }
 
 ValueBase::ValueBase(const ValueBase& x)
-	: ValueBase(*x.type)
+	: ValueBase()
 {
-	if(data != x.data)
+	if(x.is_inplace())
+	{
+		// trivially copyable
+		type = x.type;
+		inplace_data = x.inplace_data;
+		data = &inplace_data;
+	}
+	else
+	if(create(*x.type), data != x.data)
 	{
 		Operation::CopyFunc copy_func =
 			Type::get_operation<Operation::CopyFunc>(
@@ -135,7 +143,7 @@ ValueBase::get_string() const
 bool
 ValueBase::is_valid()const
 {
-	return type != &type_nil && ref_count;
+	return type != &type_nil && (is_inplace() || ref_count);
 }
 
 void
@@ -145,6 +153,19 @@ ValueBase::create(Type &type)
 	type.initialize();
 #endif
 	if (type == type_nil) { clear(); return; }
+
+	Operation::CreateInplaceFunc inplace_func =
+		Type::get_operation<Operation::CreateInplaceFunc>(
+			Operation::Description::get_create_inplace(type.identifier) );
+	if (inplace_func)
+	{
+		clear();
+		this->type = &type;
+		inplace_func(&inplace_data);
+		data = &inplace_data;
+		return;
+	}
+
 	Operation::CreateFunc func =
 		Type::get_operation<Operation::CreateFunc>(
 			Operation::Description::get_create(type.identifier) );
@@ -163,7 +184,7 @@ ValueBase::copy(const ValueBase& x)
 			Operation::Description::get_copy(type->identifier, x.type->identifier));
 	if (func)
 	{
-		if (!ref_count.unique()) create();
+		if (!is_unique()) create();
 		func(data, x.data);
 	}
 	else
@@ -173,7 +194,7 @@ ValueBase::copy(const ValueBase& x)
 				Operation::Description::get_copy(x.type->identifier, x.type->identifier));
 		if (func)
 		{
-			if (!ref_count.unique()) create(*x.type);
+			if (!is_unique()) create(*x.type);
 			func(data, x.data);
 		}
 	}
@@ -205,7 +226,8 @@ ValueBase::get_contained_type()const
 void
 ValueBase::clear()
 {
-	if(ref_count.unique() && data)
+	// values stored in place are trivially destructible
+	if(!is_inplace() && ref_count.unique() && data)
 	{
 		Operation::DestroyFunc func =
 			Type::get_operation<Operation::DestroyFunc>(
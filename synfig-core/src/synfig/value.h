@@ -82,6 +82,9 @@ protected:
 	Type *type;
 	//! Pointer to hold the data of the value
 	void *data;
+	//! Storage for small values, \a data points here when it is used
+	//!\see Operation::DefaultFuncs::is_inplace()
+	Operation::InplaceStorage inplace_data;
 	//! Counter of Value Nodes that refers to this Value Base
 	//! Value base can only be destructed if the ref_count is not greater than 0
 	//!\see etl::reference_counter
@@ -182,8 +185,13 @@ public:
 
 	//! Swap object contents
 	friend void swap(ValueBase& first, ValueBase& second) {
+		bool first_inplace = first.is_inplace();
+		bool second_inplace = second.is_inplace();
 		std::swap(first.type, second.type);
 		std::swap(first.data, second.data);
+		std::swap(first.inplace_data, second.inplace_data);
+		if (second_inplace) first.data = &first.inplace_data;
+		if (first_inplace) second.data = &second.inplace_data;
 		std::swap(first.ref_count, second.ref_count);
 		std::swap(first.loop_, second.loop_);
 		std::swap(first.static_, second.static_);
@@ -354,6 +362,10 @@ private:
 	void create(Type &type);
 	inline void create() { create(*type); }
 
+	//! Small values are stored in place and never shared, so they have no reference counter
+	bool is_inplace() const { return data == &inplace_data; }
+	bool is_unique() const { return is_inplace() || ref_count.unique(); }
+
 	template <typename T>
 	inline static bool _can_get(const TypeId type, const T &)
 	{
@@ -429,7 +441,7 @@ private:
 					Operation::Description::get_set(current_type.identifier) );
 			if (func)
 			{
-				if (!ref_count.unique()) create(current_type);
+				if (!is_unique()) create(current_type);
 				func(data, x);
 				return;
 			}
@@ -42,6 +42,9 @@
 #include "canvas.h"
 #include "layer.h"
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
 
 #endif
 
@@ -55,6 +58,12 @@ using namespace synfig;
 
 static int value_node_count(0);
 
+namespace {
+	thread_local std::map< std::pair<const ValueNode*, Real>, ValueBase > *current_evaluation_pass = nullptr;
+	std::atomic<long long> evaluation_pass_found_count(0);
+	std::atomic<long long> evaluation_pass_stored_count(0);
+}
+
 /* === P R O C E D U R E S ================================================= */
 
 ValueNode::LooseHandle
@@ -133,6 +142,7 @@ ValueNode::~ValueNode()
 {
 	value_node_count--;
 
+	ValueNodeEvaluationPass::forget(this);
 	begin_delete();
 }
 
@@ -142,6 +152,9 @@ ValueNode::on_changed()
 	DEBUG_LOG("SYNFIG_DEBUG_ON_CHANGED",
 		"%s:%d ValueNode::on_changed()\n", __FILE__, __LINE__);
 
+	// parents are notified below and will drop their values too
+	ValueNodeEvaluationPass::forget(this);
+
 	Canvas::LooseHandle parent_canvas = get_parent_canvas();
 	if(parent_canvas)
 		do						// signal to all the ancestor canvases
@@ -313,6 +326,13 @@ ValueNode::calc_time_bounds(int &begin, int &end, Real &fps) const
 	end = (int)ceil(e*fps);
 }
 
+void
+ValueNode::evaluate_many(const Time *times, size_t count, ValueBase *results) const
+{
+	for(size_t i = 0; i < count; ++i)
+		results[i] = (*this)(times[i]);
+}
+
 void
 ValueNode::calc_values(std::map<Time, ValueBase> &x, int begin, int end, Real fps) const
 {
@@ -320,8 +340,14 @@ ValueNode::calc_values(std::map<Time, ValueBase> &x, int begin, int end, Real fp
 	{
 		Real k = 1.0/fps;
 		if (begin > end) std::swap(begin, end);
+		std::vector<Time> times;
+		times.reserve(end - begin + 1);
 		for(int i = begin; i <= end; ++i)
-			add_value_to_map(x, i*k, (*this)(i*k));
+			times.push_back(i*k);
+		std::vector<ValueBase> values(times.size());
+		evaluate_many(times.data(), times.size(), values.data());
+		for(size_t i = 0; i < times.size(); ++i)
+			add_value_to_map(x, times[i], values[i]);
 	}
 }
 
@@ -350,6 +376,73 @@ ValueNode::get_values_vfunc(std::map<Time, ValueBase> &x) const
 }
 
 
+ValueNodeEvaluationPass::ValueNodeEvaluationPass():
+	values(current_evaluation_pass ? nullptr : new Map())
+{
+	if (values)
+		current_evaluation_pass = values;
+}
+
+ValueNodeEvaluationPass::~ValueNodeEvaluationPass()
+{
+	if (values)
+	{
+		current_evaluation_pass = nullptr;
+		delete values;
+	}
+}
+
+bool
+ValueNodeEvaluationPass::find(const ValueNode *node, Time t, ValueBase &value)
+{
+	if (!current_evaluation_pass)
+		return false;
+	Map::const_iterator i = current_evaluation_pass->find(Map::key_type(node, (Real)t));
+	if (i == current_evaluation_pass->end())
+		return false;
+	value = i->second;
+	++evaluation_pass_found_count;
+	return true;
+}
+
+void
+ValueNodeEvaluationPass::store(const ValueNode *node, Time t, const ValueBase &value)
+{
+	if (!current_evaluation_pass)
+		return;
+	(*current_evaluation_pass)[Map::key_type(node, (Real)t)] = value;
+	++evaluation_pass_stored_count;
+}
+
+void
+ValueNodeEvaluationPass::forget(const ValueNode *node)
+{
+	if (!current_evaluation_pass || current_evaluation_pass->empty())
+		return;
+	Map::iterator begin = current_evaluation_pass->lower_bound(
+		Map::key_type(node, -std::numeric_limits<Real>::infinity()) );
+	Map::iterator end = begin;
+	while(end != current_evaluation_pass->end() && end->first.first == node)
+		++end;
+	current_evaluation_pass->erase(begin, end);
+}
+
+long long
+ValueNodeEvaluationPass::get_found_count()
+	{ return evaluation_pass_found_count; }
+
+long long
+ValueNodeEvaluationPass::get_stored_count()
+	{ return evaluation_pass_stored_count; }
+
+void
+ValueNodeEvaluationPass::reset_counters()
+{
+	evaluation_pass_found_count = 0;
+	evaluation_pass_stored_count = 0;
+}
+
+
 ValueNodeList::ValueNodeList():
 	placeholder_count_(0)
 {
@@ -651,6 +744,16 @@ ValueNode::get_string()const
 	return String("ValueNode: ") + get_description();
 }
 
+bool
+LinkableValueNode::is_time_invariant()const
+{
+	for(int i = 0; i < link_count(); ++i)
+		if (ValueNode::LooseHandle link = get_link(i))
+			if (!link->is_time_invariant())
+				return false;
+	return true;
+}
+
 void LinkableValueNode::get_times_vfunc(Node::time_set &set) const
 {
 	ValueNode::LooseHandle	h;
@@ -825,6 +928,9 @@ LinkableValueNode::get_values_vfunc(std::map<Time, ValueBase> &x) const
 	for(int i = 0; i < link_count(); ++i)
 		if (ValueNode::Handle link = get_link(i))
 			link->get_value_change_times(times);
-	for(std::set<Time>::const_iterator i = times.begin(); i != times.end(); ++i)
-		add_value_to_map(x, *i, (*this)(*i));
+	std::vector<Time> sorted_times(times.begin(), times.end());
+	std::vector<ValueBase> values(sorted_times.size());
+	evaluate_many(sorted_times.data(), sorted_times.size(), values.data());
+	for(size_t i = 0; i < sorted_times.size(); ++i)
+		add_value_to_map(x, sorted_times[i], values[i]);
 }
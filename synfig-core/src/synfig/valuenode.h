@@ -201,6 +201,11 @@ public:
 	virtual ValueBase operator()(Time /*t*/)const
 		{ return ValueBase(); }
 
+	//! Writes the values of the ValueNode at \a count times into \a results.
+	//! Nodes which can share work between samples override it,
+	//! by default operator() is called for each time
+	virtual void evaluate_many(const Time *times, size_t count, ValueBase *results)const;
+
 	//! \internal Sets the id of the ValueNode
 	void set_id(const String &x);
 
@@ -262,6 +267,10 @@ public:
 	//! Set the default interpolation for Value Nodes
 	virtual void set_interpolation(Interpolation /* i*/) { }
 
+	//! Returns \c true if the Value Node returns the same value at any time.
+	//! The check is conservative: unknown nodes are treated as time-dependent.
+	virtual bool is_time_invariant()const { return false; }
+
 	// TODO: cache of values (we need to fix chain of signals 'changed' in LinkableValueNodes
 	void get_values(std::set<ValueBase> &x) const;
 	void get_value_change_times(std::set<Time> &x) const;
@@ -287,9 +296,51 @@ protected:
 	virtual void on_changed();
 
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+
+	//! Returns \c true if the value of the node is requested by more than one consumer,
+	//! such nodes are worth to be remembered by ValueNodeEvaluationPass
+	bool is_shared() const { return is_exported() || parent_count() > 1; }
 }; // END of class ValueNode
 
 
+/*!	\class ValueNodeEvaluationPass
+**	\brief Remembers values of shared value nodes during one evaluation pass
+**
+**	While an object of this class exists, the values stored by value nodes
+**	in the current thread are kept by (node, time), so a node which feeds
+**	many consumers (a bone of the rig, exported composite) is calculated once.
+**	Nested objects reuse the pass of the outer one.
+**	Values of the node are dropped when the node or any of its children changes.
+*/
+class ValueNodeEvaluationPass
+{
+private:
+	typedef std::map< std::pair<const ValueNode*, Real>, ValueBase > Map;
+	Map *values;
+
+	// not copyable
+	ValueNodeEvaluationPass(const ValueNodeEvaluationPass&) = delete;
+	ValueNodeEvaluationPass& operator=(const ValueNodeEvaluationPass&) = delete;
+
+public:
+	ValueNodeEvaluationPass();
+	~ValueNodeEvaluationPass();
+
+	//! Finds the value of \a node at time \a t stored in the current pass of this thread
+	static bool find(const ValueNode *node, Time t, ValueBase &value);
+	//! Stores the value, does nothing when there is no active pass in this thread
+	static void store(const ValueNode *node, Time t, const ValueBase &value);
+	//! Drops all stored values of the \a node
+	static void forget(const ValueNode *node);
+
+	//! Count of evaluations which were avoided by found values, in all threads
+	static long long get_found_count();
+	//! Count of values which were stored, in all threads
+	static long long get_stored_count();
+	static void reset_counters();
+}; // END of class ValueNodeEvaluationPass
+
+
 
 /**	\class ValueNode_Interface */
 class ValueNode_Interface
@@ -416,6 +467,8 @@ public:
 	ValueNode::LooseHandle get_link(int i)const;
 	//! Returns a Loose Handle to the Value Node based on the link's name
 	ValueNode::LooseHandle get_link(const String &name)const { return get_link(get_link_index_from_name(name)); }
+	//! Linkable Value Node is time-invariant when all its links are
+	bool is_time_invariant()const override;
 	//! Return a full description of the linked ValueNode given by the index
 	String get_link_description(int index, bool show_exported_name = true)const;
 	//! Return a full description of this linkable ValueNode
@@ -0,0 +1,352 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file valuenode_program.cpp
+**	\brief Compiled evaluation of ValueNode graphs
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#ifdef USING_PCH
+#	include "pch.h"
+#else
+#ifdef HAVE_CONFIG_H
+#	include <config.h>
+#endif
+
+#include "valuenode_program.h"
+
+#include <synfig/angle.h>
+#include <synfig/real.h>
+#include <synfig/vector.h>
+
+#include <synfig/valuenodes/valuenode_add.h>
+#include <synfig/valuenodes/valuenode_composite.h>
+#include <synfig/valuenodes/valuenode_const.h>
+#include <synfig/valuenodes/valuenode_linear.h>
+#include <synfig/valuenodes/valuenode_range.h>
+#include <synfig/valuenodes/valuenode_scale.h>
+#include <synfig/valuenodes/valuenode_subtract.h>
+
+#endif
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	// angles are calculated with the same precision as Angle does
+	typedef Angle::value_type AngleUnit;
+
+	inline Real angle_to_register(const Angle &x)
+		{ return Angle::rad(x).get(); }
+	inline Angle register_to_angle(Real x)
+		{ return Angle::rad((AngleUnit)x); }
+}
+
+/* === M E T H O D S ======================================================= */
+
+ValueNodeProgram::ValueNodeProgram(const ValueNode::Handle &root):
+	dirty(true), result(-1), result_kind(KIND_NONE)
+{
+	set_root(root);
+}
+
+ValueNodeProgram::~ValueNodeProgram()
+{
+	root_changed_connection.disconnect();
+}
+
+void
+ValueNodeProgram::set_root(const ValueNode::Handle &x)
+{
+	if (root == x) return;
+	root_changed_connection.disconnect();
+	root = x;
+	dirty = true;
+	if (root)
+		root_changed_connection = root->signal_changed().connect(
+			sigc::mem_fun(*this, &ValueNodeProgram::on_root_changed) );
+}
+
+ValueNodeProgram::Kind
+ValueNodeProgram::get_kind(Type &type)
+{
+	if (type == type_real)   return KIND_REAL;
+	if (type == type_angle)  return KIND_ANGLE;
+	if (type == type_vector) return KIND_VECTOR;
+	return KIND_NONE;
+}
+
+int
+ValueNodeProgram::alloc(Kind kind)
+{
+	int index = (int)registers.size();
+	registers.resize(registers.size() + (kind == KIND_VECTOR ? 2 : 1), 0.0);
+	return index;
+}
+
+int
+ValueNodeProgram::compile_node(const ValueNode::Handle &node, Kind kind)
+{
+	assert(node && kind != KIND_NONE);
+
+	std::pair<const ValueNode*, Kind> key(node.get(), kind);
+	std::map<std::pair<const ValueNode*, Kind>, int>::const_iterator i = compiled.find(key);
+	if (i != compiled.end())
+		return i->second;
+
+	// links are compiled first, so register of the node is allocated after them
+	int dst = -1;
+
+	if (get_kind(node->get_type()) == kind)
+	{
+		if (ValueNode_Const::Handle const_node = ValueNode_Const::Handle::cast_dynamic(node))
+		{
+			const ValueBase &value = const_node->get_value();
+			dst = alloc(kind);
+			if (kind == KIND_REAL)
+				registers[dst] = value.get(Real());
+			else
+			if (kind == KIND_ANGLE)
+				registers[dst] = angle_to_register(value.get(Angle()));
+			else
+			if (kind == KIND_VECTOR)
+				{ registers[dst] = value.get(Vector())[0]; registers[dst + 1] = value.get(Vector())[1]; }
+		}
+		else
+		if ( ValueNode_Add::Handle::cast_dynamic(node)
+		  || ValueNode_Subtract::Handle::cast_dynamic(node) )
+		{
+			LinkableValueNode::Handle linkable = LinkableValueNode::Handle::cast_dynamic(node);
+			ValueNode::Handle lhs = linkable->get_link(0);
+			ValueNode::Handle rhs = linkable->get_link(1);
+			ValueNode::Handle scalar = linkable->get_link(2);
+			if (lhs && rhs && scalar)
+			{
+				int a = compile_node(lhs, kind);
+				int b = compile_node(rhs, kind);
+				int c = compile_node(scalar, KIND_REAL);
+				dst = alloc(kind);
+				Code code = ValueNode_Add::Handle::cast_dynamic(node) ? CODE_ADD : CODE_SUBTRACT;
+				instructions.push_back(Instruction(code, kind, dst, a, b, c));
+			}
+		}
+		else
+		if (ValueNode_Scale::Handle scale = ValueNode_Scale::Handle::cast_dynamic(node))
+		{
+			ValueNode::Handle link = scale->get_link(0);
+			ValueNode::Handle scalar = scale->get_link(1);
+			if (link && scalar)
+			{
+				int a = compile_node(link, kind);
+				int c = compile_node(scalar, KIND_REAL);
+				dst = alloc(kind);
+				instructions.push_back(Instruction(CODE_SCALE, kind, dst, a, -1, c));
+			}
+		}
+		else
+		if (ValueNode_Linear::Handle linear = ValueNode_Linear::Handle::cast_dynamic(node))
+		{
+			ValueNode::Handle slope = linear->get_link(0);
+			ValueNode::Handle offset = linear->get_link(1);
+			if (slope && offset)
+			{
+				int a = compile_node(slope, kind);
+				int b = compile_node(offset, kind);
+				dst = alloc(kind);
+				instructions.push_back(Instruction(CODE_LINEAR, kind, dst, a, b));
+			}
+		}
+		else
+		if (ValueNode_Range::Handle range = ValueNode_Range::Handle::cast_dynamic(node))
+		{
+			ValueNode::Handle min = range->get_link(0);
+			ValueNode::Handle max = range->get_link(1);
+			ValueNode::Handle link = range->get_link(2);
+			if (kind != KIND_VECTOR && min && max && link)
+			{
+				int a = compile_node(min, kind);
+				int b = compile_node(max, kind);
+				int c = compile_node(link, kind);
+				dst = alloc(kind);
+				instructions.push_back(Instruction(CODE_RANGE, kind, dst, a, b, c));
+			}
+		}
+		else
+		if (ValueNode_Composite::Handle composite = ValueNode_Composite::Handle::cast_dynamic(node))
+		{
+			ValueNode::Handle x = composite->get_link(0);
+			ValueNode::Handle y = composite->get_link(1);
+			if (kind == KIND_VECTOR && x && y)
+			{
+				int a = compile_node(x, KIND_REAL);
+				int b = compile_node(y, KIND_REAL);
+				dst = alloc(kind);
+				instructions.push_back(Instruction(CODE_MOVE, KIND_REAL, dst, a));
+				instructions.push_back(Instruction(CODE_MOVE, KIND_REAL, dst + 1, b));
+			}
+		}
+	}
+
+	// any other node is evaluated as is
+	if (dst < 0)
+	{
+		dst = alloc(kind);
+		instructions.push_back(Instruction(CODE_LOAD, kind, dst));
+		instructions.back().node = node;
+	}
+
+	compiled[key] = dst;
+	return dst;
+}
+
+void
+ValueNodeProgram::compile()
+{
+	instructions.clear();
+	registers.clear();
+	compiled.clear();
+	result = -1;
+	result_kind = root ? get_kind(root->get_type()) : KIND_NONE;
+	if (result_kind != KIND_NONE)
+		result = compile_node(root, result_kind);
+	compiled.clear();
+	dirty = false;
+}
+
+int
+ValueNodeProgram::get_load_count() const
+{
+	int count = 0;
+	for(std::vector<Instruction>::const_iterator i = instructions.begin(); i != instructions.end(); ++i)
+		if (i->code == CODE_LOAD) ++count;
+	return count;
+}
+
+ValueBase
+ValueNodeProgram::operator()(Time t)
+{
+	if (dirty)
+		compile();
+	if (result_kind == KIND_NONE)
+		return root ? (*root)(t) : ValueBase();
+
+	work = registers;
+	Real *r = &work.front();
+	for(std::vector<Instruction>::const_iterator i = instructions.begin(); i != instructions.end(); ++i)
+	{
+		Real *d = r + i->dst;
+		switch(i->code)
+		{
+		case CODE_LOAD:
+			{
+				ValueBase value = (*i->node)(t);
+				if (i->kind == KIND_REAL)
+					d[0] = value.get(Real());
+				else
+				if (i->kind == KIND_ANGLE)
+					d[0] = angle_to_register(value.get(Angle()));
+				else
+				{
+					const Vector &v = value.get(Vector());
+					d[0] = v[0];
+					d[1] = v[1];
+				}
+			}
+			break;
+		case CODE_MOVE:
+			d[0] = r[i->a];
+			break;
+		case CODE_ADD:
+		case CODE_SUBTRACT:
+			{
+				const Real *a = r + i->a, *b = r + i->b, s = r[i->c];
+				Real sign = i->code == CODE_ADD ? 1.0 : -1.0;
+				if (i->kind == KIND_REAL)
+					d[0] = (a[0] + sign*b[0])*s;
+				else
+				if (i->kind == KIND_ANGLE)
+				{
+					AngleUnit v = i->code == CODE_ADD ? (AngleUnit)a[0] + (AngleUnit)b[0] : (AngleUnit)a[0] - (AngleUnit)b[0];
+					v *= (AngleUnit)s;
+					d[0] = v;
+				}
+				else
+				{
+					d[0] = (a[0] + sign*b[0])*s;
+					d[1] = (a[1] + sign*b[1])*s;
+				}
+			}
+			break;
+		case CODE_SCALE:
+			{
+				const Real *a = r + i->a, s = r[i->c];
+				if (i->kind == KIND_ANGLE)
+					d[0] = (AngleUnit)a[0]*(AngleUnit)s;
+				else
+				{
+					d[0] = a[0]*s;
+					if (i->kind == KIND_VECTOR) d[1] = a[1]*s;
+				}
+			}
+			break;
+		case CODE_LINEAR:
+			{
+				const Real *a = r + i->a, *b = r + i->b;
+				if (i->kind == KIND_ANGLE)
+				{
+					AngleUnit v = (AngleUnit)a[0]*(AngleUnit)(Real)t;
+					d[0] = v + (AngleUnit)b[0];
+				}
+				else
+				{
+					d[0] = a[0]*t + b[0];
+					if (i->kind == KIND_VECTOR) d[1] = a[1]*t + b[1];
+				}
+			}
+			break;
+		case CODE_RANGE:
+			{
+				Real min = r[i->a], max = r[i->b], link = r[i->c];
+				if (i->kind == KIND_ANGLE)
+					d[0] = max >= link && link >= min ? link : (min > link ? min : max);
+				else
+					d[0] = clamp(link, min, max);
+			}
+			break;
+		}
+	}
+
+	if (result_kind == KIND_REAL)
+		return r[result];
+	if (result_kind == KIND_ANGLE)
+		return register_to_angle(r[result]);
+	return Vector(r[result], r[result + 1]);
+}
+
+/* === E N T R Y P O I N T ================================================= */
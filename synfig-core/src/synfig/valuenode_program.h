@@ -0,0 +1,141 @@
+/* === S Y N F I G ========================================================= */
+/*!	\file valuenode_program.h
+**	\brief Compiled evaluation of ValueNode graphs
+**
+**	\legal
+**	Copyright (c) 2026 Synfig contributors
+**
+**	This file is part of Synfig.
+**
+**	Synfig is free software: you can redistribute it and/or modify
+**	it under the terms of the GNU General Public License as published by
+**	the Free Software Foundation, either version 2 of the License, or
+**	(at your option) any later version.
+**
+**	Synfig is distributed in the hope that it will be useful,
+**	but WITHOUT ANY WARRANTY; without even the implied warranty of
+**	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**	GNU General Public License for more details.
+**
+**	You should have received a copy of the GNU General Public License
+**	along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+**	\endlegal
+*/
+/* ========================================================================= */
+
+/* === S T A R T =========================================================== */
+
+#ifndef __SYNFIG_VALUENODE_PROGRAM_H
+#define __SYNFIG_VALUENODE_PROGRAM_H
+
+/* === H E A D E R S ======================================================= */
+
+#include <map>
+#include <vector>
+
+#include "valuenode.h"
+
+/* === M A C R O S ========================================================= */
+
+/* === T Y P E D E F S ===================================================== */
+
+/* === C L A S S E S & S T R U C T S ======================================= */
+
+namespace synfig {
+
+/*!	\class ValueNodeProgram
+**	\brief ValueNode graph flattened into the linear list of instructions
+**
+**	Arithmetic nodes of real, angle and vector types (Const, Add, Subtract,
+**	Scale, Linear, Range and vector Composite) are converted into instructions
+**	which work with plain numbers in the register file. Any other node is
+**	evaluated by its operator() and its value is loaded into the registers.
+**	Node shared by several parents is calculated once per evaluation.
+**
+**	The program is rebuilt on the next evaluation after the root node
+**	or any of its children was changed.
+**	Evaluation is not thread-safe, use one program per thread.
+**	Layer::set_time() evaluates the dynamic parameters of the layer through programs.
+*/
+class ValueNodeProgram
+{
+public:
+	enum Kind
+	{
+		KIND_NONE,
+		KIND_REAL,		//!< one register
+		KIND_ANGLE,		//!< one register, calculated with precision of Angle
+		KIND_VECTOR		//!< two registers
+	};
+
+	enum Code
+	{
+		CODE_LOAD,		//!< dst = node(t)
+		CODE_MOVE,		//!< dst = a
+		CODE_ADD,		//!< dst = (a + b)*c
+		CODE_SUBTRACT,	//!< dst = (a - b)*c
+		CODE_SCALE,		//!< dst = a*c
+		CODE_LINEAR,	//!< dst = a*t + b
+		CODE_RANGE		//!< dst = a <= c <= b ? c : clamped
+	};
+
+	struct Instruction
+	{
+		Code code;
+		Kind kind;
+		int dst, a, b, c;
+		ValueNode::Handle node;
+
+		Instruction(Code code, Kind kind, int dst, int a = -1, int b = -1, int c = -1):
+			code(code), kind(kind), dst(dst), a(a), b(b), c(c) { }
+	};
+
+private:
+	ValueNode::Handle root;
+	sigc::connection root_changed_connection;
+	bool dirty;
+
+	std::vector<Instruction> instructions;
+	//! Initial state of registers with the values of constants
+	std::vector<Real> registers;
+	//! Registers used during evaluation
+	std::vector<Real> work;
+	int result;
+	Kind result_kind;
+
+	//! Registers of already compiled nodes
+	std::map<std::pair<const ValueNode*, Kind>, int> compiled;
+
+	int alloc(Kind kind);
+	int compile_node(const ValueNode::Handle &node, Kind kind);
+	void on_root_changed() { dirty = true; }
+
+	// not copyable
+	ValueNodeProgram(const ValueNodeProgram&) = delete;
+	ValueNodeProgram& operator=(const ValueNodeProgram&) = delete;
+
+public:
+	explicit ValueNodeProgram(const ValueNode::Handle &root = ValueNode::Handle());
+	~ValueNodeProgram();
+
+	void set_root(const ValueNode::Handle &x);
+	const ValueNode::Handle& get_root() const { return root; }
+
+	//! Builds the program, called automatically when the graph was changed
+	void compile();
+
+	//! Returns the value of the root node at time \a t
+	ValueBase operator()(Time t);
+
+	const std::vector<Instruction>& get_instructions() const { return instructions; }
+	//! Count of instructions which call operator() of nodes
+	int get_load_count() const;
+
+	static Kind get_kind(Type &type);
+}; // END of class ValueNodeProgram
+
+}; // END of namespace synfig
+
+/* === E N D =============================================================== */
+
+#endif
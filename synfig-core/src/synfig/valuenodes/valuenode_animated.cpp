@@ -33,6 +33,8 @@
 #	include <config.h>
 #endif
 
+#include <algorithm>
+
 #include <synfig/localization.h>
 
 #include "valuenode_animated.h"
@@ -50,10 +52,49 @@ using namespace synfig;
 
 /* === C L A S S E S ======================================================= */
 
+/* === P R O C E D U R E S ================================================= */
+
+namespace {
+	//! Adds to [begin, end] the interval affected by the change of the waypoint \p index.
+	//! Tangents of the waypoint depend on its neighbours, so two waypoints
+	//! at each side of the changed one bound the affected segments.
+	void add_waypoint_influence(const std::vector<Time> &times, size_t index, Time &begin, Time &end)
+	{
+		begin = std::min(begin, index >= 2 ? times[index - 2] : Time::begin());
+		end = std::max(end, index + 2 < times.size() ? times[index + 2] : Time::end());
+	}
+}
+
 /* === M E T H O D S ======================================================= */
 
+ValueNode_Animated::WaypointState::WaypointState(const Waypoint &waypoint):
+	time(waypoint.get_time()),
+	value_node(waypoint.get_value_node().get()),
+	before(waypoint.get_before()),
+	after(waypoint.get_after()),
+	tension(waypoint.get_tension()),
+	continuity(waypoint.get_continuity()),
+	bias(waypoint.get_bias()),
+	temporal_tension(waypoint.get_temporal_tension())
+{ }
+
+bool
+ValueNode_Animated::WaypointState::operator== (const WaypointState &other) const
+{
+	return time == other.time
+		&& value_node == other.value_node
+		&& before == other.before
+		&& after == other.after
+		&& tension == other.tension
+		&& continuity == other.continuity
+		&& bias == other.bias
+		&& temporal_tension == other.temporal_tension;
+}
+
 ValueNode_Animated::ValueNode_Animated(Type &type):
-	ValueNode_AnimatedInterface(*(ValueNode*)this)
+	ValueNode_AnimatedInterface(*(ValueNode*)this),
+	interpolation_state(),
+	waypoint_states_valid(false)
 {
 	ValueNode_AnimatedInterface::set_type(type);
 }
@@ -98,17 +139,110 @@ String
 ValueNode_Animated::get_string()const
 	{ return "ValueNode_Animated"; }
 
+bool
+ValueNode_Animated::update_waypoint_states(Time &begin, Time &end)
+{
+	WaypointStateList states;
+	states.reserve(waypoint_list().size());
+	for(WaypointList::const_iterator i = waypoint_list().begin(); i != waypoint_list().end(); ++i)
+		states.push_back(WaypointState(*i));
+	std::sort(states.begin(), states.end());
+
+	bool known = waypoint_states_valid && interpolation_state == get_interpolation();
+	waypoint_states.swap(states);
+	interpolation_state = get_interpolation();
+	waypoint_states_valid = true;
+	if (!known)
+		return false;
+
+	// now 'states' contains the previous waypoints
+	const WaypointStateList &prev = states;
+	const WaypointStateList &next = waypoint_states;
+	std::vector<Time> prev_times, next_times;
+	for(WaypointStateList::const_iterator i = prev.begin(); i != prev.end(); ++i)
+		prev_times.push_back(i->time);
+	for(WaypointStateList::const_iterator i = next.begin(); i != next.end(); ++i)
+		next_times.push_back(i->time);
+
+	bool changed = false;
+	begin = Time::end();
+	end = Time::begin();
+	size_t i = 0, j = 0;
+	while(i < prev.size() || j < next.size()) {
+		if (j == next.size() || (i < prev.size() && prev[i].time < next[j].time)) {
+			add_waypoint_influence(prev_times, i++, begin, end);
+			changed = true;
+		} else
+		if (i == prev.size() || next[j].time < prev[i].time) {
+			add_waypoint_influence(next_times, j++, begin, end);
+			changed = true;
+		} else {
+			if (!(prev[i] == next[j])) {
+				add_waypoint_influence(prev_times, i, begin, end);
+				add_waypoint_influence(next_times, j, begin, end);
+				changed = true;
+			}
+			++i, ++j;
+		}
+	}
+	return changed;
+}
+
 void
 ValueNode_Animated::on_changed()
 {
+	Time begin, end;
+	if (update_waypoint_states(begin, end)) {
+		// keep the interval of the changed waypoint value, if any
+		if (get_changed_time_begin() != Time::begin() || get_changed_time_end() != Time::end())
+			{ begin = std::min(begin, get_changed_time_begin()); end = std::max(end, get_changed_time_end()); }
+		set_changed_time(begin, end);
+	}
 	ValueNode::on_changed();
 	ValueNode_AnimatedInterface::on_changed();
 }
 
+void
+ValueNode_Animated::get_child_changed_time(const Node *x, Time &begin, Time &end) const
+{
+	WaypointStateList states;
+	for(WaypointList::const_iterator i = waypoint_list().begin(); i != waypoint_list().end(); ++i)
+		states.push_back(WaypointState(*i));
+	std::sort(states.begin(), states.end());
+
+	std::vector<Time> times;
+	for(WaypointStateList::const_iterator i = states.begin(); i != states.end(); ++i)
+		times.push_back(i->time);
+
+	begin = Time::end();
+	end = Time::begin();
+	bool found = false;
+	for(size_t i = 0; i < states.size(); ++i)
+		if (states[i].value_node == x)
+			{ add_waypoint_influence(times, i, begin, end); found = true; }
+	if (!found)
+		{ begin = Time::begin(); end = Time::end(); }
+}
+
+bool
+ValueNode_Animated::is_time_invariant() const
+{
+	if (waypoint_list().size() > 1)
+		return false;
+	for(WaypointList::const_iterator i = waypoint_list().begin(); i != waypoint_list().end(); ++i)
+		if (!i->get_value_node() || !i->get_value_node()->is_time_invariant())
+			return false;
+	return true;
+}
+
 ValueBase
 ValueNode_Animated::operator()(Time t) const
 	{ return ValueNode_AnimatedInterface::operator()(t); }
 
+void
+ValueNode_Animated::evaluate_many(const Time *times, size_t count, ValueBase *results) const
+	{ ValueNode_AnimatedInterface::evaluate_many(times, count, results); }
+
 void
 ValueNode_Animated::get_values_vfunc(std::map<Time, ValueBase> &x) const
 	{ ValueNode_AnimatedInterface::get_values_vfunc(x); }
@@ -30,6 +30,8 @@
 
 /* === H E A D E R S ======================================================= */
 
+#include <vector>
+
 #include <synfig/canvas.h>
 
 #include <synfig/valuenodes/valuenode_animatedinterface.h>
@@ -66,6 +68,9 @@ public:
 	static Handle create(ValueNode::Handle value_node, const Time& time);
 
 	virtual ValueBase operator()(Time t) const;
+	virtual void evaluate_many(const Time *times, size_t count, ValueBase *results) const;
+	//! Animated node is time-invariant when it has a single time-invariant waypoint
+	virtual bool is_time_invariant() const;
 	virtual Interpolation get_interpolation()const
 		{ return ValueNode_AnimatedInterfaceConst::get_interpolation(); }
 	virtual void set_interpolation(Interpolation i)
@@ -77,6 +82,30 @@ protected:
 	virtual void on_changed();
 	virtual void get_times_vfunc(Node::time_set &set) const;
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const;
+	//! Change of a waypoint value affects only the neighbour segments
+	virtual void get_child_changed_time(const Node *x, Time &begin, Time &end) const;
+
+private:
+	struct WaypointState {
+		Time time;
+		const Node *value_node;
+		Interpolation before, after;
+		Real tension, continuity, bias, temporal_tension;
+
+		explicit WaypointState(const Waypoint &waypoint);
+		bool operator< (const WaypointState &other) const { return time < other.time; }
+		bool operator== (const WaypointState &other) const;
+	};
+	typedef std::vector<WaypointState> WaypointStateList;
+
+	//! Waypoints at the moment of the previous change, used to find which of them were changed
+	WaypointStateList waypoint_states;
+	Interpolation interpolation_state;
+	bool waypoint_states_valid;
+
+	//! Compares waypoints with the stored ones and stores the new ones.
+	//! Returns false if changes are unknown or there are no changes
+	bool update_waypoint_states(Time &begin, Time &end);
 };
 
 }; // END of namespace synfig
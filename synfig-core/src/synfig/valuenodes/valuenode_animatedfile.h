@@ -65,6 +65,8 @@ public:
 	virtual ~ValueNode_AnimatedFile();
 
 	virtual ValueBase operator()(Time t) const override;
+	//! Values are read from the file at the requested time
+	virtual bool is_time_invariant() const override { return false; }
 
 	virtual String get_name() const override;
 	virtual String get_local_name() const override;
@@ -36,6 +36,7 @@
 #include <cmath>
 
 #include <algorithm>
+#include <atomic>
 #include <typeinfo>
 #include <vector>
 #include <list>
@@ -66,18 +67,6 @@ using namespace synfig;
 
 /* === C L A S S E S ======================================================= */
 
-struct timecmp
-{
-	Time t;
-
-	timecmp(const Time &c) :t(c) {}
-
-	bool operator()(const Waypoint &rhs) const
-	{
-		return t.is_equal(rhs.get_time());
-	}
-};
-
 template<class T>
 struct subtractor
 	{ T operator()(const T &a,const T &b)const { return a-b; } };
@@ -242,6 +231,23 @@ public:
 	virtual void on_changed() = 0;
 	virtual ValueBase operator()(Time t) const = 0;
 
+	virtual void evaluate_many(const Time *times, size_t count, ValueBase *results) const
+	{
+		for(size_t i = 0; i < count; ++i)
+			results[i] = (*this)(times[i]);
+	}
+
+	//! Returns the last waypoint which is not later than \a t,
+	//! \a t must not be earlier than the first waypoint
+	WaypointList::const_iterator find_waypoint_at(const Time &t) const
+	{
+		WaypointList::const_iterator iter = std::upper_bound(
+			animated.waypoint_list().begin(), animated.waypoint_list().end(), t,
+			[](const Time &t, const Waypoint &waypoint) { return waypoint > t; } );
+		assert(iter != animated.waypoint_list().begin());
+		return --iter;
+	}
+
 	virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const
 	{
 		// TODO: special case for discrete interpolation mode
@@ -343,15 +349,43 @@ public:
 		// Bounds of this curve
 		Time r,s;
 
+		// Segment found by the previous call, playback
+		// usually asks for the same or for the next one.
+		// Frames may be evaluated in parallel, so it's atomic,
+		// and a stale value only costs a binary search
+		mutable std::atomic<size_t> last_segment;
+
+		bool is_segment_at(size_t index, const Time &t) const
+		{
+			return index < curve_list.size()
+			    && t < curve_list[index].first.get_s()
+			    && (index == 0 || t >= curve_list[index - 1].first.get_s());
+		}
+
+		// Returns index of the first segment which ends after \a t
+		size_t find_segment(const Time &t) const
+		{
+			size_t index = last_segment.load(std::memory_order_relaxed);
+			if (is_segment_at(index, t))
+				return index;
+			if (!is_segment_at(++index, t))
+				index = std::upper_bound(
+					curve_list.begin(), curve_list.end(), t,
+					[](const Time &t, const PathSegment &segment) { return t < segment.first.get_s(); }
+				) - curve_list.begin();
+			last_segment.store(index, std::memory_order_relaxed);
+			return index;
+		}
+
 	public:
-		Hermite(ValueNode_AnimatedInterfaceConst &node): Interpolator(node) { }
+		Hermite(ValueNode_AnimatedInterfaceConst &node): Interpolator(node), last_segment(0) { }
 
 		virtual Interpolator* create(ValueNode_AnimatedInterfaceConst &node) const
 			{ return new Hermite(node); }
 
 		virtual WaypointList::iterator new_waypoint(Time t, ValueBase value)
 		{
-			try { animated.find(t); throw Exception::BadTime(_("A waypoint already exists at this point in time")); } catch(Exception::NotFound&) { };
+			if (animated.find_time(t).second) throw Exception::BadTime(_("A waypoint already exists at this point in time"));
 			Waypoint waypoint(value, t);
 			waypoint.set_parent_value_node(&animated.node());
 
@@ -372,7 +406,7 @@ public:
 
 		virtual WaypointList::iterator new_waypoint(Time t, ValueNode::Handle value_node)
 		{
-			try { animated.find(t); throw Exception::BadTime(_("A waypoint already exists at this point in time")); } catch(Exception::NotFound&) { };
+			if (animated.find_time(t).second) throw Exception::BadTime(_("A waypoint already exists at this point in time"));
 
 			Waypoint waypoint(value_node,t);
 			waypoint.set_parent_value_node(&animated.node());
@@ -405,6 +439,7 @@ public:
 			s=animated.waypoint_list_.back().get_time();
 
 			curve_list.clear();
+			last_segment.store(0, std::memory_order_relaxed);
 
 			WaypointList::iterator iter,next=animated.waypoint_list_.begin();
 			// The curve list must be calculated because we sorted the waypoints.
@@ -645,26 +680,36 @@ public:
 			}
 		}
 
-		virtual ValueBase operator()(Time t)const
+		//! Calculates value when there are at least two waypoints
+		ValueBase resolve(Time t)const
 		{
-			if(animated.waypoint_list_.empty())
-				return value_type();	//! \todo Perhaps we should throw something here?
-			if(animated.waypoint_list_.size()==1)
-				return animated.waypoint_list_.front().get_value(t);
 			if(t<=r)
 				return animated.waypoint_list_.front().get_value(t);
 			if(t>=s)
 				return animated.waypoint_list_.back().get_value(t);
 
-			typename curve_list_type::const_iterator iter;
-
-			// This next line will set iter to the
-			// correct iterator for the given time.
-			for(iter=curve_list.begin();iter<curve_list.end() && t>=iter->first.get_s();++iter)
-				continue;
-			if(iter==curve_list.end())
+			size_t index = find_segment(t);
+			if(index >= curve_list.size())
 				return animated.waypoint_list_.back().get_value(t);
-			return iter->resolve(t);
+			return curve_list[index].resolve(t);
+		}
+
+		virtual ValueBase operator()(Time t)const
+		{
+			if(animated.waypoint_list_.empty())
+				return value_type();	//! \todo Perhaps we should throw something here?
+			if(animated.waypoint_list_.size()==1)
+				return animated.waypoint_list_.front().get_value(t);
+			return resolve(t);
+		}
+
+		virtual void evaluate_many(const Time *times, size_t count, ValueBase *results)const
+		{
+			if(animated.waypoint_list_.size() < 2)
+				{ Interpolator::evaluate_many(times, count, results); return; }
+			// ordered times hit the cached segment, so no search is needed
+			for(size_t i = 0; i < count; ++i)
+				results[i] = resolve(times[i]);
 		}
 	}; // END of class Hermite
 
@@ -692,7 +737,7 @@ public:
 			// Make sure we are getting data of the correct type
 			//if(data.type!=type)
 			//	return waypoint_list_type::iterator();
-			try { animated.find(t); throw Exception::BadTime(_("A waypoint already exists at this point in time")); } catch(Exception::NotFound&) { };
+			if (animated.find_time(t).second) throw Exception::BadTime(_("A waypoint already exists at this point in time"));
 
 			Waypoint waypoint(value,t);
 			waypoint.set_parent_value_node(&animated.node());
@@ -710,7 +755,7 @@ public:
 			// Make sure we are getting data of the correct type
 			//if(data.type!=type)
 			//	return waypoint_list_type::iterator();
-			try { animated.find(t); throw Exception::BadTime(_("A waypoint already exists at this point in time")); } catch(Exception::NotFound&) { };
+			if (animated.find_time(t).second) throw Exception::BadTime(_("A waypoint already exists at this point in time"));
 
 			Waypoint waypoint(value_node,t);
 			waypoint.set_parent_value_node(&animated.node());
@@ -747,15 +792,7 @@ public:
 			if(t>=s)
 				return animated.waypoint_list_.back().get_value(t);
 
-			WaypointList::const_iterator iter;
-			WaypointList::const_iterator next;
-
-			// This next line will set iter to the
-			// correct iterator for the given time.
-			for(next=animated.waypoint_list_.begin(),iter=next++;next!=animated.waypoint_list_.end() && t>=next->get_time();iter=next++)
-				continue;
-
-			return iter->get_value(t);
+			return find_waypoint_at(t)->get_value(t);
 		}
 
 		virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const
@@ -782,7 +819,7 @@ public:
 			// Make sure we are getting data of the correct type
 			//if(data.type!=type)
 			//	return waypoint_list_type::iterator();
-			try { animated.find(t); throw Exception::BadTime(_("A waypoint already exists at this point in time")); } catch(Exception::NotFound&) { };
+			if (animated.find_time(t).second) throw Exception::BadTime(_("A waypoint already exists at this point in time"));
 
 
 			Waypoint waypoint(value,t);
@@ -801,7 +838,7 @@ public:
 			// Make sure we are getting data of the correct type
 			//if(data.type!=type)
 			//	return waypoint_list_type::iterator();
-			try { animated.find(t); throw Exception::BadTime(_("A waypoint already exists at this point in time")); } catch(Exception::NotFound&) { };
+			if (animated.find_time(t).second) throw Exception::BadTime(_("A waypoint already exists at this point in time"));
 
 			Waypoint waypoint(value_node,t);
 			waypoint.set_parent_value_node(&animated.node());
@@ -838,13 +875,8 @@ public:
 			if(t>=s)
 				return animated.waypoint_list_.back().get_value(t);
 
-			WaypointList::const_iterator iter = animated.waypoint_list_.begin();
-
 			// A waypoint sets the boolean value until next waypoint
-			for (auto next = iter+1; next != animated.waypoint_list_.end(); iter = next++)
-				if (iter->get_time()==t || t < next->get_time())
-					return iter->get_value(t);
-			return iter->get_value(t);
+			return find_waypoint_at(t)->get_value(t);
 		}
 
 		virtual void get_values_vfunc(std::map<Time, ValueBase> &x) const
@@ -866,33 +898,21 @@ ValueNode_AnimatedInterfaceConst::ValueNode_AnimatedInterfaceConst(ValueNode &no
 int
 ValueNode_AnimatedInterfaceConst::find(const Time& begin, const Time& end, std::vector<Waypoint*>& selected)
 {
-	Time curr_time(begin);
 	int ret(0);
 
 	// try to grab first waypoint
-	try
+	findresult f = find_time(begin);
+	if(f.second)
 	{
-		WaypointList::iterator iter;
-		iter=find(curr_time);
-		selected.push_back(&*iter);
+		selected.push_back(&*f.first);
 		ret++;
 	}
-	catch(...) { }
 
-	try
+	for(WaypointList::iterator iter = find_time_next(begin).first; iter != editable_waypoint_list().end() && iter->get_time() < end; ++iter)
 	{
-		WaypointList::iterator iter;
-		while(true)
-		{
-			iter=find_next(curr_time);
-			curr_time=iter->get_time();
-			if(curr_time>=end)
-				break;
-			selected.push_back(&*iter);
-			ret++;
-		}
+		selected.push_back(&*iter);
+		ret++;
 	}
-	catch(...) { }
 
 	return ret;
 }
@@ -900,33 +920,21 @@ ValueNode_AnimatedInterfaceConst::find(const Time& begin, const Time& end, std::
 int
 ValueNode_AnimatedInterfaceConst::find(const Time& begin, const Time& end, std::vector<const Waypoint*>& selected) const
 {
-	Time curr_time(begin);
 	int ret(0);
 
 	// try to grab first waypoint
-	try
+	const_findresult f = find_time(begin);
+	if(f.second)
 	{
-		WaypointList::const_iterator iter;
-		iter=find(curr_time);
-		selected.push_back(&*iter);
+		selected.push_back(&*f.first);
 		ret++;
 	}
-	catch(...) { }
 
-	try
+	for(WaypointList::const_iterator iter = find_time_next(begin).first; iter != waypoint_list().end() && iter->get_time() < end; ++iter)
 	{
-		WaypointList::const_iterator iter;
-		while(true)
-		{
-			iter=find_next(curr_time);
-			curr_time=iter->get_time();
-			if(curr_time>=end)
-				break;
-			selected.push_back(&*iter);
-			ret++;
-		}
+		selected.push_back(&*iter);
+		ret++;
 	}
-	catch(...) { }
 
 	return ret;
 }
@@ -958,6 +966,10 @@ ValueBase
 ValueNode_AnimatedInterfaceConst::operator()(Time t) const
 	{ return (*interpolator_)(t); }
 
+void
+ValueNode_AnimatedInterfaceConst::evaluate_many(const Time *times, size_t count, ValueBase *results) const
+	{ interpolator_->evaluate_many(times, count, results); }
+
 void
 ValueNode_AnimatedInterfaceConst::get_values_vfunc(std::map<Time, ValueBase> &x) const
 	{ interpolator_->get_values_vfunc(x); }
@@ -966,36 +978,29 @@ Waypoint
 ValueNode_AnimatedInterfaceConst::new_waypoint_at_time(const Time& time)const
 {
 	Waypoint waypoint;
-	try
+	const_findresult f = find_time(time);
+	if(f.second)
 	{
 		// Trivial case, we are sitting on a waypoint
-		waypoint=*find(time);
+		waypoint=*f.first;
 		waypoint.make_unique();
 	}
-	catch(...)
+	else
+	if(waypoint_list().empty())
 	{
-		if(waypoint_list().empty())
-		{
-			waypoint.set_value((*this)(time));
-		}
-		else
-		{
-			WaypointList::const_iterator prev;
-			WaypointList::const_iterator next;
-
-			bool has_prev(false), has_next(false);
-
-			try { prev=find_prev(time); has_prev=true; } catch(...) { }
-			try { next=find_next(time); has_next=true; } catch(...) { }
-
-			if(has_prev && !prev->is_static())
-				waypoint.set_value_node(prev->get_value_node());
-			if(has_next && !next->is_static())
-				waypoint.set_value_node(next->get_value_node());
-			else
-				waypoint.set_value((*this)(time));
+		waypoint.set_value((*this)(time));
+	}
+	else
+	{
+		const_findresult prev = find_time_prev(time);
+		const_findresult next = find_time_next(time);
 
-		}
+		if(prev.second && !prev.first->is_static())
+			waypoint.set_value_node(prev.first->get_value_node());
+		if(next.second && !next.first->is_static())
+			waypoint.set_value_node(next.first->get_value_node());
+		else
+			waypoint.set_value((*this)(time));
 	}
 	waypoint.set_time(time);
 	waypoint.set_parent_value_node(&const_cast<ValueNode_AnimatedInterfaceConst*>(this)->node());
@@ -1022,10 +1027,9 @@ ValueNode_AnimatedInterfaceConst::find(const UniqueID &x)const
 ValueNode_AnimatedInterfaceConst::WaypointList::iterator
 ValueNode_AnimatedInterfaceConst::find(const Time &x)
 {
-	WaypointList::iterator iter(binary_find(editable_waypoint_list().begin(),editable_waypoint_list().end(),x));
-
-	if(iter!=editable_waypoint_list().end() && x.is_equal(iter->get_time()))
-		return iter;
+	findresult f = find_time(x);
+	if(f.second)
+		return f.first;
 
 	throw Exception::NotFound(strprintf("ValueNode_AnimatedInterfaceConst::find(): Can't find Waypoint at %s",x.get_string().c_str()));
 }
@@ -1039,16 +1043,9 @@ ValueNode_AnimatedInterfaceConst::find(const Time &x)const
 ValueNode_AnimatedInterfaceConst::WaypointList::iterator
 ValueNode_AnimatedInterfaceConst::find_next(const Time &x)
 {
-	WaypointList::iterator iter(binary_find(editable_waypoint_list().begin(),editable_waypoint_list().end(),x));
-
-	if(iter!=editable_waypoint_list().end())
-	{
-		if(iter->get_time().is_more_than(x))
-			return iter;
-		++iter;
-		if(iter!=editable_waypoint_list().end() && iter->get_time().is_more_than(x))
-			return iter;
-	}
+	findresult f = find_time_next(x);
+	if(f.second)
+		return f.first;
 
 	throw Exception::NotFound(strprintf("ValueNode_AnimatedInterfaceConst::find_next(): Can't find Waypoint after %s",x.get_string().c_str()));
 }
@@ -1062,15 +1059,9 @@ ValueNode_AnimatedInterfaceConst::find_next(const Time &x)const
 ValueNode_AnimatedInterfaceConst::WaypointList::iterator
 ValueNode_AnimatedInterfaceConst::find_prev(const Time &x)
 {
-	WaypointList::iterator iter(binary_find(editable_waypoint_list().begin(),editable_waypoint_list().end(),x));
-
-	if(iter!=editable_waypoint_list().end())
-	{
-		if(iter->get_time().is_less_than(x))
-			return iter;
-		if(iter!=editable_waypoint_list().begin() && (--iter)->get_time().is_less_than(x))
-			return iter;
-	}
+	findresult f = find_time_prev(x);
+	if(f.second)
+		return f.first;
 
 	throw Exception::NotFound(strprintf("ValueNode_AnimatedInterfaceConst::find_prev(): Can't find Waypoint after %s",x.get_string().c_str()));
 }
@@ -1236,7 +1227,9 @@ ValueNode_AnimatedInterfaceConst::find_time(const Time &x)
  	f.second = false;
 
  	//search for it... and set the bool part of the return value to true if we found it!
- 	f.first = std::find_if(waypoint_list_.begin(), waypoint_list_.end(), timecmp(x));
+ 	//the list may be unsorted while waypoints are edited, so binary search is not enough
+ 	f.first = std::find_if(waypoint_list_.begin(), waypoint_list_.end(),
+ 		[&x](const Waypoint &waypoint) { return waypoint == x; } );
  	if(f.first != waypoint_list_.end())
  		f.second = true;
 
@@ -1246,15 +1239,42 @@ ValueNode_AnimatedInterfaceConst::find_time(const Time &x)
 ValueNode_AnimatedInterfaceConst::const_findresult
 ValueNode_AnimatedInterfaceConst::find_time(const Time &x)const
 {
- 	const_findresult	f;
- 	f.second = false;
+	return const_cast<ValueNode_AnimatedInterfaceConst*>(this)->find_time(x);
+}
 
- 	//search for it... and set the bool part of the return value to true if we found it!
- 	f.first = std::find_if(waypoint_list_.begin(), waypoint_list_.end(), timecmp(x));
- 	if(f.first != waypoint_list_.end())
- 		f.second = true;
+ValueNode_AnimatedInterfaceConst::findresult
+ValueNode_AnimatedInterfaceConst::find_time_next(const Time &x)
+{
+	findresult	f;
+	f.first = std::upper_bound(waypoint_list_.begin(), waypoint_list_.end(), x,
+		[](const Time &t, const Waypoint &waypoint) { return waypoint > t; } );
+	f.second = f.first != waypoint_list_.end();
+	return f;
+}
 
- 	return f;
+ValueNode_AnimatedInterfaceConst::const_findresult
+ValueNode_AnimatedInterfaceConst::find_time_next(const Time &x)const
+{
+	return const_cast<ValueNode_AnimatedInterfaceConst*>(this)->find_time_next(x);
+}
+
+ValueNode_AnimatedInterfaceConst::findresult
+ValueNode_AnimatedInterfaceConst::find_time_prev(const Time &x)
+{
+	findresult	f;
+	f.first = std::lower_bound(waypoint_list_.begin(), waypoint_list_.end(), x);
+	f.second = f.first != waypoint_list_.begin();
+	if(f.second)
+		--f.first;
+	else
+		f.first = waypoint_list_.end();
+	return f;
+}
+
+ValueNode_AnimatedInterfaceConst::const_findresult
+ValueNode_AnimatedInterfaceConst::find_time_prev(const Time &x)const
+{
+	return const_cast<ValueNode_AnimatedInterfaceConst*>(this)->find_time_prev(x);
 }
 
 void
@@ -1262,16 +1282,14 @@ ValueNode_AnimatedInterfaceConst::insert_time(const Time& location, const Time&
 {
 	if(!delta)
 		return;
-	try
+	findresult f = find_time_next(location);
+	if(!f.second)
+		return;
+	for(WaypointList::iterator iter = f.first; iter!=waypoint_list().end(); ++iter)
 	{
-		WaypointList::iterator iter(find_next(location));
-		for(;iter!=waypoint_list().end();++iter)
-		{
-			iter->set_time(iter->get_time()+delta);
-		}
-		animated_changed();
+		iter->set_time(iter->get_time()+delta);
 	}
-	catch(Exception::NotFound&) { }
+	animated_changed();
 }
 
 void
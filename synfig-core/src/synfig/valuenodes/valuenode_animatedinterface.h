@@ -105,6 +105,10 @@ protected:
 	findresult 			   find_uid(const UniqueID &x);
 	//! Finds Waypoint iterator and associated boolean if found. Find by Time
 	findresult			   find_time(const Time &x);
+	//! Finds the first Waypoint after a given time \x and associated boolean if found
+	findresult			   find_time_next(const Time &x);
+	//! Finds the last Waypoint before a given time \x and associated boolean if found
+	findresult			   find_time_prev(const Time &x);
 	//! Finds a Waypoint by given UniqueID \x
 	WaypointList::iterator find(const UniqueID &x);
 	//! Finds a Waypoint by given Time \x
@@ -122,6 +126,7 @@ protected:
 
 	void on_changed();
 	ValueBase operator()(Time t) const;
+	void evaluate_many(const Time *times, size_t count, ValueBase *results) const;
 	void get_times_vfunc(Node::time_set &set) const;
 	void get_values_vfunc(std::map<Time, ValueBase> &x) const;
 
@@ -142,6 +147,10 @@ public:
 	const_findresult 	         find_uid(const UniqueID &x)const;
 	//! Finds Waypoint iterator and associated boolean if found. Find by Time
 	const_findresult	         find_time(const Time &x)const;
+	//! Finds the first Waypoint after a given time \x and associated boolean if found
+	const_findresult	         find_time_next(const Time &x)const;
+	//! Finds the last Waypoint before a given time \x and associated boolean if found
+	const_findresult	         find_time_prev(const Time &x)const;
 	//! Finds a Waypoint by given UniqueID \x
 	WaypointList::const_iterator find(const UniqueID &x)const;
 	//! Finds a Waypoint by given Time \x
@@ -170,6 +179,8 @@ public:
 
 	using ValueNode_AnimatedInterfaceConst::find_uid;
 	using ValueNode_AnimatedInterfaceConst::find_time;
+	using ValueNode_AnimatedInterfaceConst::find_time_next;
+	using ValueNode_AnimatedInterfaceConst::find_time_prev;
 	using ValueNode_AnimatedInterfaceConst::find;
 	using ValueNode_AnimatedInterfaceConst::find_next;
 	using ValueNode_AnimatedInterfaceConst::find_prev;
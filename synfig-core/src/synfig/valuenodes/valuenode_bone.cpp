@@ -40,6 +40,7 @@
 #include <synfig/localization.h>
 #include <synfig/valuenode_registry.h>
 #include <synfig/canvas.h>
+#include <vector>
 
 #endif
 
@@ -437,6 +438,11 @@ ValueNode_Bone::operator()(Time t)const
 
 //	show_bone_map(get_root_canvas(), __FILE__, __LINE__, strprintf("in op() at %s", t.get_string().c_str()), t);
 
+	// bone usually drives many vertices of the rig
+	ValueBase cached;
+	if (ValueNodeEvaluationPass::find(this, t, cached))
+		return cached;
+
 	String bone_name			((*name_	)(t).get(String()));
 	ValueNode_Bone::ConstHandle   bone_parent			(get_parent(t));
 #ifndef HIDE_BONE_FIELDS
@@ -469,9 +475,55 @@ ValueNode_Bone::operator()(Time t)const
 	ret.set_animated_matrix	(bone_animated_matrix);
 #endif
 
+	ValueNodeEvaluationPass::store(this, t, ret);
 	return ret;
 }
 
+void
+ValueNode_Bone::evaluate_many(const Time *times, size_t count, ValueBase *results)const
+{
+	// links are evaluated for the whole batch, the parent and the animated matrix
+	// depend on the other bones, so they are resolved for each sample
+	std::vector<ValueBase> names(count);
+	name_->evaluate_many(times, count, names.data());
+#ifndef HIDE_BONE_FIELDS
+	std::vector<ValueBase> origins(count), angles(count), scalelxs(count), scalexs(count),
+	                       lengths(count), widths(count), tipwidths(count), depths(count);
+	origin_->evaluate_many(times, count, origins.data());
+	angle_->evaluate_many(times, count, angles.data());
+	scalelx_->evaluate_many(times, count, scalelxs.data());
+	scalex_->evaluate_many(times, count, scalexs.data());
+	length_->evaluate_many(times, count, lengths.data());
+	width_->evaluate_many(times, count, widths.data());
+	tipwidth_->evaluate_many(times, count, tipwidths.data());
+	depth_->evaluate_many(times, count, depths.data());
+#endif
+
+	for(size_t i = 0; i < count; ++i)
+	{
+		ValueNode_Bone::ConstHandle bone_parent(get_parent(times[i]));
+
+		Bone ret;
+		ret.set_name			(names[i].get(String()));
+		ret.set_parent			(bone_parent.get());
+#ifndef HIDE_BONE_FIELDS
+		Point bone_origin(origins[i].get(Point()));
+		Angle bone_angle(angles[i].get(Angle()));
+		Real  bone_scalex(scalexs[i].get(Real()));
+		ret.set_origin			(bone_origin);
+		ret.set_angle			(bone_angle);
+		ret.set_scalelx			(scalelxs[i].get(Real()));
+		ret.set_scalex			(bone_scalex);
+		ret.set_length			(lengths[i].get(Real()));
+		ret.set_width			(widths[i].get(Real()));
+		ret.set_tipwidth		(tipwidths[i].get(Real()));
+		ret.set_depth			(depths[i].get(Real()));
+		ret.set_animated_matrix	(get_animated_matrix(times[i], bone_scalex, 1.0, bone_angle, bone_origin, bone_parent));
+#endif
+		results[i] = ret;
+	}
+}
+
 ValueNode::Handle
 ValueNode_Bone::clone(Canvas::LooseHandle canvas, const GUID& deriv_guid)const
 {
@@ -1012,6 +1064,13 @@ ValueNode_Bone_Root::operator()(Time /*t*/)const
 	return ret;
 }
 
+void
+ValueNode_Bone_Root::evaluate_many(const Time *times, size_t count, ValueBase *results)const
+{
+	// root bone has no links
+	ValueNode::evaluate_many(times, count, results);
+}
+
 void
 ValueNode_Bone_Root::set_guid(const GUID& new_guid)
 {
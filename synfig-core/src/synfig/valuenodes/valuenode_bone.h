@@ -72,6 +72,7 @@ public:
 	virtual ValueNode::Handle clone(etl::loose_handle<Canvas> canvas, const GUID& deriv_guid=GUID()) const override;
 
 	virtual ValueBase operator()(Time t) const override;
+	virtual void evaluate_many(const Time *times, size_t count, ValueBase *results) const override;
 
 	virtual String get_name() const override;
 	virtual String get_local_name() const override;
@@ -144,6 +145,7 @@ public:
 	virtual ~ValueNode_Bone_Root();
 
 	virtual ValueBase operator()(Time t) const override;
+	virtual void evaluate_many(const Time *times, size_t count, ValueBase *results) const override;
 
 	virtual String get_name() const override;
 	virtual String get_local_name() const override;
@@ -177,8 +177,18 @@ ValueNode_BoneLink::operator()(Time t)const
 {
 	DEBUG_LOG("SYNFIG_DEBUG_VALUENODE_OPERATORS",
 		"%s:%d operator()\n", __FILE__, __LINE__);
-	return ValueTransformation::transform(
+
+	bool shared = is_shared();
+	ValueBase ret;
+	if (shared && ValueNodeEvaluationPass::find(this, t, ret))
+		return ret;
+
+	ret = ValueTransformation::transform(
 		get_bone_transformation(t), (*base_value_)(t) );
+
+	if (shared)
+		ValueNodeEvaluationPass::store(this, t, ret);
+	return ret;
 }
 
 
@@ -52,6 +52,7 @@
 #include <synfig/blinepoint.h>
 #include <synfig/widthpoint.h>
 #include <synfig/dashitem.h>
+#include <vector>
 
 #endif
 
@@ -220,13 +221,44 @@ synfig::ValueNode_Composite::operator()(Time t)const
 	DEBUG_LOG("SYNFIG_DEBUG_VALUENODE_OPERATORS",
 		"%s:%d operator()\n", __FILE__, __LINE__);
 
+	bool shared = is_shared();
+	ValueBase ret;
+	if (shared && ValueNodeEvaluationPass::find(this, t, ret))
+		return ret;
+
+	ValueBase values[MAX_LINKS];
+	for(int i = 0; i < MAX_LINKS && components[i]; ++i)
+		values[i] = (*components[i])(t);
+	ret = compose(values, 1);
+
+	if (shared)
+		ValueNodeEvaluationPass::store(this, t, ret);
+	return ret;
+}
+
+void
+ValueNode_Composite::evaluate_many(const Time *times, size_t count, ValueBase *results)const
+{
+	// values of component i are stored at values[i*count + sample]
+	int links = 0;
+	while(links < MAX_LINKS && components[links]) ++links;
+	std::vector<ValueBase> values(links*count);
+	for(int i = 0; i < links; ++i)
+		components[i]->evaluate_many(times, count, &values[i*count]);
+	for(size_t j = 0; j < count; ++j)
+		results[j] = compose(&values[j], count);
+}
+
+ValueBase
+ValueNode_Composite::compose(const ValueBase *values, size_t stride)const
+{
 	Type &type(get_type());
 	if (type == type_vector)
 	{
 		Vector vect;
 		assert(components[0] && components[1]);
-		vect[0]=(*components[0])(t).get(Vector::value_type());
-		vect[1]=(*components[1])(t).get(Vector::value_type());
+		vect[0]=values[0].get(Vector::value_type());
+		vect[1]=values[stride].get(Vector::value_type());
 		return vect;
 	}
 	else
@@ -234,10 +266,10 @@ synfig::ValueNode_Composite::operator()(Time t)const
 	{
 		Color color;
 		assert(components[0] && components[1] && components[2] && components[3]);
-		color.set_r((*components[0])(t).get(Vector::value_type()));
-		color.set_g((*components[1])(t).get(Vector::value_type()));
-		color.set_b((*components[2])(t).get(Vector::value_type()));
-		color.set_a((*components[3])(t).get(Vector::value_type()));
+		color.set_r(values[0].get(Vector::value_type()));
+		color.set_g(values[stride].get(Vector::value_type()));
+		color.set_b(values[2*stride].get(Vector::value_type()));
+		color.set_a(values[3*stride].get(Vector::value_type()));
 		return color;
 	}
 	else
@@ -245,10 +277,10 @@ synfig::ValueNode_Composite::operator()(Time t)const
 	{
 		Segment seg;
 		assert(components[0] && components[1] && components[2] && components[3]);
-		seg.p1=(*components[0])(t).get(Point());
-		seg.t1=(*components[1])(t).get(Vector());
-		seg.p2=(*components[2])(t).get(Point());
-		seg.t2=(*components[3])(t).get(Vector());
+		seg.p1=values[0].get(Point());
+		seg.t1=values[stride].get(Vector());
+		seg.p2=values[2*stride].get(Point());
+		seg.t2=values[3*stride].get(Vector());
 		return seg;
 	}
 	else
@@ -256,14 +288,14 @@ synfig::ValueNode_Composite::operator()(Time t)const
 	{
 		BLinePoint ret;
 		assert(components[0] && components[1] && components[2] && components[3] && components[4] && components[5] && components[6] && components[7]);
-		ret.set_vertex((*components[0])(t).get(Point()));
-		ret.set_width((*components[1])(t).get(Real()));
-		ret.set_origin((*components[2])(t).get(Real()));
-		ret.set_split_tangent_both((*components[3])(t).get(bool()));
-		ret.set_split_tangent_radius((*components[6])(t).get(bool()));
-		ret.set_split_tangent_angle((*components[7])(t).get(bool()));
-		ret.set_tangent1((*components[4])(t).get(Vector()));
-		ret.set_tangent2((*components[5])(t).get(Vector()));
+		ret.set_vertex(values[0].get(Point()));
+		ret.set_width(values[stride].get(Real()));
+		ret.set_origin(values[2*stride].get(Real()));
+		ret.set_split_tangent_both(values[3*stride].get(bool()));
+		ret.set_split_tangent_radius(values[6*stride].get(bool()));
+		ret.set_split_tangent_angle(values[7*stride].get(bool()));
+		ret.set_tangent1(values[4*stride].get(Vector()));
+		ret.set_tangent2(values[5*stride].get(Vector()));
 		return ret;
 	}
 	else
@@ -271,12 +303,12 @@ synfig::ValueNode_Composite::operator()(Time t)const
 	{
 		WidthPoint ret;
 		assert(components[0] && components[1] && components[2] && components[3] && components[4] && components[5]);
-		ret.set_position((*components[0])(t).get(Real()));
-		ret.set_width((*components[1])(t).get(Real()));
-		ret.set_side_type_before((*components[2])(t).get(int()));
-		ret.set_side_type_after((*components[3])(t).get(int()));
-		ret.set_lower_bound((*components[4])(t).get(Real()));
-		ret.set_upper_bound((*components[5])(t).get(Real()));
+		ret.set_position(values[0].get(Real()));
+		ret.set_width(values[stride].get(Real()));
+		ret.set_side_type_before(values[2*stride].get(int()));
+		ret.set_side_type_after(values[3*stride].get(int()));
+		ret.set_lower_bound(values[4*stride].get(Real()));
+		ret.set_upper_bound(values[5*stride].get(Real()));
 		return ret;
 	}
 	else
@@ -284,14 +316,14 @@ synfig::ValueNode_Composite::operator()(Time t)const
 	{
 		DashItem ret;
 		assert(components[0] && components[1] && components[2] && components[3]);
-		Real offset((*components[0])(t).get(Real()));
+		Real offset(values[0].get(Real()));
 		if(offset < 0.0) offset=0.0;
-		Real length((*components[1])(t).get(Real()));
+		Real length(values[stride].get(Real()));
 		if(length < 0.0) length=0.0;
 		ret.set_offset(offset);
 		ret.set_length(length);
-		ret.set_side_type_before((*components[2])(t).get(int()));
-		ret.set_side_type_after((*components[3])(t).get(int()));
+		ret.set_side_type_before(values[2*stride].get(int()));
+		ret.set_side_type_after(values[3*stride].get(int()));
 		return ret;
 	}
 	else
@@ -299,28 +331,28 @@ synfig::ValueNode_Composite::operator()(Time t)const
 	{
 		Transformation ret;
 		assert(components[0] && components[1] && components[2] && components[3]);
-		ret.offset    = (*components[0])(t).get(Vector());
-		ret.angle     = (*components[1])(t).get(Angle());
-		ret.skew_angle = (*components[2])(t).get(Angle());
-		ret.scale     = (*components[3])(t).get(Vector());
+		ret.offset    = values[0].get(Vector());
+		ret.angle     = values[stride].get(Angle());
+		ret.skew_angle = values[2*stride].get(Angle());
+		ret.scale     = values[3*stride].get(Vector());
 		return ret;
 	}
 	else
 	if (types_namespace::TypeWeightedValueBase *tp = dynamic_cast<types_namespace::TypeWeightedValueBase*>(&type))
 	{
 		assert(components[0] && components[1]);
-		return tp->create_weighted_value((*components[0])(t).get(Real()), (*components[1])(t));
+		return tp->create_weighted_value(values[0].get(Real()), values[stride]);
 	}
 	else
 	if (types_namespace::TypePairBase *tp =dynamic_cast<types_namespace::TypePairBase*>(&type))
 	{
 		assert(components[0] && components[1]);
-		return tp->create_value((*components[0])(t), (*components[1])(t));
+		return tp->create_value(values[0], values[stride]);
 	}
 
-	synfig::error(std::string("ValueNode_Composite::operator():")+_("Bad type for composite"));
+	synfig::error(std::string("ValueNode_Composite::compose():")+_("Bad type for composite"));
 	assert(components[0]);
-	return (*components[0])(t);
+	return values[0];
 }
 
 bool
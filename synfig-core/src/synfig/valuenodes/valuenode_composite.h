@@ -55,6 +55,7 @@ public:
 	virtual ~ValueNode_Composite();
 
 	virtual ValueBase operator()(Time t) const override;
+	virtual void evaluate_many(const Time *times, size_t count, ValueBase *results) const override;
 
 	virtual String get_name() const override;
 	virtual String get_local_name() const override;
@@ -66,6 +67,10 @@ public:
 protected:
 	LinkableValueNode* create_new() const override;
 
+	//! Builds the value from already evaluated components,
+	//! component \a i is taken from values[i*stride]
+	ValueBase compose(const ValueBase *values, size_t stride) const;
+
 	virtual bool set_link_vfunc(int i,ValueNode::Handle x) override;
 	virtual ValueNode::LooseHandle get_link_vfunc(int i) const override;
 
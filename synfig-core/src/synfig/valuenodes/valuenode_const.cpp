@@ -40,6 +40,7 @@
 #include <synfig/canvas.h>
 #include <synfig/localization.h>
 #include <synfig/pair.h>
+#include <algorithm>
 
 #endif
 
@@ -129,6 +130,12 @@ ValueNode_Const::operator()(Time /*t*/)const
 	return value;
 }
 
+void
+ValueNode_Const::evaluate_many(const Time *, size_t count, ValueBase *results)const
+{
+	std::fill(results, results + count, value);
+}
+
 
 const ValueBase &
 ValueNode_Const::get_value()const
@@ -78,6 +78,7 @@ public:
 	static bool check_type(Type &type);
 
 	virtual ValueBase operator()(Time t) const override;
+	virtual bool is_time_invariant() const override { return false; }
 
 protected:
 	LinkableValueNode* create_new() const override;
@@ -86,6 +87,10 @@ protected:
 	virtual ValueNode::LooseHandle get_link_vfunc(int i) const override;
 
 	virtual Vocab get_children_vocab_vfunc() const override;
+
+	//! Link is evaluated at the neighbour times
+	virtual void get_child_changed_time(const Node *, Time &begin, Time &end) const override
+		{ begin = Time::begin(); end = Time::end(); }
 }; // END of class ValueNode_Derivative
 
 }; // END of namespace synfig
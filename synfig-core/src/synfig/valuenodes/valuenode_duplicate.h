@@ -32,6 +32,8 @@
 
 /* === H E A D E R S ======================================================= */
 
+#include <mutex>
+
 #include <synfig/valuenode.h>
 
 /* === M A C R O S ========================================================= */
@@ -46,6 +48,7 @@ class ValueNode_Duplicate : public LinkableValueNode
 	ValueNode::RHandle to_;
 	ValueNode::RHandle step_;
 	mutable Real index;
+	mutable std::mutex mutex;
 
 	ValueNode_Duplicate(Type &x);
 	ValueNode_Duplicate(const ValueBase &x);
@@ -62,6 +65,12 @@ public:
 	static bool check_type(Type &type);
 
 	virtual ValueBase operator()(Time t) const override;
+	//! Value depends on the state of Duplicate layer, not on time only
+	virtual bool is_time_invariant() const override { return false; }
+
+	//! Guards the index while layers iterate over copies.
+	//! Copies of the layers made for different frames share the same index node (see EvaluatedFrame)
+	std::mutex& get_mutex() const { return mutex; }
 
 	void reset_index(Time t) const;
 	bool step(Time t) const;
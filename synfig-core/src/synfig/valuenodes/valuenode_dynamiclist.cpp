@@ -650,6 +650,15 @@ ValueNode_DynamicList::create(const ValueBase& value, Canvas::LooseHandle)
 	return value_node;
 }
 
+bool
+ValueNode_DynamicList::is_time_invariant()const
+{
+	for(std::vector<ListEntry>::const_iterator i = list.begin(); i != list.end(); ++i)
+		if (!i->timing_info.empty())
+			return false;
+	return LinkableValueNode::is_time_invariant();
+}
+
 ValueBase
 ValueNode_DynamicList::operator()(Time t)const
 {
@@ -185,6 +185,8 @@ public:
 	virtual int get_link_index_from_name(const String &name) const override;
 
 	virtual ValueBase operator()(Time t) const override;
+	//! List is time-invariant when it has no activepoints and all entries are time-invariant
+	virtual bool is_time_invariant() const override;
 
 	virtual ListEntry create_list_entry(int index, Time time=0, Real origin=0.5);
 
@@ -43,6 +43,7 @@
 #include <synfig/valuenode_registry.h>
 #include <synfig/color.h>
 #include <synfig/vector.h>
+#include <vector>
 
 #endif
 
@@ -129,19 +130,35 @@ ValueNode_Linear::operator()(Time t)const
 	DEBUG_LOG("SYNFIG_DEBUG_VALUENODE_OPERATORS",
 		"%s:%d operator()\n", __FILE__, __LINE__);
 
+	return calculate(t, (*m_)(t), (*b_)(t));
+}
+
+void
+ValueNode_Linear::evaluate_many(const Time *times, size_t count, ValueBase *results)const
+{
+	std::vector<ValueBase> slopes(count);
+	m_->evaluate_many(times, count, slopes.data());
+	b_->evaluate_many(times, count, results);
+	for(size_t i = 0; i < count; ++i)
+		results[i] = calculate(times[i], slopes[i], results[i]);
+}
+
+ValueBase
+ValueNode_Linear::calculate(Time t, const ValueBase &slope, const ValueBase &offset)const
+{
 	Type &type(get_type());
 	if (type == type_angle)
-		return (*m_)(t).get( Angle())*t+(*b_)(t).get( Angle());
+		return slope.get( Angle())*t+offset.get( Angle());
 	if (type == type_color)
-		return (*m_)(t).get( Color())*t+(*b_)(t).get( Color());
+		return slope.get( Color())*t+offset.get( Color());
 	if (type == type_integer)
-		return round_to_int((*m_)(t).get(int())*t+(*b_)(t).get(int()));
+		return round_to_int(slope.get(int())*t+offset.get(int()));
 	if (type == type_real)
-		return (*m_)(t).get(  Real())*t+(*b_)(t).get(  Real());
+		return slope.get(  Real())*t+offset.get(  Real());
 	if (type == type_time)
-		return (*m_)(t).get(  Time())*t+(*b_)(t).get(  Time());
+		return slope.get(  Time())*t+offset.get(  Time());
 	if (type == type_vector)
-		return (*m_)(t).get(Vector())*t+(*b_)(t).get(Vector());
+		return slope.get(Vector())*t+offset.get(Vector());
 
 	assert(0);
 	return ValueBase();
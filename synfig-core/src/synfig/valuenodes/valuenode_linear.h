@@ -59,10 +59,15 @@ public:
 	static bool check_type(Type &type);
 
 	virtual ValueBase operator()(Time t) const override;
+	virtual void evaluate_many(const Time *times, size_t count, ValueBase *results) const override;
+	virtual bool is_time_invariant() const override { return false; }
 
 protected:
 	LinkableValueNode* create_new() const override;
 
+	//! Calculates the value at time \a t from already evaluated links
+	ValueBase calculate(Time t, const ValueBase &slope, const ValueBase &offset) const;
+
 	virtual bool set_link_vfunc(int i,ValueNode::Handle x) override;
 	virtual ValueNode::LooseHandle get_link_vfunc(int i) const override;
 
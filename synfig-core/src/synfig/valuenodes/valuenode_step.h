@@ -60,6 +60,7 @@ public:
 	static bool check_type(Type &type);
 
 	virtual ValueBase operator()(Time t) const override;
+	virtual bool is_time_invariant() const override { return false; }
 
 protected:
 	LinkableValueNode* create_new() const override;
@@ -68,6 +69,10 @@ protected:
 	virtual ValueNode::LooseHandle get_link_vfunc(int i) const override;
 
 	virtual Vocab get_children_vocab_vfunc() const override;
+
+	//! Link is sampled at the start of each step
+	virtual void get_child_changed_time(const Node *, Time &begin, Time &end) const override
+		{ begin = Time::begin(); end = Time::end(); }
 }; // END of class ValueNode_Step
 
 }; // END of namespace synfig
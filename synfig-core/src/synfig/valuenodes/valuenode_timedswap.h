@@ -61,6 +61,7 @@ public:
 	static bool check_type(Type &type);
 
 	virtual ValueBase operator()(Time t) const override;
+	virtual bool is_time_invariant() const override { return false; }
 
 protected:
 	virtual LinkableValueNode* create_new() const override;
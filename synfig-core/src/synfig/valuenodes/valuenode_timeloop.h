@@ -62,6 +62,7 @@ public:
 	static bool check_type(Type &type);
 
 	virtual ValueBase operator()(Time t) const override;
+	virtual bool is_time_invariant() const override { return false; }
 
 	//! Checks if it is possible to call get_inverse() for target_value at time t.
 	//! If so, return the link_index related to the return value provided by get_inverse()
@@ -76,6 +77,10 @@ protected:
 	virtual ValueNode::LooseHandle get_link_vfunc(int i) const override;
 
 	virtual Vocab get_children_vocab_vfunc() const override;
+
+	//! Links are evaluated at the looped time
+	virtual void get_child_changed_time(const Node *, Time &begin, Time &end) const override
+		{ begin = Time::begin(); end = Time::end(); }
 }; // END of class ValueNode_TimeLoop
 
 }; // END of namespace synfig
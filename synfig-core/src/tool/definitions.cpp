@@ -36,6 +36,9 @@ SynfigToolGeneralOptions* SynfigToolGeneralOptions::instance() {
 SynfigToolGeneralOptions::SynfigToolGeneralOptions()
 	: _verbosity(0),
 	  _threads(1),
+	  _parallel_frames(1),
+	  _frame_queue_size(0),
+	  _surface_cache_size(-1),
 	  _should_be_quiet(false),
 	  _should_print_benchmarks(false),
 	  _repeats(1)
@@ -62,6 +65,36 @@ void SynfigToolGeneralOptions::set_threads(size_t threads)
 	_threads = threads;
 }
 
+size_t SynfigToolGeneralOptions::get_parallel_frames() const
+{
+	return _parallel_frames;
+}
+
+void SynfigToolGeneralOptions::set_parallel_frames(size_t parallel_frames)
+{
+	_parallel_frames = parallel_frames;
+}
+
+size_t SynfigToolGeneralOptions::get_frame_queue_size() const
+{
+	return _frame_queue_size;
+}
+
+void SynfigToolGeneralOptions::set_frame_queue_size(size_t frame_queue_size)
+{
+	_frame_queue_size = frame_queue_size;
+}
+
+int SynfigToolGeneralOptions::get_surface_cache_size() const
+{
+	return _surface_cache_size;
+}
+
+void SynfigToolGeneralOptions::set_surface_cache_size(int surface_cache_size)
+{
+	_surface_cache_size = surface_cache_size;
+}
+
 int SynfigToolGeneralOptions::get_verbosity() const
 {
 	return _verbosity;
@@ -98,6 +98,19 @@ public:
 
 	void set_threads(size_t threads);
 
+	size_t get_parallel_frames() const;
+
+	void set_parallel_frames(size_t parallel_frames);
+
+	size_t get_frame_queue_size() const;
+
+	void set_frame_queue_size(size_t frame_queue_size);
+
+	//! Size in megabytes, negative value keeps the default size
+	int get_surface_cache_size() const;
+
+	void set_surface_cache_size(int surface_cache_size);
+
 	int get_verbosity() const;
 
 	void set_verbosity(int verbosity);
@@ -119,6 +132,9 @@ private:
 	std::string _binary_path;
 	int _verbosity;
 	size_t _threads;
+	size_t _parallel_frames;
+	size_t _frame_queue_size;
+	int _surface_cache_size;
 	bool _should_be_quiet,
 		 _should_print_benchmarks;
 
@@ -44,6 +44,8 @@
 #include <synfig/target_tile.h>
 #include <synfig/savecanvas.h>
 #include <synfig/filesystemnative.h>
+#include <synfig/rendering/renderer.h>
+#include <synfig/rendering/surfacecache.h>
 
 #include "definitions.h"
 #include "synfigtoolexception.h"
@@ -180,13 +182,20 @@ static void set_canvas_quality_and_alpha_mode(Job& job)
 
 static void set_target_engine_and_threads(Job& job)
 {
+	int surface_cache_size = SynfigToolGeneralOptions::instance()->get_surface_cache_size();
+	if (surface_cache_size >= 0)
+		rendering::Renderer::get_surface_cache().set_max_bytes(size_t(surface_cache_size)*1024*1024);
+
 	if(auto scanline_target = Target_Scanline::Handle::cast_dynamic(job.target))
 	{
 		scanline_target->set_threads(SynfigToolGeneralOptions::instance()->get_threads());
+		scanline_target->set_parallel_frames(SynfigToolGeneralOptions::instance()->get_parallel_frames());
+		scanline_target->set_frame_queue_size(SynfigToolGeneralOptions::instance()->get_frame_queue_size());
 		scanline_target->set_engine(job.render_engine);
 	} else if(auto tile_target = Target_Tile::Handle::cast_dynamic(job.target))
 	{
 		tile_target->set_threads(SynfigToolGeneralOptions::instance()->get_threads());
+		tile_target->set_parallel_frames(SynfigToolGeneralOptions::instance()->get_parallel_frames());
 		tile_target->set_engine(job.render_engine);
 	}
 }
@@ -46,6 +46,7 @@
 #include <synfig/loadcanvas.h>
 #include <synfig/valuenode_registry.h>
 #include <synfig/rendering/renderer.h>
+#include <synfig/threadpool.h>
 
 #include "definitions.h"
 #include "job.h"
@@ -96,6 +97,9 @@ SynfigCommandLineParser::SynfigCommandLineParser() :
 	set_antialias(),
 	set_quality(),
 	set_num_threads(),
+	set_parallel_frames(),
+	set_frame_queue(),
+	set_surface_cache(-1),
 	set_input_file(),
 	set_output_file(),
 	set_sequence_separator(),
@@ -115,6 +119,7 @@ SynfigCommandLineParser::SynfigCommandLineParser() :
 	sw_quiet(),
 	sw_print_benchmarks(),
 	sw_extract_alpha(),
+	sw_thread_affinity(),
 
 	// Misc group
 	misc_append_filename(),
@@ -156,6 +161,9 @@ SynfigCommandLineParser::SynfigCommandLineParser() :
 	add_option(og_set, "antialias",   'a', set_antialias,	_("Set antialias amount for parametric renderer."), "1..30");
 	//og_set.add_option("quality",     'Q', quality_arg_desc, strprintf(_("Specify image quality for accelerated renderer (Default: %d)"), DEFAULT_QUALITY).c_str(), "NUM");
 	add_option(og_set, "threads",     'T', set_num_threads, _("Enable multithreaded renderer using the specified number of threads"), "NUM");
+	add_option(og_set, "parallel-frames", ' ', set_parallel_frames, _("Render the specified number of frames simultaneously"), "NUM");
+	add_option(og_set, "frame-queue", ' ', set_frame_queue, _("Write frames to the target in separate thread, keeping up to the specified number of rendered frames"), "NUM");
+	add_option(og_set, "surface-cache", ' ', set_surface_cache, _("Keep up to the specified number of megabytes of rendered static groups between frames, 0 disables the cache"), "NUM");
 	add_option(og_set, "input-file",  'i', set_input_file, 	_("Specify input filename"), "filename");
 	add_option(og_set, "output-file", 'o', set_output_file, _("Specify output filename"), "filename");
 	add_option(og_set, "renderer",    ' ', set_renderer,    _("Specify which renderer to use"), "string");
@@ -177,6 +185,7 @@ SynfigCommandLineParser::SynfigCommandLineParser() :
 	add_option(og_switch, "quiet",         'q', sw_quiet, 				_("Quiet mode (No progress/time-remaining display)"), "");
 	add_option(og_switch, "benchmarks",    'b', sw_print_benchmarks,	_("Print benchmarks"), "");
 	add_option(og_switch, "extract-alpha", 'x', sw_extract_alpha, 		_("Extract alpha"), "");
+	add_option(og_switch, "thread-affinity", ' ', sw_thread_affinity,	_("Pin worker threads to CPU cores"), "");
 
 	//SynfigOptionGroup og_misc("misc", _("Misc options"), "Show Misc options help");
 	add_option_filename(og_misc, "append", ' ', misc_append_filename, 	_("Append layers in <filename> to composition"), _("filename"));
@@ -368,10 +377,39 @@ void SynfigCommandLineParser::process_settings_options() const
 	if (set_num_threads > 0)
 	{
 		SynfigToolGeneralOptions::instance()->set_threads(size_t(set_num_threads));
+		// the same threads are used for rendering and for other jobs
+		ThreadPool::set_default_num_threads(set_num_threads);
+	}
+
+	if (sw_thread_affinity)
+	{
+		ThreadPool::set_default_affinity(true);
+		VERBOSE_OUT(1) << _("Worker threads are pinned to CPU cores") << std::endl;
 	}
 
 	VERBOSE_OUT(1) << _("Threads set to ")
 				   << SynfigToolGeneralOptions::instance()->get_threads() << std::endl;
+
+	if (set_parallel_frames > 0)
+	{
+		SynfigToolGeneralOptions::instance()->set_parallel_frames(size_t(set_parallel_frames));
+		VERBOSE_OUT(1) << _("Parallel frames set to ")
+					   << SynfigToolGeneralOptions::instance()->get_parallel_frames() << std::endl;
+	}
+
+	if (set_frame_queue > 0)
+	{
+		SynfigToolGeneralOptions::instance()->set_frame_queue_size(size_t(set_frame_queue));
+		VERBOSE_OUT(1) << _("Frame queue size set to ")
+					   << SynfigToolGeneralOptions::instance()->get_frame_queue_size() << std::endl;
+	}
+
+	if (set_surface_cache >= 0)
+	{
+		SynfigToolGeneralOptions::instance()->set_surface_cache_size(set_surface_cache);
+		VERBOSE_OUT(1) << _("Surface cache size set to ")
+					   << SynfigToolGeneralOptions::instance()->get_surface_cache_size() << std::endl;
+	}
 }
 
 void SynfigCommandLineParser::process_trivial_info_options()
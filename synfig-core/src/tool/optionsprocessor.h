@@ -104,6 +104,9 @@ private:
 	int				set_antialias;
 	int				set_quality;
 	int				set_num_threads;
+	int				set_parallel_frames;
+	int				set_frame_queue;
+	int				set_surface_cache;
 	Glib::ustring	set_input_file;
 	Glib::ustring	set_output_file;
 	Glib::ustring   set_renderer;
@@ -124,6 +127,7 @@ private:
 	bool			sw_quiet;
 	bool			sw_print_benchmarks;
 	bool			sw_extract_alpha;
+	bool			sw_thread_affinity;
 
 	// Misc group
 	std::string		misc_append_filename;
@@ -28,14 +28,28 @@
 
 #include <synfig/angle.h>
 #include <synfig/bezier.h>
+#include <synfig/canvasbase.h>
 #include <synfig/clock.h>
+#include <synfig/context.h>
 #include <synfig/surface_etl.h>
+#include <synfig/type.h>
+#include <synfig/value.h>
+#include <synfig/valuenode_program.h>
+#include <synfig/vector.h>
+#include <synfig/layers/layer_solidcolor.h>
+#include <synfig/valuenodes/valuenode_add.h>
+#include <synfig/valuenodes/valuenode_animated.h>
+#include <synfig/valuenodes/valuenode_composite.h>
+#include <synfig/valuenodes/valuenode_const.h>
+#include <synfig/valuenodes/valuenode_scale.h>
 
 /* === M A C R O S ========================================================= */
 
 using namespace synfig;
 
 #define HERMITE_TEST_ITERATIONS		(100000)
+#define VALUE_TEST_ITERATIONS		(1000000)
+#define PROGRAM_TEST_ITERATIONS		(100000)
 
 /* === C L A S S E S ======================================================= */
 
@@ -281,6 +295,134 @@ int hermite_angle_test(void)
 	return ret;
 }
 
+int value_copy_test(void)
+{
+	int ret=0,i;
+
+	// small values are stored inside of ValueBase, so copying doesn't allocate
+	ValueBase vector(Vector(1.0, 2.0));
+	synfig::clock timer;
+	Real sum=0.0;
+	double t;
+
+	for(i=0,timer.reset();i<VALUE_TEST_ITERATIONS;i++)
+	{
+		ValueBase copy(vector);
+		sum+=copy.get(Vector())[0];
+	}
+	t=timer();
+
+	fprintf(stderr,"ValueBase<Vector> copy:time=%f milliseconds, sum=%f\n",t*1000,sum);
+
+	return ret;
+}
+
+static ValueNode::Handle
+create_animated_real(Real scale)
+{
+	ValueNode_Animated::Handle animated = ValueNode_Animated::create(type_real);
+	animated->new_waypoint(Time(0.0), ValueBase(Real(0.0)));
+	animated->new_waypoint(Time(1.0), ValueBase(Real(scale)));
+	animated->new_waypoint(Time(2.0), ValueBase(Real(-scale)));
+	return animated;
+}
+
+int program_test(void)
+{
+	int ret=0,i;
+
+	// root = (a + b*0.5, c) + (a + b*0.5, c)*d
+	ValueNode_Scale::Handle half = ValueNode_Scale::create(Real(0.0));
+	half->set_link("link", create_animated_real(2.0));
+	half->set_link("scalar", ValueNode_Const::create(Real(0.5)));
+	ValueNode_Add::Handle x = ValueNode_Add::create(Real(0.0));
+	x->set_link("lhs", create_animated_real(1.0));
+	x->set_link("rhs", half);
+	ValueNode_Composite::Handle vector = ValueNode_Composite::create(Vector());
+	vector->set_link(0, x);
+	vector->set_link(1, create_animated_real(0.5));
+	ValueNode_Scale::Handle scaled = ValueNode_Scale::create(Vector());
+	scaled->set_link("link", vector);
+	scaled->set_link("scalar", create_animated_real(3.0));
+	ValueNode_Add::Handle root = ValueNode_Add::create(Vector());
+	root->set_link("lhs", vector);
+	root->set_link("rhs", scaled);
+
+	ValueNodeProgram program(root);
+	synfig::clock timer;
+	Real sum_node=0.0,sum_program=0.0;
+	double t_node,t_program;
+
+	for(i=0,timer.reset();i<PROGRAM_TEST_ITERATIONS;i++)
+		sum_node+=(*root)(Time(i*0.0001)).get(Vector())[0];
+	t_node=timer();
+
+	for(i=0,timer.reset();i<PROGRAM_TEST_ITERATIONS;i++)
+		sum_program+=program(Time(i*0.0001)).get(Vector())[0];
+	t_program=timer();
+
+	fprintf(stderr,"value node graph:time=%f milliseconds, program:time=%f milliseconds\n",t_node*1000,t_program*1000);
+
+	if(sum_node!=sum_program)
+	{
+		fprintf(stderr,"program:sums differ: %f != %f\n",sum_node,sum_program);
+		ret++;
+	}
+
+	return ret;
+}
+
+int layer_program_test(void)
+{
+	int ret=0,i;
+
+	// amount = (a + b*0.5)*c, evaluated by Layer::set_time() through its program
+	ValueNode_Scale::Handle half = ValueNode_Scale::create(Real(0.0));
+	half->set_link("link", create_animated_real(2.0));
+	half->set_link("scalar", ValueNode_Const::create(Real(0.5)));
+	ValueNode_Add::Handle root = ValueNode_Add::create(Real(0.0));
+	root->set_link("lhs", create_animated_real(1.0));
+	root->set_link("rhs", half);
+	root->set_link("scalar", create_animated_real(3.0));
+
+	Layer::Handle layer = new Layer_SolidColor();
+	layer->connect_dynamic_param("amount", ValueNode::LooseHandle(root));
+	CanvasBase canvas_base;
+	canvas_base.push_back(layer);
+	canvas_base.push_back(Layer::Handle());
+	IndependentContext context(canvas_base.begin());
+
+	synfig::clock timer;
+	Real sum_node=0.0,sum_layer=0.0;
+	double t_node,t_layer;
+
+	// what Layer::set_time() did before: the graph is evaluated node by node
+	for(i=0,timer.reset();i<PROGRAM_TEST_ITERATIONS;i++)
+	{
+		Layer::ParamList params;
+		params["amount"]=(*root)(Time(i*0.0001));
+		layer->set_param_list(params);
+		sum_node+=layer->get_param("amount").get(Real());
+	}
+	t_node=timer();
+
+	for(i=0,timer.reset();i<PROGRAM_TEST_ITERATIONS;i++)
+	{
+		context.set_time(Time(i*0.0001), true);
+		sum_layer+=layer->get_param("amount").get(Real());
+	}
+	t_layer=timer();
+
+	fprintf(stderr,"Layer::set_time() value nodes:time=%f milliseconds, program:time=%f milliseconds\n",t_node*1000,t_layer*1000);
+
+	if(sum_node!=sum_layer)
+	{
+		fprintf(stderr,"layer program:sums differ: %f != %f\n",sum_node,sum_layer);
+		ret++;
+	}
+
+	return ret;
+}
 
 /* === E N T R Y P O I N T ================================================= */
 
@@ -288,10 +430,17 @@ int main()
 {
 	int error=0;
 
+	Type::subsys_init();
+
 	error+=hermite_float_test();
 	error+=hermite_double_test();
 	error+=hermite_int_test();
 	error+=hermite_angle_test();
+	error+=value_copy_test();
+	error+=program_test();
+	error+=layer_program_test();
+
+	Type::subsys_stop();
 
 	return error;
 }
@@ -0,0 +1,138 @@
+/* === S Y N F I G ========================================================= */
+/*!\file blur.cpp
+** \brief Test box blur templates
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <cstring>
+
+#include <synfig/rendering/software/function/blurtemplates.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+using namespace rendering;
+using namespace software;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+
+static const int rows = 37;
+static const int cols = 23;
+static const int channels = 4;
+
+/* === P R O C E D U R E S ================================================= */
+
+static void
+fill_test_surface(std::vector<ColorReal> &surface)
+{
+	surface.resize(rows*cols*channels);
+	for(int i = 0; i < (int)surface.size(); ++i)
+		surface[i] = ColorReal((i*7919)%1013)/ColorReal(97.0) - ColorReal(3.0);
+}
+
+static Array<ColorReal, 3>
+surface_array(std::vector<ColorReal> &surface)
+{
+	Array<ColorReal, 3> arr(&surface.front());
+	arr.set_dim(rows, cols*channels)
+	   .set_dim(cols, channels)
+	   .set_dim(channels, 1);
+	return arr;
+}
+
+static bool
+bit_equal(const std::vector<ColorReal> &a, const std::vector<ColorReal> &b)
+{
+	return a.size() == b.size()
+	    && !memcmp(&a.front(), &b.front(), a.size()*sizeof(ColorReal));
+}
+
+void
+test_box_blur_lanes_rows()
+{
+	const int sizes[] = { 0, 1, 2, 5, 11, 12 };
+	for(int size : sizes) {
+		std::vector<ColorReal> expected, result, buffer;
+		std::deque<ColorReal> q;
+		fill_test_surface(expected);
+		fill_test_surface(result);
+
+		Array<ColorReal, 3> arr(surface_array(expected).reorder(2, 0, 1));
+		for(Array<ColorReal, 3>::Iterator channel(arr); channel; ++channel)
+			for(Array<ColorReal, 2>::Iterator r(*channel); r; ++r)
+				BlurTemplates::blur_box_discrete(*r, q, size);
+
+		for(int r = 0; r < rows; ++r)
+			BlurTemplates::blur_box_discrete_lanes(
+				&result[r*cols*channels], channels, channels, cols, buffer, size );
+
+		ASSERT(bit_equal(expected, result));
+	}
+}
+
+void
+test_box_blur_lanes_columns()
+{
+	// band widths which are not multiple of SIMD width are included
+	const int sizes[] = { 0, 1, 3, 9, 18, 19 };
+	const int blocks[] = { 1, 3, 16, cols };
+	for(int size : sizes) {
+		for(int block : blocks) {
+			std::vector<ColorReal> expected, result, buffer;
+			std::deque<ColorReal> q;
+			fill_test_surface(expected);
+			fill_test_surface(result);
+
+			Array<ColorReal, 3> arr(surface_array(expected).reorder(2, 1, 0));
+			for(Array<ColorReal, 3>::Iterator channel(arr); channel; ++channel)
+				for(Array<ColorReal, 2>::Iterator c(*channel); c; ++c)
+					BlurTemplates::blur_box_discrete(*c, q, size);
+
+			for(int c0 = 0; c0 < cols; c0 += block) {
+				int c1 = std::min(c0 + block, cols);
+				BlurTemplates::blur_box_discrete_lanes(
+					&result[c0*channels], cols*channels, (c1 - c0)*channels, rows, buffer, size );
+			}
+
+			ASSERT(bit_equal(expected, result));
+		}
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	TEST_SUITE_BEGIN()
+		TEST_FUNCTION(test_box_blur_lanes_rows);
+		TEST_FUNCTION(test_box_blur_lanes_columns);
+	TEST_SUITE_END()
+
+	return tst_exit_status;
+}
@@ -0,0 +1,122 @@
+/* === S Y N F I G ========================================================= */
+/*!\file color.cpp
+** \brief Test Color blending functions
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <synfig/color.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+/* === P R O C E D U R E S ================================================= */
+
+static const int span_size = 64;
+
+static void
+fill_test_colors(Color *a, Color *b)
+{
+	for(int i = 0; i < span_size; ++i) {
+		// include transparent, negative and overexposed colors
+		a[i] = Color(0.1f*(i%13) - 0.2f, 0.05f*(i%7), 1.f - 0.07f*(i%11), i%5 ? 0.1f*(i%12) : 0.f);
+		b[i] = Color(0.9f - 0.08f*(i%9), 0.12f*(i%10) - 0.1f, 0.03f*(i%17), i%6 ? 0.09f*(i%13) : 0.f);
+	}
+}
+
+static bool
+approximate_equal_colors(const Color &a, const Color &b)
+{
+	const float precision = 1e-5f;
+	float k = 1.f + std::max(std::max(std::fabs(a.get_r()), std::fabs(a.get_g())), std::fabs(a.get_b()));
+	return std::fabs(a.get_r() - b.get_r()) <= precision*k
+		&& std::fabs(a.get_g() - b.get_g()) <= precision*k
+		&& std::fabs(a.get_b() - b.get_b()) <= precision*k
+		&& std::fabs(a.get_a() - b.get_a()) <= precision;
+}
+
+void
+test_blend_span_equals_blend()
+{
+	const float amounts[] = { 1.f, 0.5f, -0.75f, 0.f };
+	Color a[span_size], b[span_size], dest[span_size];
+	fill_test_colors(a, b);
+
+	for(int method = 0; method < Color::BLEND_END; ++method) {
+		for(float amount : amounts) {
+			Color::BlendMethod blend_method = Color::BlendMethod(method);
+			Color::blend_span(dest, a, 1, b, 1, span_size, amount, blend_method);
+			for(int i = 0; i < span_size; ++i)
+				ASSERT(approximate_equal_colors(Color::blend(a[i], b[i], amount, blend_method), dest[i]));
+		}
+	}
+}
+
+void
+test_blend_span_with_single_color()
+{
+	Color a[span_size], b[span_size], dest[span_size];
+	fill_test_colors(a, b);
+	Color color(0.3f, 0.6f, 0.9f, 0.4f);
+
+	Color::blend_span(dest, &color, 0, b, 1, span_size, 0.8f, Color::BLEND_COMPOSITE);
+	for(int i = 0; i < span_size; ++i)
+		ASSERT(approximate_equal_colors(Color::blend(color, b[i], 0.8f, Color::BLEND_COMPOSITE), dest[i]));
+
+	Color::blend_span(dest, a, 1, &color, 0, span_size, 1.f, Color::BLEND_COMPOSITE);
+	for(int i = 0; i < span_size; ++i)
+		ASSERT(approximate_equal_colors(Color::blend(a[i], color, 1.f, Color::BLEND_COMPOSITE), dest[i]));
+}
+
+void
+test_blend_span_in_place()
+{
+	Color a[span_size], b[span_size], expected[span_size];
+	fill_test_colors(a, b);
+
+	for(int i = 0; i < span_size; ++i)
+		expected[i] = Color::blend(a[i], b[i], 0.6f, Color::BLEND_SCREEN);
+	Color::blend_span(b, a, 1, b, 1, span_size, 0.6f, Color::BLEND_SCREEN);
+	for(int i = 0; i < span_size; ++i)
+		ASSERT(approximate_equal_colors(expected[i], b[i]));
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	TEST_SUITE_BEGIN()
+		TEST_FUNCTION(test_blend_span_equals_blend);
+		TEST_FUNCTION(test_blend_span_with_single_color);
+		TEST_FUNCTION(test_blend_span_in_place);
+	TEST_SUITE_END()
+
+	return tst_exit_status;
+}
@@ -0,0 +1,98 @@
+/* === S Y N F I G ========================================================= */
+/*!\file gradient.cpp
+** \brief Test CompiledGradient
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <vector>
+
+#include <synfig/gradient.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+/* === P R O C E D U R E S ================================================= */
+
+static Gradient
+build_gradient()
+{
+	Gradient gradient;
+	gradient.push_back(GradientCPoint(0.0, Color(1.0, 0.0, 0.0, 1.0)));
+	gradient.push_back(GradientCPoint(0.3, Color(0.0, 1.0, 0.0, 0.5)));
+	gradient.push_back(GradientCPoint(0.3, Color(0.0, 0.0, 1.0, 0.0)));
+	gradient.push_back(GradientCPoint(0.7, Color(1.0, 1.0, 0.0, 1.0)));
+	gradient.push_back(GradientCPoint(1.0, Color(0.0, 1.0, 1.0, 0.25)));
+	return gradient;
+}
+
+static bool
+equal(const Color &a, const Color &b)
+{
+	return a.get_r() == b.get_r()
+	    && a.get_g() == b.get_g()
+	    && a.get_b() == b.get_b()
+	    && a.get_a() == b.get_a();
+}
+
+void
+test_average_span()
+{
+	// span must give exactly the same colors as separate calls,
+	// ranges go forward, backward, jump between segments and have zero width
+	const int count = 1000;
+	std::vector<Real> x0(count), x1(count);
+	for(int i = 0; i < count; ++i) {
+		Real x = i < count/2 ? -1.5 + i*0.007 : 2.0 - i*0.0031 + (i%7)*0.3;
+		Real w = (i%11)*0.013 - 0.02;
+		if (i%13 == 0) w = 0.0;
+		x0[i] = x - w;
+		x1[i] = x + w;
+	}
+
+	for(int mode = 0; mode < 4; ++mode) {
+		CompiledGradient gradient(build_gradient(), mode & 1, mode & 2);
+		std::vector<Color> colors(count);
+		gradient.average(&colors.front(), &x0.front(), &x1.front(), count);
+		for(int i = 0; i < count; ++i)
+			ASSERT(equal(colors[i], gradient.average(x0[i], x1[i])));
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	TEST_SUITE_BEGIN()
+		TEST_FUNCTION(test_average_span);
+	TEST_SUITE_END()
+
+	return tst_exit_status;
+}
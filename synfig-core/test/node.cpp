@@ -271,6 +271,37 @@ void marking_child_node_as_changed_emits_signal_child_changed() {
 	ASSERT_SIGNAL_EMITTED((&parent_node),signal_child_changed,,const Node*,void, child_node.changed());
 }
 
+void marking_node_as_changed_affects_whole_time_line() {
+	NodeX node;
+	Time begin, end;
+	node.signal_changed().connect([&]() {
+		begin = node.get_changed_time_begin();
+		end = node.get_changed_time_end();
+	});
+
+	node.changed();
+
+	ASSERT_EQUAL(Time::begin(), begin);
+	ASSERT_EQUAL(Time::end(), end);
+}
+
+void marking_child_node_as_changed_in_time_passes_interval_to_parent() {
+	NodeX parent_node, child_node;
+	Time begin, end;
+	parent_node.add_child(&child_node);
+	parent_node.signal_changed().connect([&]() {
+		begin = parent_node.get_changed_time_begin();
+		end = parent_node.get_changed_time_end();
+	});
+
+	child_node.changed(Time(1), Time(2));
+
+	ASSERT_EQUAL(Time(1), begin);
+	ASSERT_EQUAL(Time(2), end);
+	ASSERT_EQUAL(Time::begin(), child_node.get_changed_time_begin());
+	ASSERT_EQUAL(Time::end(), child_node.get_changed_time_end());
+}
+
 void get_times_is_cached() {
 	NodeX node;
 
@@ -328,6 +359,8 @@ int main() {
 		TEST_FUNCTION(marking_node_as_changed_emits_signal_changed);
 		TEST_FUNCTION(marking_child_node_as_changed_emits_signal_changed);
 		TEST_FUNCTION(marking_child_node_as_changed_emits_signal_child_changed);
+		TEST_FUNCTION(marking_node_as_changed_affects_whole_time_line);
+		TEST_FUNCTION(marking_child_node_as_changed_in_time_passes_interval_to_parent);
 
 		TEST_FUNCTION(get_times_is_cached);
 		TEST_FUNCTION(marking_node_as_changed_updates_times_cache);
@@ -0,0 +1,252 @@
+/* === S Y N F I G ========================================================= */
+/*!\file pixel_processor.cpp
+** \brief Test merging of pixel processor tasks
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <synfig/token.h>
+#include <synfig/rendering/common/optimizer/optimizerpixelprocessormerge.h>
+#include <synfig/rendering/common/task/taskpixelprocessor.h>
+#include <synfig/rendering/software/surfacesw.h>
+#include <synfig/rendering/software/task/tasksw.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+
+static const int width = 7;
+static const int height = 5;
+
+/* === P R O C E D U R E S ================================================= */
+
+// colors with negative components and components greater than one
+static SurfaceResource::Handle
+new_source_surface()
+{
+	SurfaceSW::Handle surface = new SurfaceSW();
+	surface->create(width, height);
+	synfig::Surface &s = surface->get_surface();
+	int i = 0;
+	for(int y = 0; y < height; ++y)
+		for(int x = 0; x < width; ++x, i += 4)
+			s[y][x] = Color(
+				ColorReal(((i + 0)*7919)%1013)/ColorReal(97.0) - ColorReal(3.0),
+				ColorReal(((i + 1)*7919)%1013)/ColorReal(97.0) - ColorReal(3.0),
+				ColorReal(((i + 2)*7919)%1013)/ColorReal(97.0) - ColorReal(3.0),
+				ColorReal(((i + 3)*7919)%1013)/ColorReal(503.0) - ColorReal(0.5) );
+	return new SurfaceResource(surface);
+}
+
+static Task::Handle
+new_surface_task(const SurfaceResource::Handle &surface)
+{
+	TaskSurface::Handle task = new TaskSurface();
+	task->target_surface = surface;
+	task->source_rect = Rect(0.0, 0.0, width, height);
+	task->target_rect = RectInt(0, 0, width, height);
+	return task;
+}
+
+static ColorMatrix
+matrix_a()
+{
+	ColorMatrix m;
+	m.set_hue_saturation(Angle::deg(30.0), 1.5);
+	return m;
+}
+
+static ColorMatrix
+matrix_b()
+{
+	ColorMatrix scale, translate;
+	scale.set_scale(0.5, 2.0, -1.0, 0.75);
+	translate.set_translate(0.25, -0.5, 0.125, 0.0);
+	return scale*translate;
+}
+
+//! Runs software versions of the tasks from the bottom to the top of the tree
+static SurfaceResource::Handle
+render(const Task::Handle &task)
+{
+	if (TaskSurface::Handle::cast_dynamic(task))
+		return task->target_surface;
+
+	Task::Handle sw_task = task->convert_to(TaskSW::mode_token.handle());
+	if (!sw_task)
+		return SurfaceResource::Handle();
+	sw_task->sub_task(0) = new_surface_task(render(task->sub_task(0)));
+	sw_task->target_surface = new SurfaceResource();
+	sw_task->target_surface->create(width, height);
+	sw_task->source_rect = Rect(0.0, 0.0, width, height);
+	sw_task->target_rect = RectInt(0, 0, width, height);
+
+	Task::RunParams params;
+	if (!sw_task->run(params))
+		return SurfaceResource::Handle();
+	return sw_task->target_surface;
+}
+
+static bool
+is_equal(const SurfaceResource::Handle &a, const SurfaceResource::Handle &b, ColorReal precision)
+{
+	if (!a || !b)
+		return false;
+	SurfaceResource::LockRead<SurfaceSW> la(a), lb(b);
+	if (!la || !lb)
+		return false;
+	const synfig::Surface &sa = la->get_surface();
+	const synfig::Surface &sb = lb->get_surface();
+	for(int y = 0; y < height; ++y)
+		for(int x = 0; x < width; ++x) {
+			const ColorReal *ca = (const ColorReal*)&sa[y][x];
+			const ColorReal *cb = (const ColorReal*)&sb[y][x];
+			for(int i = 0; i < 4; ++i)
+				if (precision == 0 ? memcmp(&ca[i], &cb[i], sizeof(ColorReal)) != 0
+				                   : std::fabs(ca[i] - cb[i]) > precision*(1 + std::fabs(ca[i])))
+					return false;
+		}
+	return true;
+}
+
+//! Merges the processors at the root of the tree while the optimizer changes something
+static Task::Handle
+merge(const Task::Handle &task)
+{
+	OptimizerPixelProcessorMerge optimizer;
+	Optimizer::RunParams params;
+	params.ref_task = task;
+	for(int i = 0; i < 16; ++i) {
+		Task::Handle prev = params.ref_task;
+		optimizer.run(params);
+		if (params.ref_task == prev)
+			break;
+	}
+	return params.ref_task;
+}
+
+void
+test_gamma_color_matrix_as_chain()
+{
+	SurfaceResource::Handle source = new_source_surface();
+	const Gamma gamma(2.2, 0.45, 1.0);
+	const ColorMatrix matrix = matrix_a()*matrix_b();
+
+	// matrix(gamma(source))
+	TaskPixelGamma::Handle gamma_task = new TaskPixelGamma();
+	gamma_task->gamma = gamma;
+	gamma_task->sub_task() = new_surface_task(source);
+	TaskPixelColorMatrix::Handle matrix_task = new TaskPixelColorMatrix();
+	matrix_task->matrix = matrix;
+	matrix_task->sub_task() = gamma_task;
+
+	TaskPixelGammaColorMatrix::Handle fused_task = new TaskPixelGammaColorMatrix();
+	fused_task->gamma = gamma;
+	fused_task->matrix = matrix;
+	fused_task->sub_task() = new_surface_task(source);
+
+	// the same functions run per pixel, so the results are bit-identical
+	SurfaceResource::Handle chain = render(matrix_task);
+	SurfaceResource::Handle fused = render(fused_task);
+	ASSERT(chain)
+	ASSERT(fused)
+	ASSERT(is_equal(chain, fused, 0))
+}
+
+void
+test_merge_matrices()
+{
+	SurfaceResource::Handle source = new_source_surface();
+
+	// matrixA(matrixB(source))
+	TaskPixelColorMatrix::Handle task_b = new TaskPixelColorMatrix();
+	task_b->matrix = matrix_b();
+	task_b->sub_task() = new_surface_task(source);
+	TaskPixelColorMatrix::Handle task_a = new TaskPixelColorMatrix();
+	task_a->matrix = matrix_a();
+	task_a->sub_task() = task_b;
+
+	TaskPixelColorMatrix::Handle merged = TaskPixelColorMatrix::Handle::cast_dynamic(merge(task_a));
+	ASSERT(merged)
+	ASSERT(merged->matrix == matrix_b()*matrix_a())
+	ASSERT(TaskSurface::Handle::cast_dynamic(merged->sub_task()))
+	ASSERT(is_equal(render(task_a), render(merged), 1e-5))
+}
+
+void
+test_merge_chain()
+{
+	SurfaceResource::Handle source = new_source_surface();
+	const Gamma gamma_c(2.2, 0.45, 1.5);
+	const Gamma gamma_d(0.8, 1.25, 0.5);
+
+	// matrixA(matrixB(gammaC(gammaD(source))))
+	TaskPixelGamma::Handle task_d = new TaskPixelGamma();
+	task_d->gamma = gamma_d;
+	task_d->sub_task() = new_surface_task(source);
+	TaskPixelGamma::Handle task_c = new TaskPixelGamma();
+	task_c->gamma = gamma_c;
+	task_c->sub_task() = task_d;
+	TaskPixelColorMatrix::Handle task_b = new TaskPixelColorMatrix();
+	task_b->matrix = matrix_b();
+	task_b->sub_task() = task_c;
+	TaskPixelColorMatrix::Handle task_a = new TaskPixelColorMatrix();
+	task_a->matrix = matrix_a();
+	task_a->sub_task() = task_b;
+
+	TaskPixelGammaColorMatrix::Handle merged = TaskPixelGammaColorMatrix::Handle::cast_dynamic(merge(task_a));
+	ASSERT(merged)
+	ASSERT(merged->gamma == gamma_d*gamma_c)
+	ASSERT(merged->matrix == matrix_b()*matrix_a())
+	ASSERT(TaskSurface::Handle::cast_dynamic(merged->sub_task()))
+
+	// pow() of pow() is not bit-identical to pow() with the product of exponents
+	ASSERT(is_equal(render(task_a), render(merged), 1e-4))
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	// tasks are converted to their software versions via tokens
+	Token::rebuild();
+
+	TEST_SUITE_BEGIN()
+		TEST_FUNCTION(test_gamma_color_matrix_as_chain);
+		TEST_FUNCTION(test_merge_matrices);
+		TEST_FUNCTION(test_merge_chain);
+	TEST_SUITE_END()
+
+	return tst_exit_status;
+}
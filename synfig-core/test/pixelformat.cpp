@@ -0,0 +1,184 @@
+/* === S Y N F I G ========================================================= */
+/*!\file pixelformat.cpp
+** \brief Test conversion of colors to pixel formats and back
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <synfig/color/pixelformat.h>
+
+#include <cmath>
+#include <vector>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+/* === P R O C E D U R E S ================================================= */
+
+static const int width = 37;
+
+static const PixelFormat formats[] = {
+	PF_RGB,
+	PF_BGR,
+	PF_GRAY,
+	PF_RGB|PF_A,
+	PF_BGR|PF_A,
+	PF_A_START,
+	PF_BGR|PF_A_START,
+	PF_A_PREMULT,
+	PF_BGR|PF_A_PREMULT,
+	PF_A_PREMULT|PF_A_START,
+	PF_BGR|PF_A_PREMULT|PF_A_START,
+	PF_GRAY|PF_A,
+	PF_GRAY|PF_A_PREMULT,
+};
+
+static std::vector<Color>
+get_test_colors()
+{
+	std::vector<Color> colors(width);
+	for(int i = 0; i < width; ++i)
+		colors[i] = Color(0.021f*(i%61) - 0.1f, 0.017f*(i%53), 1.2f - 0.03f*(i%43), i%7 ? 0.027f*i : 0.f);
+	colors[4].set_r(NAN);
+	colors[9].set_a(NAN);
+	return colors;
+}
+
+void
+test_color_to_pixelformat_whole_row_equals_per_pixel()
+{
+	std::vector<Color> colors = get_test_colors();
+	const Gamma gamma(2.2f, 1.8f, 0.5f);
+	const Gamma* gammas[] = { nullptr, &gamma };
+
+	for(const Gamma *g : gammas) {
+		for(PixelFormat pf : formats) {
+			std::vector<unsigned char> row(width*pixel_size(pf)), pixels(row.size());
+			color_to_pixelformat(row.data(), colors.data(), pf, g, width);
+			for(int i = 0; i < width; ++i)
+				color_to_pixelformat(&pixels[i*pixel_size(pf)], &colors[i], pf, g);
+			ASSERT(row == pixels);
+		}
+	}
+}
+
+void
+test_pixelformat_to_color_whole_row_equals_per_pixel()
+{
+	std::vector<unsigned char> data(width*4);
+	for(int i = 0; i < (int)data.size(); ++i)
+		data[i] = (unsigned char)(i*37 + i/5);
+	const Gamma gamma(2.2f, 1.8f, 0.5f);
+	const Gamma* gammas[] = { nullptr, &gamma };
+
+	for(const Gamma *g : gammas) {
+		for(PixelFormat pf : formats) {
+			std::vector<Color> row(width), pixels(width);
+			pixelformat_to_color(row.data(), data.data(), pf, g, width);
+			for(int i = 0; i < width; ++i)
+				pixelformat_to_color(&pixels[i], &data[i*pixel_size(pf)], pf, g);
+			for(int i = 0; i < width; ++i)
+				ASSERT(row[i] == pixels[i]);
+		}
+	}
+}
+
+void
+test_pixelformat_round_trip()
+{
+	std::vector<unsigned char> data(width*4);
+	for(int i = 0; i < (int)data.size(); ++i)
+		data[i] = (unsigned char)(i*37 + i/5);
+
+	// straight alpha formats keep the values exactly
+	for(PixelFormat pf : formats) {
+		if (FLAGS(pf, PF_GRAY) || FLAGS(pf, PF_A_PREMULT))
+			continue;
+		std::vector<Color> colors(width);
+		std::vector<unsigned char> result(width*pixel_size(pf));
+		pixelformat_to_color(colors.data(), data.data(), pf, nullptr, width);
+		color_to_pixelformat(result.data(), colors.data(), pf, nullptr, width);
+		ASSERT(std::equal(result.begin(), result.end(), data.begin()));
+	}
+}
+
+void
+test_gamma_tables()
+{
+	const Gamma gamma(2.2f, 1.8f, 0.25f);
+
+	for(int i = 0; i < 256; ++i) {
+		unsigned char pixel[3] = { (unsigned char)i, (unsigned char)i, (unsigned char)i };
+		Color color;
+		pixelformat_to_color(&color, pixel, PF_RGB, &gamma);
+		const ColorReal channels[3] = { color.get_r(), color.get_g(), color.get_b() };
+		for(int channel = 0; channel < 3; ++channel) {
+			ColorReal expected = gamma.apply(channel, ColorReal(i)/ColorReal(255));
+			ASSERT(std::fabs(channels[channel] - expected) < 1e-6f);
+		}
+	}
+
+	for(int i = 0; i <= 1000; ++i) {
+		ColorReal x = ColorReal(i)/ColorReal(1000);
+		Color color(x, x, x);
+		unsigned char pixel[3];
+		color_to_pixelformat(pixel, &color, PF_RGB, &gamma);
+		for(int channel = 0; channel < 3; ++channel) {
+			int expected = (int)(gamma.apply(channel, x)*ColorReal(65535.99)) >> 8;
+			ASSERT(std::abs(pixel[channel] - expected) <= 1);
+		}
+	}
+
+	// gamma < 1 is steep near zero, below the first node of the output table
+	for(int i = 0; i <= 1000; ++i) {
+		ColorReal x = ColorReal(i)/ColorReal(1000*4096);
+		Color color(x, x, x);
+		unsigned char pixel[3];
+		color_to_pixelformat(pixel, &color, PF_RGB, &gamma);
+		for(int channel = 0; channel < 3; ++channel) {
+			int expected = (int)(gamma.apply(channel, x)*ColorReal(65535.99)) >> 8;
+			ASSERT(std::abs(pixel[channel] - expected) <= 1);
+		}
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	TEST_SUITE_BEGIN()
+		TEST_FUNCTION(test_color_to_pixelformat_whole_row_equals_per_pixel);
+		TEST_FUNCTION(test_pixelformat_to_color_whole_row_equals_per_pixel);
+		TEST_FUNCTION(test_pixelformat_round_trip);
+		TEST_FUNCTION(test_gamma_tables);
+	TEST_SUITE_END()
+
+	return tst_exit_status;
+}
@@ -0,0 +1,181 @@
+/* === S Y N F I G ========================================================= */
+/*!\file polyspan.cpp
+** \brief Test Polyspan marks sorting and rendering
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+#include <synfig/rendering/primitive/polyspan.h>
+#include <synfig/rendering/software/function/contour.h>
+#include <synfig/surface.h>
+#include <synfig/threadpool.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+/* === P R O C E D U R E S ================================================= */
+
+static void
+build_star(Polyspan &polyspan, int points, int w = 200, int h = 150)
+{
+	Real cx = 0.5*w, cy = 0.5*h;
+	polyspan.init(0, 0, w, h);
+	polyspan.move_to(cx, cy - 0.45*h);
+	for(int i = 1; i < points; ++i) {
+		Real a = 2.0*PI*i*(points/2 - 1)/points;
+		polyspan.line_to(cx + 0.475*w*sin(a), cy - 0.45*h*cos(a));
+	}
+	polyspan.close();
+}
+
+static void
+fill_background(Surface &surface)
+{
+	for(int y = 0; y < surface.get_h(); ++y)
+		for(int x = 0; x < surface.get_w(); ++x)
+			surface[y][x] = Color(
+				(Real)x/surface.get_w(), (Real)y/surface.get_h(), 0.5, (Real)((x + y)%5)/4 );
+}
+
+static bool
+is_equal(const Surface &a, const Surface &b)
+{
+	if (a.get_w() != b.get_w() || a.get_h() != b.get_h())
+		return false;
+	for(int y = 0; y < a.get_h(); ++y)
+		if (memcmp(a[y], b[y], a.get_w()*sizeof(Color)))
+			return false;
+	return true;
+}
+
+static Real
+cover_sum(const Polyspan &polyspan)
+{
+	Real sum = 0.0;
+	for(Polyspan::cover_array::const_iterator i = polyspan.get_covers().begin(); i != polyspan.get_covers().end(); ++i)
+		sum += std::fabs(i->cover) + std::fabs(i->area);
+	return sum;
+}
+
+void
+test_sort_marks()
+{
+	// few marks are sorted directly, many marks are binned by rows
+	const int points[] = { 5, 51, 501 };
+	for(int count : points) {
+		Polyspan polyspan;
+		build_star(polyspan, count);
+		size_t marks = polyspan.get_covers().size();
+		Real sum = cover_sum(polyspan);
+
+		polyspan.sort_marks();
+		const Polyspan::cover_array &covers = polyspan.get_covers();
+		ASSERT(covers.size() >= marks);
+		ASSERT(std::fabs(cover_sum(polyspan) - sum) < 1e-6*(1.0 + sum));
+		for(size_t i = 1; i < covers.size(); ++i)
+			ASSERT(!(covers[i] < covers[i - 1]));
+	}
+}
+
+void
+test_render_bands()
+{
+	// big enough to be split into the bands by render_polyspan()
+	const int w = 600, h = 1000;
+	Polyspan polyspan;
+	build_star(polyspan, 1001, w, h);
+	polyspan.sort_marks();
+	const Polyspan::cover_array &covers = polyspan.get_covers();
+	const RectInt &window = polyspan.get_window();
+
+	const Contour::WindingStyle windings[] = { Contour::WINDING_NON_ZERO, Contour::WINDING_EVEN_ODD };
+	const Color::BlendMethod methods[] = { Color::BLEND_COMPOSITE, Color::BLEND_STRAIGHT };
+	const Color color(1.0, 0.25, -0.5, 0.75);
+	for(int flags = 0; flags < 4; ++flags)
+	for(Contour::WindingStyle winding : windings)
+	for(Color::BlendMethod method : methods) {
+		bool invert = flags & 1;
+		bool antialias = flags & 2;
+
+		// single pass over the whole window
+		Surface single(w, h);
+		fill_background(single);
+		software::Contour::render_rows(
+			single, polyspan, window, covers.begin(), covers.end(),
+			invert, antialias, winding, color, 0.5, method );
+
+		// bands rendered by render_polyspan(), in parallel when the ThreadPool has several threads
+		Surface banded(w, h);
+		fill_background(banded);
+		software::Contour::render_polyspan(
+			banded, polyspan, invert, antialias, winding, color, 0.5, method );
+		ASSERT(is_equal(single, banded));
+
+		// the same bands rendered one by one, so the check doesn't depend on the count of threads
+		const int count = 7;
+		Surface bands(w, h);
+		fill_background(bands);
+		Polyspan::cover_array::const_iterator mark = covers.begin();
+		for(int i = 0; i < count; ++i) {
+			RectInt band = window;
+			band.miny = window.miny + (window.maxy - window.miny)*i/count;
+			band.maxy = window.miny + (window.maxy - window.miny)*(i + 1)/count;
+			Polyspan::cover_array::const_iterator end = i + 1 == count ? covers.end()
+				: std::lower_bound(mark, covers.end(), Polyspan::PenMark(INT_MIN, band.maxy, 0, 0));
+			software::Contour::render_rows(
+				bands, polyspan, band, mark, end,
+				invert, antialias, winding, color, 0.5, method );
+			mark = end;
+		}
+		ASSERT(is_equal(single, bands));
+	}
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	// many marks are sorted in the ThreadPool
+	ThreadPool::subsys_init();
+
+	TEST_SUITE_BEGIN()
+		TEST_FUNCTION(test_sort_marks);
+		TEST_FUNCTION(test_render_bands);
+	TEST_SUITE_END()
+
+	ThreadPool::subsys_stop();
+	return tst_exit_status;
+}
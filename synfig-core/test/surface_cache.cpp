@@ -0,0 +1,149 @@
+/* === S Y N F I G ========================================================= */
+/*!\file surface_cache.cpp
+** \brief Test rendering::SurfaceCache class
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <synfig/rendering/surfacecache.h>
+#include <synfig/rendering/software/surfaceswcompact.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+
+// 16x16 pixels
+static const size_t surface_bytes = 16*16*sizeof(Color);
+
+/* === P R O C E D U R E S ================================================= */
+
+static SurfaceResource::Handle
+new_surface()
+{
+	SurfaceResource::Handle surface = new SurfaceResource();
+	surface->create(16, 16);
+	return surface;
+}
+
+void test_get_returns_stored_surface()
+{
+	SurfaceCache cache(10*surface_bytes);
+	SurfaceResource::Handle surface = new_surface();
+	cache.put("a", surface);
+	ASSERT(cache.get("a") == surface)
+	ASSERT_FALSE(cache.get("b"))
+}
+
+void test_counts_hits_and_misses()
+{
+	SurfaceCache cache(10*surface_bytes);
+	cache.put("a", new_surface());
+	cache.get("a");
+	cache.get("a");
+	cache.get("b");
+	SurfaceCache::Stats stats = cache.get_stats();
+	ASSERT_EQUAL(2, stats.hits)
+	ASSERT_EQUAL(1, stats.misses)
+	ASSERT_EQUAL(1u, stats.count)
+	ASSERT_EQUAL(surface_bytes, stats.bytes)
+}
+
+void test_drops_least_recently_used_surface()
+{
+	SurfaceCache cache(2*surface_bytes);
+	cache.put("a", new_surface());
+	cache.put("b", new_surface());
+	cache.get("a");
+	cache.put("c", new_surface());
+	ASSERT(cache.get("a"))
+	ASSERT_FALSE(cache.get("b"))
+	ASSERT(cache.get("c"))
+	ASSERT_EQUAL(1, cache.get_stats().evictions)
+}
+
+void test_replaces_surface_with_same_key()
+{
+	SurfaceCache cache(2*surface_bytes);
+	SurfaceResource::Handle surface = new_surface();
+	cache.put("a", new_surface());
+	cache.put("a", surface);
+	ASSERT(cache.get("a") == surface)
+	ASSERT_EQUAL(surface_bytes, cache.get_stats().bytes)
+}
+
+void test_shrinks_when_limit_decreased()
+{
+	SurfaceCache cache(2*surface_bytes);
+	cache.put("a", new_surface());
+	cache.put("b", new_surface());
+	cache.set_max_bytes(surface_bytes);
+	ASSERT_EQUAL(1u, cache.get_stats().count)
+	ASSERT(cache.get("b"))
+}
+
+void test_disabled_cache_stores_nothing()
+{
+	SurfaceCache cache;
+	ASSERT_FALSE(cache.is_enabled())
+	cache.put("a", new_surface());
+	ASSERT_FALSE(cache.get("a"))
+	ASSERT_EQUAL(0u, cache.get_stats().count)
+}
+
+void test_counts_memory_of_compact_surface()
+{
+	SurfaceCache cache(10*surface_bytes);
+	SurfaceSWCompact::Handle compact = new SurfaceSWCompact();
+	compact->create(16, 16);
+	cache.put("a", new SurfaceResource(compact));
+	ASSERT_EQUAL(surface_bytes/2, cache.get_stats().bytes)
+}
+
+/* === M E T H O D S ======================================================= */
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	TEST_SUITE_BEGIN();
+
+		TEST_FUNCTION(test_get_returns_stored_surface);
+		TEST_FUNCTION(test_counts_hits_and_misses);
+		TEST_FUNCTION(test_drops_least_recently_used_surface);
+		TEST_FUNCTION(test_replaces_surface_with_same_key);
+		TEST_FUNCTION(test_shrinks_when_limit_decreased);
+		TEST_FUNCTION(test_disabled_cache_stores_nothing);
+		TEST_FUNCTION(test_counts_memory_of_compact_surface);
+
+	TEST_SUITE_END();
+
+	return tst_exit_status;
+}
@@ -0,0 +1,122 @@
+/* === S Y N F I G ========================================================= */
+/*!\file surface_compact.cpp
+** \brief Test rendering::SurfaceSWCompact class
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <cmath>
+#include <vector>
+
+#include <synfig/rendering/software/surfaceswcompact.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+
+static const int width = 13;
+static const int height = 7;
+
+/* === P R O C E D U R E S ================================================= */
+
+static std::vector<Color>
+get_test_pixels()
+{
+	std::vector<Color> pixels(width*height);
+	for(int i = 0; i < (int)pixels.size(); ++i)
+		pixels[i] = Color(0.013f*i - 0.3f, 1.f/(i + 1), 10.f - 0.2f*i, 0.011f*i);
+	return pixels;
+}
+
+void test_half_conversion_keeps_exact_values()
+{
+	const float values[] = { 0.f, -0.f, 1.f, -1.f, 0.5f, 0.25f, 2048.f, 65504.f, -65504.f, 1.f/16384.f, 1.f/16777216.f };
+	for(float x : values)
+		ASSERT_EQUAL(x, SurfaceSWCompact::half_to_float(SurfaceSWCompact::float_to_half(x)))
+	ASSERT(std::isinf(SurfaceSWCompact::half_to_float(SurfaceSWCompact::float_to_half(1e6f))))
+	ASSERT(std::isnan(SurfaceSWCompact::half_to_float(SurfaceSWCompact::float_to_half(NAN))))
+}
+
+void test_half_conversion_rounds_to_nearest()
+{
+	for(int i = -20000; i <= 20000; ++i) {
+		float x = 0.000731f*i;
+		float y = SurfaceSWCompact::half_to_float(SurfaceSWCompact::float_to_half(x));
+		// half has 11 significant bits
+		ASSERT(std::fabs(x - y) <= std::fabs(x)/2048.f + 1e-7f)
+	}
+}
+
+void test_assign_and_get_pixels()
+{
+	std::vector<Color> pixels = get_test_pixels();
+	SurfaceSWCompact surface;
+	ASSERT(surface.assign(&pixels.front(), width, height))
+	ASSERT_EQUAL(width, surface.get_width())
+	ASSERT_EQUAL(height, surface.get_height())
+	ASSERT_EQUAL(surface.get_buffer_size()/2, surface.get_memory_size())
+
+	std::vector<Color> result(pixels.size());
+	ASSERT(surface.get_pixels(&result.front()))
+	for(int i = 0; i < (int)pixels.size(); ++i) {
+		ASSERT_APPROX_EQUAL_MICRO(SurfaceSWCompact::half_to_float(SurfaceSWCompact::float_to_half(pixels[i].get_r())), result[i].get_r())
+		ASSERT(std::fabs(pixels[i].get_b() - result[i].get_b()) <= 0.01f)
+		ASSERT_EQUAL(SurfaceSWCompact::float_to_half(pixels[i].get_a()), surface.get_plane(3)[i])
+	}
+}
+
+void test_create_gives_transparent_pixels()
+{
+	SurfaceSWCompact surface;
+	ASSERT(surface.create(width, height))
+	std::vector<Color> result(width*height, Color::white());
+	ASSERT(surface.get_pixels(&result.front()))
+	for(const Color &c : result)
+		ASSERT(c == Color(0, 0, 0, 0))
+}
+
+/* === M E T H O D S ======================================================= */
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	TEST_SUITE_BEGIN();
+
+		TEST_FUNCTION(test_half_conversion_keeps_exact_values);
+		TEST_FUNCTION(test_half_conversion_rounds_to_nearest);
+		TEST_FUNCTION(test_assign_and_get_pixels);
+		TEST_FUNCTION(test_create_gives_transparent_pixels);
+
+	TEST_SUITE_END();
+
+	return tst_exit_status;
+}
@@ -0,0 +1,132 @@
+/* === S Y N F I G ========================================================= */
+/*!\file surface_pool.cpp
+** \brief Test rendering::SurfacePool class
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <synfig/rendering/surfacepool.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+using namespace rendering;
+
+/* === M A C R O S ========================================================= */
+/* === T Y P E D E F S ===================================================== */
+/* === C L A S S E S & S T R U C T S ======================================= */
+/* === G L O B A L S ======================================================= */
+
+static const size_t buffer_bytes = 1024*1024;
+
+/* === P R O C E D U R E S ================================================= */
+
+void test_class_size_covers_request()
+{
+	ASSERT_EQUAL(size_t(100), SurfacePool::get_class_size(100))
+	for(size_t bytes = SurfacePool::get_min_bytes(); bytes < 64*buffer_bytes; bytes = bytes*5/4 + 1) {
+		size_t size = SurfacePool::get_class_size(bytes);
+		ASSERT(size >= bytes)
+		ASSERT(size - bytes <= bytes/8)
+		ASSERT_EQUAL(size, SurfacePool::get_class_size(size))
+	}
+}
+
+void test_reuses_freed_buffer()
+{
+	SurfacePool pool(10*buffer_bytes);
+	void *a = pool.alloc(buffer_bytes);
+	pool.free(a, buffer_bytes);
+	ASSERT_EQUAL(buffer_bytes, pool.get_stats().free_bytes)
+
+	// any request of the same size class takes the same buffer
+	void *b = pool.alloc(buffer_bytes - 100);
+	ASSERT(a == b)
+	pool.free(b, buffer_bytes - 100);
+
+	SurfacePool::Stats stats = pool.get_stats();
+	ASSERT_EQUAL(2, stats.requests)
+	ASSERT_EQUAL(1, stats.reuses)
+	ASSERT_EQUAL(buffer_bytes, stats.peak_bytes)
+	ASSERT_EQUAL(0u, stats.used_bytes)
+}
+
+void test_counts_peak_bytes()
+{
+	SurfacePool pool(10*buffer_bytes);
+	void *a = pool.alloc(buffer_bytes);
+	void *b = pool.alloc(buffer_bytes);
+	ASSERT_EQUAL(2*buffer_bytes, pool.get_stats().used_bytes)
+	pool.free(a, buffer_bytes);
+	pool.free(b, buffer_bytes);
+	ASSERT_EQUAL(2*buffer_bytes, pool.get_stats().peak_bytes)
+	ASSERT_EQUAL(0u, pool.get_stats().used_bytes)
+}
+
+void test_keeps_free_buffers_within_limit()
+{
+	SurfacePool pool(2*buffer_bytes);
+	void *a = pool.alloc(buffer_bytes);
+	void *b = pool.alloc(buffer_bytes);
+	void *c = pool.alloc(2*buffer_bytes);
+	pool.free(a, buffer_bytes);
+	pool.free(b, buffer_bytes);
+	ASSERT_EQUAL(2*buffer_bytes, pool.get_stats().free_bytes)
+	// older buffers of other sizes are released to fit the new one
+	pool.free(c, 2*buffer_bytes);
+	ASSERT_EQUAL(2*buffer_bytes, pool.get_stats().free_bytes)
+	ASSERT(pool.alloc(2*buffer_bytes) == c)
+	pool.free(c, 2*buffer_bytes);
+
+	pool.set_max_bytes(0);
+	ASSERT_EQUAL(0u, pool.get_stats().free_bytes)
+}
+
+void test_disabled_pool_keeps_nothing()
+{
+	SurfacePool pool;
+	pool.free(pool.alloc(buffer_bytes), buffer_bytes);
+	ASSERT_EQUAL(0u, pool.get_stats().free_bytes)
+	ASSERT_EQUAL(0, pool.get_stats().reuses)
+}
+
+/* === M E T H O D S ======================================================= */
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+
+	TEST_SUITE_BEGIN();
+
+		TEST_FUNCTION(test_class_size_covers_request);
+		TEST_FUNCTION(test_reuses_freed_buffer);
+		TEST_FUNCTION(test_counts_peak_bytes);
+		TEST_FUNCTION(test_keeps_free_buffers_within_limit);
+		TEST_FUNCTION(test_disabled_pool_keeps_nothing);
+
+	TEST_SUITE_END();
+
+	return tst_exit_status;
+}
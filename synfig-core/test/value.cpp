@@ -0,0 +1,167 @@
+/* === S Y N F I G ========================================================= */
+/*!\file value.cpp
+** \brief Test ValueBase class
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <synfig/color.h>
+#include <synfig/value.h>
+#include <synfig/vector.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === M A C R O S ========================================================= */
+
+/* === G L O B A L S ======================================================= */
+
+static long allocations = 0;
+
+/* === P R O C E D U R E S ================================================= */
+
+// count heap allocations made by the tests
+void* operator new(std::size_t size)
+{
+	++allocations;
+	if (void *p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+	{ std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept
+	{ std::free(p); }
+
+void test_small_values_get_and_set()
+{
+	ValueBase real(Real(1.5));
+	ASSERT_EQUAL(Real(1.5), real.get(Real()))
+	real.set(Real(-2.0));
+	ASSERT_EQUAL(Real(-2.0), real.get(Real()))
+
+	ValueBase vector(Vector(1.0, 2.0));
+	ASSERT(vector.get(Vector()) == Vector(1.0, 2.0))
+
+	ValueBase color(Color(0.1f, 0.2f, 0.3f, 0.4f));
+	ASSERT(color.get(Color()) == Color(0.1f, 0.2f, 0.3f, 0.4f))
+
+	ValueBase flag(true);
+	ASSERT(flag.get(bool()))
+	ASSERT(flag.is_valid())
+
+	// change type of value
+	flag = Vector(3.0, 4.0);
+	ASSERT(flag.get_type() == type_vector)
+	ASSERT(flag.get(Vector()) == Vector(3.0, 4.0))
+}
+
+void test_small_values_copy_and_swap()
+{
+	ValueBase a(Vector(1.0, 2.0));
+	ValueBase b(a);
+	b.set(Vector(5.0, 6.0));
+	ASSERT(a.get(Vector()) == Vector(1.0, 2.0))
+	ASSERT(b.get(Vector()) == Vector(5.0, 6.0))
+
+	ValueBase c(Real(7.0));
+	swap(a, c);
+	ASSERT_EQUAL(Real(7.0), a.get(Real()))
+	ASSERT(c.get(Vector()) == Vector(1.0, 2.0))
+	// values must stay independent after swap
+	a.set(Real(8.0));
+	c.set(Vector(9.0, 10.0));
+	ASSERT_EQUAL(Real(8.0), a.get(Real()))
+	ASSERT(c.get(Vector()) == Vector(9.0, 10.0))
+
+	ValueBase d(std::move(c));
+	ASSERT(d.get(Vector()) == Vector(9.0, 10.0))
+	ASSERT(!c.is_valid())
+
+	std::vector<ValueBase> values;
+	for(int i = 0; i < 100; ++i)
+		values.push_back(Real(i));
+	for(int i = 0; i < 100; ++i)
+		ASSERT_EQUAL(Real(i), values[i].get(Real()))
+}
+
+void test_list_values_copy()
+{
+	std::vector<ValueBase> list;
+	list.push_back(Real(1.0));
+	list.push_back(Vector(2.0, 3.0));
+
+	ValueBase a(list);
+	ValueBase b(a);
+	ASSERT_EQUAL(2, (int)b.get_list().size())
+	ASSERT(b.get_list()[1].get(Vector()) == Vector(2.0, 3.0))
+
+	list.push_back(Real(4.0));
+	b = list;
+	ASSERT_EQUAL(2, (int)a.get_list().size())
+	ASSERT_EQUAL(3, (int)b.get_list().size())
+}
+
+void test_small_values_copy_without_allocation()
+{
+	ValueBase real(Real(1.0));
+	ValueBase vector(Vector(1.0, 2.0));
+	ValueBase color(Color(1.f, 0.5f, 0.25f, 1.f));
+
+	long before = allocations;
+	for(int i = 0; i < 100; ++i) {
+		ValueBase a(real);
+		ValueBase b(vector);
+		ValueBase c(color);
+		a.set(Real(i));
+		swap(b, c);
+	}
+	ASSERT_EQUAL(0L, allocations - before)
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+	Type::subsys_init();
+
+	TEST_SUITE_BEGIN()
+		TEST_FUNCTION(test_small_values_get_and_set)
+		TEST_FUNCTION(test_small_values_copy_and_swap)
+		TEST_FUNCTION(test_list_values_copy)
+		TEST_FUNCTION(test_small_values_copy_without_allocation)
+	TEST_SUITE_END()
+
+	Type::subsys_stop();
+
+	return tst_exit_status;
+}
@@ -0,0 +1,246 @@
+/* === S Y N F I G ========================================================= */
+/*!\file valuenode.cpp
+** \brief Test evaluation of ValueNode graphs
+**
+** \legal
+** Copyright (c) 2026 Synfig contributors
+**
+** This file is part of Synfig.
+**
+** Synfig is free software: you can redistribute it and/or modify
+** it under the terms of the GNU General Public License as published by
+** the Free Software Foundation, either version 2 of the License, or
+** (at your option) any later version.
+**
+** Synfig is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+** GNU General Public License for more details.
+**
+** You should have received a copy of the GNU General Public License
+** along with Synfig.  If not, see <https://www.gnu.org/licenses/>.
+** \endlegal
+*/
+/* ========================================================================= */
+
+/* === H E A D E R S ======================================================= */
+
+#include "test_base.h"
+
+#include <vector>
+
+#include <synfig/angle.h>
+#include <synfig/color.h>
+#include <synfig/type.h>
+#include <synfig/value.h>
+#include <synfig/valuenode_program.h>
+#include <synfig/vector.h>
+#include <synfig/valuenodes/valuenode_add.h>
+#include <synfig/valuenodes/valuenode_animated.h>
+#include <synfig/valuenodes/valuenode_composite.h>
+#include <synfig/valuenodes/valuenode_const.h>
+#include <synfig/valuenodes/valuenode_linear.h>
+#include <synfig/valuenodes/valuenode_range.h>
+#include <synfig/valuenodes/valuenode_scale.h>
+
+/* === U S I N G =========================================================== */
+
+using namespace synfig;
+
+/* === P R O C E D U R E S ================================================= */
+
+static ValueNode::Handle
+create_animated_real(Real scale)
+{
+	ValueNode_Animated::Handle animated = ValueNode_Animated::create(type_real);
+	animated->new_waypoint(Time(0.0), ValueBase(Real(0.0)));
+	animated->new_waypoint(Time(1.0), ValueBase(Real(scale)));
+	animated->new_waypoint(Time(2.0), ValueBase(Real(-scale)));
+	animated->new_waypoint(Time(4.0), ValueBase(Real(2.0*scale)));
+	return animated;
+}
+
+static std::vector<Time>
+get_test_times()
+{
+	std::vector<Time> times;
+	for(int i = -10; i <= 50; ++i)
+		times.push_back(Time(0.1*i));
+	// unordered samples must work too
+	times.push_back(Time(3.3));
+	times.push_back(Time(0.7));
+	return times;
+}
+
+static void
+check_evaluate_many(const ValueNode &node)
+{
+	std::vector<Time> times = get_test_times();
+	std::vector<ValueBase> values(times.size());
+	node.evaluate_many(times.data(), times.size(), values.data());
+	for(size_t i = 0; i < times.size(); ++i)
+		ASSERT(values[i] == node(times[i]))
+}
+
+void test_evaluate_many_const()
+{
+	ValueNode::Handle node = ValueNode_Const::create(Vector(1.0, 2.0));
+	check_evaluate_many(*node);
+}
+
+void test_evaluate_many_animated()
+{
+	check_evaluate_many(*create_animated_real(1.0));
+}
+
+void test_evaluate_many_linear()
+{
+	ValueNode_Linear::Handle linear = ValueNode_Linear::create(Real(0.0));
+	linear->set_link("slope", create_animated_real(2.0));
+	linear->set_link("offset", create_animated_real(3.0));
+	check_evaluate_many(*linear);
+}
+
+void test_evaluate_many_composite()
+{
+	ValueNode_Composite::Handle composite = ValueNode_Composite::create(Color());
+	composite->set_link(0, create_animated_real(0.5));
+	composite->set_link(2, create_animated_real(0.25));
+	check_evaluate_many(*composite);
+
+	ValueNode_Composite::Handle vector = ValueNode_Composite::create(Vector());
+	ValueNode_Linear::Handle linear = ValueNode_Linear::create(Real(0.0));
+	linear->set_link("slope", create_animated_real(2.0));
+	vector->set_link(0, linear);
+	vector->set_link(1, create_animated_real(4.0));
+	check_evaluate_many(*vector);
+}
+
+void test_evaluation_pass_reuses_shared_values()
+{
+	ValueNode_Composite::Handle shared = ValueNode_Composite::create(Vector());
+	shared->set_link(0, create_animated_real(1.0));
+	ValueNode_Linear::Handle a = ValueNode_Linear::create(Vector());
+	ValueNode_Linear::Handle b = ValueNode_Linear::create(Vector());
+	a->set_link("slope", shared);
+	b->set_link("slope", shared);
+
+	ValueNodeEvaluationPass::reset_counters();
+	{
+		ValueNodeEvaluationPass pass;
+		ValueBase value = (*a)(Time(1.5));
+		ASSERT(value == (*b)(Time(1.5)))
+		ASSERT_EQUAL(1LL, ValueNodeEvaluationPass::get_found_count())
+
+		// changed node must be calculated again
+		shared->set_link(1, ValueNode_Const::create(Real(5.0)));
+		ASSERT(value != (*a)(Time(1.5)))
+		ASSERT_EQUAL(1LL, ValueNodeEvaluationPass::get_found_count())
+	}
+
+	// nothing is remembered outside of the pass
+	(*a)(Time(1.5));
+	(*b)(Time(1.5));
+	ASSERT_EQUAL(1LL, ValueNodeEvaluationPass::get_found_count())
+}
+
+static ValueNode::Handle
+create_program_test_graph(ValueNode_Const::Handle &constant)
+{
+	// x = (a + b*0.5)*2
+	ValueNode_Scale::Handle half = ValueNode_Scale::create(Real(0.0));
+	half->set_link("link", create_animated_real(2.0));
+	half->set_link("scalar", ValueNode_Const::create(Real(0.5)));
+	ValueNode_Add::Handle x = ValueNode_Add::create(Real(0.0));
+	x->set_link("lhs", create_animated_real(1.0));
+	x->set_link("rhs", half);
+	x->set_link("scalar", ValueNode_Const::create(Real(2.0)));
+
+	// y = clamp(c*t + constant, -1, 1)
+	constant = ValueNode_Const::Handle::cast_dynamic(ValueNode_Const::create(Real(0.25)));
+	ValueNode_Linear::Handle linear = ValueNode_Linear::create(Real(0.0));
+	linear->set_link("slope", create_animated_real(0.5));
+	linear->set_link("offset", constant);
+	ValueNode_Range::Handle y = ValueNode_Range::create(Real(0.0));
+	y->set_link("min", ValueNode_Const::create(Real(-1.0)));
+	y->set_link("max", ValueNode_Const::create(Real(1.0)));
+	y->set_link("link", linear);
+
+	// root = (x, y) + (x, y)*d
+	ValueNode_Composite::Handle vector = ValueNode_Composite::create(Vector());
+	vector->set_link(0, x);
+	vector->set_link(1, y);
+	ValueNode_Scale::Handle scaled = ValueNode_Scale::create(Vector());
+	scaled->set_link("link", vector);
+	scaled->set_link("scalar", create_animated_real(3.0));
+	ValueNode_Add::Handle root = ValueNode_Add::create(Vector());
+	root->set_link("lhs", vector);
+	root->set_link("rhs", scaled);
+	return root;
+}
+
+void test_program_matches_value_node()
+{
+	ValueNode_Const::Handle constant;
+	ValueNode::Handle root = create_program_test_graph(constant);
+	ValueNodeProgram program(root);
+
+	std::vector<Time> times = get_test_times();
+	for(size_t i = 0; i < times.size(); ++i)
+		ASSERT(program(times[i]) == (*root)(times[i]))
+	// only animated nodes are evaluated by their operator()
+	ASSERT_EQUAL(4, program.get_load_count())
+
+	// program is rebuilt after change
+	constant->set_value(Real(-3.0));
+	for(size_t i = 0; i < times.size(); ++i)
+		ASSERT(program(times[i]) == (*root)(times[i]))
+}
+
+void test_program_angle()
+{
+	ValueNode_Add::Handle root = ValueNode_Add::create(Angle::deg(30.0));
+	root->set_link("rhs", ValueNode_Const::create(Angle::deg(-71.0)));
+	root->set_link("scalar", create_animated_real(1.7));
+	ValueNodeProgram program(root);
+
+	std::vector<Time> times = get_test_times();
+	for(size_t i = 0; i < times.size(); ++i)
+		ASSERT(program(times[i]).get(Angle()) == (*root)(times[i]).get(Angle()))
+}
+
+void test_program_sum_matches_value_node()
+{
+	ValueNode_Const::Handle constant;
+	ValueNode::Handle root = create_program_test_graph(constant);
+	ValueNodeProgram program(root);
+
+	// the sums are equal only if every evaluation is bit-identical
+	Real sum_node = 0.0, sum_program = 0.0;
+	for(int i = 0; i < 1000; ++i) {
+		sum_node += (*root)(Time(i*0.01)).get(Vector())[0];
+		sum_program += program(Time(i*0.01)).get(Vector())[0];
+	}
+	ASSERT_EQUAL(sum_node, sum_program)
+}
+
+/* === E N T R Y P O I N T ================================================= */
+
+int main() {
+	Type::subsys_init();
+
+	TEST_SUITE_BEGIN()
+		TEST_FUNCTION(test_evaluate_many_const)
+		TEST_FUNCTION(test_evaluate_many_animated)
+		TEST_FUNCTION(test_evaluate_many_linear)
+		TEST_FUNCTION(test_evaluate_many_composite)
+		TEST_FUNCTION(test_evaluation_pass_reuses_shared_values)
+		TEST_FUNCTION(test_program_matches_value_node)
+		TEST_FUNCTION(test_program_angle)
+		TEST_FUNCTION(test_program_sum_matches_value_node)
+	TEST_SUITE_END()
+
+	Type::subsys_stop();
+
+	return tst_exit_status;
+}
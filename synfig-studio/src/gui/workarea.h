@@ -451,6 +451,10 @@ public:
 	//! initiate background rendering of canvas
 	void queue_render(bool refresh = true);
 
+	//! initiate background rendering of canvas after its changes,
+	//! keeps already rendered tiles which are not affected by them
+	void queue_render_changes();
+
 	void zoom_in();
 	void zoom_out();
 	void zoom_fit();
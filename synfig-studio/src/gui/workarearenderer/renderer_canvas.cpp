@@ -41,6 +41,7 @@
 #include <synfig/general.h>
 #include <synfig/context.h>
 #include <synfig/threadpool.h>
+#include <synfig/layers/layer_filtergroup.h>
 #include <synfig/rendering/renderer.h>
 #include <synfig/rendering/common/task/tasktransformation.h>
 
@@ -80,6 +81,95 @@ static long long
 image_rect_size(const RectInt &rect)
 	{ return 4ll*rect.get_width()*rect.get_height(); }
 
+//! canvas time must be set before call
+static void
+fetch_layer_states(const Canvas &canvas, Renderer_Canvas::LayerStateList &out_states)
+{
+	ContextParams context_params(true);
+	CanvasBase queue;
+	canvas.get_context_sorted(context_params, queue);
+
+	out_states.clear();
+	for(CanvasBase::const_iterator i = queue.begin(); i != queue.end() && *i; ++i) {
+		Renderer_Canvas::LayerState state;
+		state.layer = i->get();
+		state.local = true; // disabled layer changes nothing
+		if (Context::active(context_params, **i)) {
+			// layers which read or filter their context may change any pixel
+			const Layer_Composite *composite = dynamic_cast<const Layer_Composite*>(i->get());
+			state.local = composite
+			           && !composite->reads_context()
+			           && !dynamic_cast<const Layer_FilterGroup*>(composite)
+			           && !Color::is_straight(composite->get_blend_method());
+			if (state.local) {
+				state.bounds = composite->get_bounding_rect();
+				state.local = !state.bounds.is_nan_or_inf();
+			}
+		}
+		out_states.push_back(state);
+	}
+}
+
+//! collects areas changed between the states of the layers,
+//! returns false if the whole frame is changed
+static bool
+get_changed_rects(
+	const Renderer_Canvas::LayerStateList &prev,
+	const Renderer_Canvas::LayerStateList &next,
+	const Renderer_Canvas::LayerChangeList &changes,
+	const Time &time,
+	std::vector<Rect> &out_rects )
+{
+	if (prev.size() != next.size())
+		return false;
+	for(size_t i = 0; i < prev.size(); ++i)
+		if (prev[i].layer != next[i].layer)
+			return false;
+
+	for(Renderer_Canvas::LayerChangeList::const_iterator c = changes.begin(); c != changes.end(); ++c) {
+		if (time < c->begin || c->end < time)
+			continue;
+		size_t index = 0;
+		while(index < next.size() && next[index].layer != c->layer)
+			++index;
+		if (index == next.size())
+			return false;
+		// the changed pixels must not be spread by the layers above
+		for(size_t i = 0; i <= index; ++i)
+			if (!prev[i].local || !next[i].local)
+				return false;
+		if (prev[index].bounds.is_valid())
+			out_rects.push_back(prev[index].bounds);
+		if (next[index].bounds.is_valid())
+			out_rects.push_back(next[index].bounds);
+	}
+	return true;
+}
+
+static RectInt
+to_frame_rect(const Rect &rect, const RendDesc &rend_desc, int width, int height)
+{
+	const int margin = 2; // for antialiasing
+	Vector tl = rend_desc.get_tl();
+	Vector br = rend_desc.get_br();
+	if (approximate_equal(tl[0], br[0]) || approximate_equal(tl[1], br[1]))
+		return RectInt(0, 0, width, height);
+
+	Real kx = width/(br[0] - tl[0]);
+	Real ky = height/(br[1] - tl[1]);
+	Real x0 = (rect.minx - tl[0])*kx, x1 = (rect.maxx - tl[0])*kx;
+	Real y0 = (rect.miny - tl[1])*ky, y1 = (rect.maxy - tl[1])*ky;
+	if (x1 < x0) std::swap(x0, x1);
+	if (y1 < y0) std::swap(y0, y1);
+
+	RectInt r(
+		(int)floor(std::max(x0, Real(-margin))) - margin,
+		(int)floor(std::max(y0, Real(-margin))) - margin,
+		(int)ceil (std::min(x1, Real(width + margin))) + margin,
+		(int)ceil (std::min(y1, Real(height + margin))) + margin );
+	return r & RectInt(0, 0, width, height);
+}
+
 /* === M E T H O D S ======================================================= */
 
 Renderer_Canvas::Renderer_Canvas():
@@ -94,6 +184,7 @@ Renderer_Canvas::Renderer_Canvas():
 	max_enqueued_tasks (6),
 	enqueued_tasks(),
 	tiles_size(),
+	layer_changes_unknown(),
 	pixel_format()
 {
 	// check endianness
@@ -338,6 +429,20 @@ Renderer_Canvas::remove_extra_tiles(rendering::Task::List &events)
 	// remove empty entries from tiles map
 	for(TileMap::iterator i = tiles.begin(); i != tiles.end(); )
 		if (i->second.empty()) tiles.erase(i++); else ++i;
+
+	remove_unused_layer_states();
+}
+
+void
+Renderer_Canvas::remove_unused_layer_states()
+{
+	// mutex must be already locked
+	std::set<Time> times;
+	for(TileMap::const_iterator i = tiles.begin(); i != tiles.end(); ++i)
+		if (!i->second.empty())
+			times.insert(i->first.time);
+	for(LayerStateMap::iterator i = layer_states.begin(); i != layer_states.end(); )
+		if (times.count(i->first)) ++i; else layer_states.erase(i++);
 }
 
 void
@@ -501,6 +606,8 @@ Renderer_Canvas::enqueue_render_frame(
 
 	// build rendering task
 	canvas->set_time(id.time);
+	if (!layer_states.count(id.time))
+		fetch_layer_states(*canvas, layer_states[id.time]);
 
 	std::string loading_error_msg;
 	try {
@@ -730,6 +837,7 @@ Renderer_Canvas::clear_render()
 				erase_tile(i->second, j, events);
 			}
 		tiles.clear();
+		layer_states.clear();
 		rendering_error_msg_map.clear();
 	}
 	rendering::Renderer::cancel(events);
@@ -737,6 +845,124 @@ Renderer_Canvas::clear_render()
 		get_work_area()->signal_rendering()();
 }
 
+void
+Renderer_Canvas::clear_changed_render()
+{
+	// this method may be called from the main thread only
+	LayerChangeList changes;
+	changes.swap(layer_changes);
+	bool unknown = layer_changes_unknown;
+	layer_changes_unknown = false;
+
+	Canvas::Handle canvas = get_work_area() ? get_work_area()->get_canvas() : Canvas::Handle();
+	if (unknown || !canvas)
+		{ clear_render(); return; }
+
+	// layers which show their context at the other times
+	// make the changes under them visible at any time
+	for(LayerChangeList::iterator c = changes.begin(); c != changes.end(); ++c)
+		for(Canvas::const_iterator i = canvas->begin(); i != canvas->end() && i->get() != c->layer; ++i)
+			if (*i && (*i)->active() && (*i)->changes_context_time())
+				{ c->begin = Time::begin(); c->end = Time::end(); break; }
+
+	// Only the frames at the current time of the canvas are localized.
+	// New bounds of the changed layers are known only after evaluation of the document,
+	// the current time is evaluated anyway to render it again, but evaluation
+	// of the each cached time would block the main thread for too long.
+	// So the other affected frames are dropped entirely.
+	Time current_time = canvas->get_time();
+	canvas->set_time(current_time);
+	LayerStateList current_states;
+	fetch_layer_states(*canvas, current_states);
+
+	rendering::Task::List events;
+	bool cleared = false;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		RendDesc rend_desc = canvas->rend_desc();
+
+		std::map<Time, std::vector<TileMap::iterator> > frames;
+		for(TileMap::iterator i = tiles.begin(); i != tiles.end(); ++i)
+			frames[i->first.time].push_back(i);
+
+		for(std::map<Time, std::vector<TileMap::iterator> >::const_iterator f = frames.begin(); f != frames.end(); ++f) {
+			const Time &time = f->first;
+			LayerStateMap::iterator prev = layer_states.find(time);
+
+			// layers inserted, removed or moved
+			bool whole = prev == layer_states.end() || prev->second.size() != current_states.size();
+			for(size_t i = 0; !whole && i < current_states.size(); ++i)
+				if (prev->second[i].layer != current_states[i].layer)
+					whole = true;
+
+			std::vector<Rect> rects;
+			if (!whole) {
+				bool affected = false;
+				for(LayerChangeList::const_iterator c = changes.begin(); !affected && c != changes.end(); ++c)
+					if (!(time < c->begin) && !(c->end < time))
+						affected = true;
+				if (!affected)
+					continue;
+
+				if (time.is_equal(current_time)) {
+					whole = !get_changed_rects(prev->second, current_states, changes, time, rects);
+					prev->second = current_states;
+				} else {
+					whole = true;
+				}
+			}
+
+			for(std::vector<TileMap::iterator>::const_iterator i = f->second.begin(); i != f->second.end(); ++i) {
+				const FrameId &id = (*i)->first;
+				std::vector<RectInt> frame_rects;
+				for(std::vector<Rect>::const_iterator r = rects.begin(); r != rects.end(); ++r)
+					frame_rects.push_back(to_frame_rect(*r, rend_desc, id.width, id.height));
+
+				TileList &list = (*i)->second;
+				for(TileList::iterator j = list.begin(); j != list.end(); ) {
+					bool erase = whole;
+					for(std::vector<RectInt>::const_iterator r = frame_rects.begin(); !erase && r != frame_rects.end(); ++r)
+						if (*j && ((*j)->rect && *r))
+							erase = true;
+					if (erase)
+						{ j = erase_tile(list, j, events); cleared = true; }
+					else
+						++j;
+				}
+			}
+		}
+
+		for(TileMap::iterator i = tiles.begin(); i != tiles.end(); )
+			if (i->second.empty()) tiles.erase(i++); else ++i;
+		remove_unused_layer_states();
+	}
+	rendering::Renderer::cancel(events);
+	if (cleared && get_work_area())
+		get_work_area()->signal_rendering()();
+}
+
+void
+Renderer_Canvas::on_canvas_child_changed(const Node *node)
+{
+	// the list is limited to avoid the growth while the changes are not applied (e.g. while playing)
+	const size_t max_changes = 1024;
+
+	const Layer *layer = dynamic_cast<const Layer*>(node);
+	if (!layer || layer_changes.size() >= max_changes) {
+		layer_changes.clear();
+		layer_changes_unknown = true;
+	}
+	if (layer_changes_unknown)
+		return;
+
+	LayerChange change;
+	change.layer = layer;
+	change.begin = node->get_changed_time_begin();
+	change.end = node->get_changed_time_end();
+	layer_changes.push_back(change);
+}
+
 Renderer_Canvas::FrameStatus
 Renderer_Canvas::merge_status(FrameStatus a, FrameStatus b) {
 	static const FrameStatus map[FS_Count][FS_Count] = {
@@ -135,6 +135,31 @@ public:
 	typedef std::vector<Tile::Handle> TileList;
 	typedef std::map<FrameId, TileList> TileMap;
 
+	//! state of the layer of the canvas at the moment of rendering of the tiles
+	class LayerState {
+	public:
+		const synfig::Layer *layer;
+		//! layer changes only pixels inside its bounds
+		bool local;
+		synfig::Rect bounds;
+
+		LayerState(): layer(), local() { }
+	};
+
+	//! change of the layer of the canvas, which is not applied to the tiles yet
+	class LayerChange {
+	public:
+		const synfig::Layer *layer;
+		synfig::Time begin;
+		synfig::Time end;
+
+		LayerChange(): layer() { }
+	};
+
+	typedef std::vector<LayerState> LayerStateList; //!< layers in order of rendering, from the top
+	typedef std::map<synfig::Time, LayerStateList> LayerStateMap;
+	typedef std::vector<LayerChange> LayerChangeList;
+
 private:
 	// cache options
 	const long long max_tiles_size_soft; //!< threshold for creation of new tiles
@@ -165,6 +190,13 @@ private:
 	//! increment of this field makes all tiles outdated
 	long long tiles_size;
 
+	//! states of the layers for the each time of stored tiles
+	LayerStateMap layer_states;
+
+	//! changes collected by on_canvas_child_changed(), may be accessed from the main thread only
+	LayerChangeList layer_changes;
+	bool layer_changes_unknown;
+
 	synfig::PixelFormat pixel_format;
 
 	//! uses to normalize alpha value after blending of onion surfaces
@@ -201,6 +233,9 @@ private:
 	//! mutex must be locked before call
 	void remove_extra_tiles(synfig::rendering::Task::List &events);
 
+	//! mutex must be locked before call
+	void remove_unused_layer_states();
+
 	//! mutex must be locked before call
 	void build_onion_frames();
 
@@ -227,6 +262,13 @@ public:
 	void enqueue_render();
 	void wait_render();
 	void clear_render();
+	//! removes only the tiles affected by the changes of the layers since the previous call,
+	//! or all tiles when the changes cannot be localized,
+	//! evaluates the canvas at its current time only, other affected frames are removed entirely
+	void clear_changed_render();
+
+	//! collects the changed layers, should be connected to signal_child_changed() of the canvas
+	void on_canvas_child_changed(const synfig::Node *node);
 
 	void get_render_status(StatusMap &out_map);
 